@@ -1,7 +1,9 @@
 'use strict';
 if (process.argv[2] === 'child') {
   const len = +process.argv[3];
-  const msg = `"${'.'.repeat(len)}"`;
+  const msg = process.argv[4] === 'buffer' ?
+    Buffer.alloc(len, '.') :
+    `"${'.'.repeat(len)}"`;
   while (true) {
     process.send(msg);
   }
@@ -9,6 +11,8 @@ if (process.argv[2] === 'child') {
   const common = require('../common.js');
   const bench = common.createBenchmark(main, {
     len: [64, 256, 1024, 4096, 32768],
+    payload: ['string', 'buffer'],
+    serialization: ['json', 'advanced'],
     dur: [5]
   });
   const spawn = require('child_process').spawn;
@@ -18,13 +22,16 @@ if (process.argv[2] === 'child') {
     const dur = +conf.dur;
     const len = +conf.len;
 
-    const options = { 'stdio': ['ignore', 'ignore', 'ignore', 'ipc'] };
+    const options = {
+      'stdio': ['ignore', 'ignore', 'ignore', 'ipc'],
+      'serialization': conf.serialization
+    };
     const child = spawn(process.argv[0],
-      [process.argv[1], 'child', len], options);
+      [process.argv[1], 'child', len, conf.payload], options);
 
     var bytes = 0;
     child.on('message', function(msg) {
-      bytes += msg.length;
+      bytes += len;
     });
 
     setTimeout(function() {
@@ -1,13 +1,23 @@
 'use strict';
 var common = require('../common.js');
 var bench = common.createBenchmark(main, {
-  thousands: [1]
+  thousands: [1],
+  heap: [0, 2048]
 });
 
 var spawn = require('child_process').spawn;
+var ballast = [];
+
 function main(conf) {
   var len = +conf.thousands * 1000;
 
+  // Megabytes of touched memory to keep around while spawning. The cost of
+  // fork() grows with the size of the parent's address space, so this shows
+  // the difference between the fork() and the posix_spawn() paths.
+  var chunk = 64 * 1024 * 1024;
+  for (var size = +conf.heap * 1024 * 1024; size > 0; size -= chunk)
+    ballast.push(Buffer.alloc(Math.min(size, chunk), 1));
+
   bench.start();
   go(len, len);
 }
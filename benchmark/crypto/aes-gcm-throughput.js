@@ -5,7 +5,8 @@ var keylen = {'aes-128-gcm': 16, 'aes-192-gcm': 24, 'aes-256-gcm': 32};
 var bench = common.createBenchmark(main, {
   n: [500],
   cipher: ['aes-128-gcm', 'aes-192-gcm', 'aes-256-gcm'],
-  len: [1024, 4 * 1024, 16 * 1024, 64 * 1024, 256 * 1024, 1024 * 1024]
+  len: [1024, 4 * 1024, 16 * 1024, 64 * 1024, 256 * 1024, 1024 * 1024],
+  api: ['update', 'updateInto']
 });
 
 function main(conf) {
@@ -13,8 +14,9 @@ function main(conf) {
   var key = crypto.randomBytes(keylen[conf.cipher]);
   var iv = crypto.randomBytes(12);
   var associate_data = Buffer.alloc(16, 'z');
+  var fn = conf.api === 'updateInto' ? AEAD_Bench_Into : AEAD_Bench;
   bench.start();
-  AEAD_Bench(conf.cipher, message, associate_data, key, iv, conf.n, conf.len);
+  fn(conf.cipher, message, associate_data, key, iv, conf.n, conf.len);
 }
 
 function AEAD_Bench(cipher, message, associate_data, key, iv, n, len) {
@@ -37,3 +39,27 @@ function AEAD_Bench(cipher, message, associate_data, key, iv, n, len) {
 
   bench.end(mbits);
 }
+
+// Same as above but with a fixed set of buffers: encrypts into one and
+// decrypts that in place.
+function AEAD_Bench_Into(cipher, message, associate_data, key, iv, n, len) {
+  var written = n * len;
+  var bits = written * 8;
+  var mbits = bits / (1024 * 1024);
+  var enc = Buffer.allocUnsafe(len);
+
+  for (var i = 0; i < n; i++) {
+    var alice = crypto.createCipheriv(cipher, key, iv);
+    alice.setAAD(associate_data);
+    var size = alice.updateInto(message, enc);
+    size += alice.final(enc, size);
+    var tag = alice.getAuthTag();
+    var bob = crypto.createDecipheriv(cipher, key, iv);
+    bob.setAuthTag(tag);
+    bob.setAAD(associate_data);
+    bob.updateInto(enc, enc);
+    bob.final(enc, size);
+  }
+
+  bench.end(mbits);
+}
@@ -0,0 +1,61 @@
+// Digests of many small messages: one Hash object per message, and one
+// crypto.hashMany() call for all of them, synchronously and on the
+// threadpool, either from an array or from one buffer with offsets.
+'use strict';
+const common = require('../common.js');
+const crypto = require('crypto');
+
+const bench = common.createBenchmark(main, {
+  api: ['createHash', 'hashMany', 'hashMany-async'],
+  input: ['array', 'offsets'],
+  algo: ['sha256'],
+  len: [16, 256],
+  count: [1e4],
+  n: [50]
+});
+
+function main(conf) {
+  const api = conf.api;
+  const algo = conf.algo;
+  const len = +conf.len;
+  const count = +conf.count;
+  const n = +conf.n;
+
+  const messages = [];
+  const offsets = new Uint32Array(count + 1);
+  for (var i = 0; i < count; i++) {
+    messages.push(crypto.randomBytes(len));
+    offsets[i + 1] = offsets[i] + len;
+  }
+  const packed = Buffer.concat(messages);
+  const args = conf.input === 'array' ? [messages] : [packed, offsets];
+
+  if (api === 'hashMany-async') {
+    var done = 0;
+    const next = (err) => {
+      if (err)
+        throw err;
+      if (++done === n)
+        return bench.end(n * count);
+      crypto.hashMany.apply(crypto, [algo].concat(args, next));
+    };
+    bench.start();
+    crypto.hashMany.apply(crypto, [algo].concat(args, next));
+    return;
+  }
+
+  bench.start();
+  if (api === 'hashMany') {
+    for (i = 0; i < n; i++)
+      crypto.hashMany.apply(crypto, [algo].concat(args));
+  } else {
+    for (i = 0; i < n; i++) {
+      for (var j = 0; j < count; j++) {
+        const message = conf.input === 'array' ?
+            messages[j] : packed.slice(offsets[j], offsets[j + 1]);
+        crypto.createHash(algo).update(message).digest();
+      }
+    }
+  }
+  bench.end(n * count);
+}
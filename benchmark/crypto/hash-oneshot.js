@@ -0,0 +1,55 @@
+// Digests of whole messages: through a Hash object, through the synchronous
+// crypto.hash() and on the threadpool through the asynchronous one.
+'use strict';
+const common = require('../common.js');
+const crypto = require('crypto');
+
+const bench = common.createBenchmark(main, {
+  api: ['createHash', 'hash', 'hash-async'],
+  algo: ['sha256', 'md5'],
+  len: [64, 1024, 1024 * 1024],
+  n: [1e4]
+});
+
+function main(conf) {
+  const api = conf.api;
+  const algo = conf.algo;
+  const len = +conf.len;
+  // Keep the amount of data roughly constant across lengths.
+  const n = Math.max(Math.round(+conf.n * 1024 / Math.max(len, 1024)), 100);
+  const message = Buffer.alloc(len, 'b');
+  var i;
+
+  if (api === 'hash-async') {
+    // Keep as many digests in flight as the threadpool has threads.
+    const concurrency = Math.min(+process.env.UV_THREADPOOL_SIZE || 4, n);
+    var started = 0;
+    var done = 0;
+    const next = (err) => {
+      if (err)
+        throw err;
+      if (++done === n)
+        return bench.end(n);
+      if (started < n) {
+        started++;
+        crypto.hash(algo, message, next);
+      }
+    };
+    bench.start();
+    for (i = 0; i < concurrency; i++) {
+      started++;
+      crypto.hash(algo, message, next);
+    }
+    return;
+  }
+
+  bench.start();
+  if (api === 'hash') {
+    for (i = 0; i < n; i++)
+      crypto.hash(algo, message);
+  } else {
+    for (i = 0; i < n; i++)
+      crypto.createHash(algo).update(message).digest();
+  }
+  bench.end(n);
+}
@@ -0,0 +1,42 @@
+// Digests of messages that share a long prefix, as in signature base strings:
+// hashing the prefix again for every message, continuing from a copy of a
+// Hash that has seen the prefix, and for HMACs with the same key, creating
+// an Hmac per message or resetting one Hmac after each digest.
+'use strict';
+const common = require('../common.js');
+const crypto = require('crypto');
+
+const bench = common.createBenchmark(main, {
+  api: ['rehash', 'copy', 'createHmac', 'hmacReset'],
+  algo: ['sha256'],
+  prefix: [64, 4096],
+  len: [64],
+  n: [1e5]
+});
+
+function main(conf) {
+  const api = conf.api;
+  const algo = conf.algo;
+  const n = +conf.n;
+  const prefix = Buffer.alloc(+conf.prefix, 'p');
+  const message = Buffer.alloc(+conf.len, 'm');
+  var i;
+
+  bench.start();
+  if (api === 'rehash') {
+    for (i = 0; i < n; i++)
+      crypto.createHash(algo).update(prefix).update(message).digest();
+  } else if (api === 'copy') {
+    const hash = crypto.createHash(algo).update(prefix);
+    for (i = 0; i < n; i++)
+      hash.copy().update(message).digest();
+  } else if (api === 'createHmac') {
+    for (i = 0; i < n; i++)
+      crypto.createHmac(algo, prefix).update(message).digest();
+  } else {
+    const hmac = crypto.createHmac(algo, prefix);
+    for (i = 0; i < n; i++)
+      hmac.update(message).digest({ reset: true });
+  }
+  bench.end(n);
+}
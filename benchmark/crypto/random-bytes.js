@@ -0,0 +1,56 @@
+// Random data for small, ID sized requests and for larger ones: new buffers
+// from crypto.randomBytes(), synchronously and with a callback, and an
+// existing buffer filled by crypto.randomFillSync() and crypto.randomFill().
+'use strict';
+const common = require('../common.js');
+const crypto = require('crypto');
+
+const bench = common.createBenchmark(main, {
+  api: ['randomBytes', 'randomBytes-async', 'randomFillSync', 'randomFill'],
+  size: [16, 1024],
+  n: [1e5]
+});
+
+function main(conf) {
+  const api = conf.api;
+  const size = +conf.size;
+  const n = +conf.n;
+  const buf = Buffer.alloc(size);
+  var i;
+
+  if (api === 'randomBytes-async' || api === 'randomFill') {
+    // A handful of requests in flight, as a busy server would have.
+    const concurrency = 4;
+    var started = 0;
+    var done = 0;
+    const start = () => {
+      started++;
+      if (api === 'randomFill')
+        crypto.randomFill(buf, next);
+      else
+        crypto.randomBytes(size, next);
+    };
+    const next = (err) => {
+      if (err)
+        throw err;
+      if (++done === n)
+        return bench.end(n);
+      if (started < n)
+        start();
+    };
+    bench.start();
+    for (i = 0; i < concurrency; i++)
+      start();
+    return;
+  }
+
+  bench.start();
+  if (api === 'randomFillSync') {
+    for (i = 0; i < n; i++)
+      crypto.randomFillSync(buf);
+  } else {
+    for (i = 0; i < n; i++)
+      crypto.randomBytes(size);
+  }
+  bench.end(n);
+}
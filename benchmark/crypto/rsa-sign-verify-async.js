@@ -0,0 +1,64 @@
+'use strict';
+// Signatures and verifications per second, synchronously or on the
+// threadpool. Unlike rsa-sign-verify-throughput.js the messages are short,
+// so the time goes into the private and public key operations.
+const common = require('../common.js');
+const crypto = require('crypto');
+const fs = require('fs');
+const path = require('path');
+const fixtures_keydir = path.resolve(__dirname, '../../test/fixtures/keys/');
+
+const bench = common.createBenchmark(main, {
+  op: ['sign', 'verify'],
+  api: ['sync', 'async'],
+  algo: ['RSA-SHA256'],
+  keylen: ['2048', '4096'],
+  n: [500]
+});
+
+function main(conf) {
+  const n = +conf.n;
+  const algo = conf.algo;
+  const privateKey = fs.readFileSync(
+    path.join(fixtures_keydir, `rsa_private_${conf.keylen}.pem`));
+  const publicKey = fs.readFileSync(
+    path.join(fixtures_keydir, `rsa_public_${conf.keylen}.pem`));
+  const message = Buffer.alloc(256, 'b');
+  const signature = crypto.createSign(algo).update(message).sign(privateKey);
+
+  function run(cb) {
+    if (conf.op === 'sign')
+      return crypto.createSign(algo).update(message).sign(privateKey, cb);
+    return crypto.createVerify(algo).update(message)
+      .verify(publicKey, signature, cb);
+  }
+
+  var i;
+  if (conf.api === 'sync') {
+    bench.start();
+    for (i = 0; i < n; i++)
+      run();
+    bench.end(n);
+    return;
+  }
+
+  // Keep as many operations in flight as the threadpool has threads.
+  const concurrency = Math.min(+process.env.UV_THREADPOOL_SIZE || 4, n);
+  var started = 0;
+  var done = 0;
+  function next(err) {
+    if (err)
+      throw err;
+    if (++done === n)
+      return bench.end(n);
+    if (started < n) {
+      started++;
+      run(next);
+    }
+  }
+  bench.start();
+  for (i = 0; i < concurrency; i++) {
+    started++;
+    run(next);
+  }
+}
@@ -4,19 +4,44 @@ const common = require('../common');
 const fs = require('fs');
 const path = require('path');
 
+// `types` reads the entry types with withFileTypes, `stat` gets them the
+// old way with one fs.stat() per entry.
 const bench = common.createBenchmark(main, {
   n: [1e4],
+  mode: ['names', 'types', 'stat']
 });
 
+const dir = path.resolve(__dirname, '../../lib/');
+
+function readdirStat(cb) {
+  fs.readdir(dir, function(err, files) {
+    if (err) throw err;
+    var pending = files.length;
+    files.forEach(function(file) {
+      fs.stat(path.join(dir, file), function(err) {
+        if (err) throw err;
+        if (--pending === 0)
+          cb();
+      });
+    });
+  });
+}
 
 function main(conf) {
   const n = conf.n >>> 0;
+  var fn;
+  if (conf.mode === 'stat')
+    fn = readdirStat;
+  else if (conf.mode === 'types')
+    fn = (cb) => fs.readdir(dir, { withFileTypes: true }, cb);
+  else
+    fn = (cb) => fs.readdir(dir, cb);
 
   bench.start();
   (function r(cntr) {
     if (cntr-- <= 0)
       return bench.end(n);
-    fs.readdir(path.resolve(__dirname, '../../lib/'), function() {
+    fn(function() {
       r(cntr);
     });
   }(n));
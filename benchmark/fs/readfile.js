@@ -10,7 +10,8 @@ var fs = require('fs');
 
 var bench = common.createBenchmark(main, {
   dur: [5],
-  len: [1024, 16 * 1024 * 1024],
+  len: [16, 1024, 16 * 1024 * 1024],
+  encoding: ['', 'utf8'],
   concurrent: [1, 10]
 });
 
@@ -29,8 +30,10 @@ function main(conf) {
     process.exit(0);
   }, +conf.dur * 1000);
 
+  var encoding = conf.encoding || null;
+
   function read() {
-    fs.readFile(filename, afterRead);
+    fs.readFile(filename, encoding, afterRead);
   }
 
   function afterRead(er, data) {
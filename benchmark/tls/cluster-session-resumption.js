@@ -0,0 +1,89 @@
+// Session resumption across cluster workers. Clients keep reconnecting with
+// the session of their previous connection while the master hands the
+// connections out round-robin, so a connection rarely lands on the worker
+// that issued its session.
+//
+// metric=resumed reports the percentage of handshakes that were resumed,
+// metric=latency the mean time to a secure connection in microseconds.
+'use strict';
+const common = require('../common.js');
+const cluster = require('cluster');
+const fs = require('fs');
+const path = require('path');
+const tls = require('tls');
+
+const cert_dir = path.resolve(__dirname, '../../test/fixtures');
+
+if (cluster.isWorker) {
+  const SSL_OP_NO_TICKET = require('crypto').constants.SSL_OP_NO_TICKET;
+  const server = tls.createServer({
+    key: fs.readFileSync(cert_dir + '/test_key.pem'),
+    cert: fs.readFileSync(cert_dir + '/test_cert.pem'),
+    // Tickets are shared between workers anyway, measure id based resumption.
+    secureOptions: SSL_OP_NO_TICKET
+  }, (socket) => socket.end());
+  server.listen(common.PORT);
+  return;
+}
+
+const bench = common.createBenchmark(main, {
+  cache: [0, 1],
+  metric: ['resumed', 'latency'],
+  workers: [4],
+  clients: [8],
+  dur: [5]
+});
+
+function main(conf) {
+  const dur = +conf.dur;
+  cluster.schedulingPolicy = cluster.SCHED_RR;
+  cluster.setupMaster({ tlsSessionCache: +conf.cache ? 4096 : 0 });
+
+  var listening = 0;
+  for (var i = 0; i < +conf.workers; i++) {
+    cluster.fork().on('listening', () => {
+      if (++listening === +conf.workers)
+        run();
+    });
+  }
+
+  function run() {
+    var running = true;
+    var handshakes = 0;
+    var resumed = 0;
+    var elapsed = 0;
+
+    function connect(session) {
+      const start = process.hrtime();
+      const conn = tls.connect({
+        port: common.PORT,
+        session: session,
+        rejectUnauthorized: false
+      }, () => {
+        const time = process.hrtime(start);
+        elapsed += time[0] * 1e6 + time[1] / 1e3;
+        handshakes++;
+        if (conn.isSessionReused())
+          resumed++;
+        const next = conn.getSession();
+        conn.destroy();
+        if (running)
+          connect(next);
+      });
+    }
+
+    const start = process.hrtime();
+    bench.start();
+    for (var i = 0; i < +conf.clients; i++)
+      connect();
+    setTimeout(() => {
+      running = false;
+      const time = process.hrtime(start);
+      if (conf.metric === 'resumed')
+        bench.report(100 * resumed / handshakes, time);
+      else
+        bench.report(elapsed / handshakes, time);
+      cluster.disconnect();
+    }, dur * 1000);
+  }
+}
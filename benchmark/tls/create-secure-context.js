@@ -0,0 +1,28 @@
+// Contexts created per second from the same key, certificate chain and CAs,
+// as a server does that creates one context per SNI name.
+'use strict';
+const common = require('../common.js');
+const fs = require('fs');
+const path = require('path');
+const tls = require('tls');
+
+const bench = common.createBenchmark(main, {
+  ca: [0, 1],
+  n: [5e3]
+});
+
+function main(conf) {
+  const n = +conf.n;
+  const keys = path.resolve(__dirname, '../../test/fixtures/keys');
+  const options = {
+    key: fs.readFileSync(path.join(keys, 'agent1-key.pem')),
+    cert: fs.readFileSync(path.join(keys, 'agent1-cert.pem'))
+  };
+  if (+conf.ca)
+    options.ca = [fs.readFileSync(path.join(keys, 'ca1-cert.pem'))];
+
+  bench.start();
+  for (var i = 0; i < n; i++)
+    tls.createSecureContext(options);
+  bench.end(n);
+}
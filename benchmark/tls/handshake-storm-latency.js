@@ -0,0 +1,93 @@
+// 99th percentile round-trip latency, in microseconds, of an established
+// TLS connection while other clients keep opening new connections to the
+// same server. Lower is better.
+'use strict';
+const common = require('../common.js');
+const fs = require('fs');
+const path = require('path');
+const tls = require('tls');
+
+const cert_dir = path.resolve(__dirname, '../../test/fixtures');
+
+if (process.argv[2] === 'storm') {
+  const port = +process.argv[3];
+  const concurrency = +process.argv[4];
+  const connect = () => {
+    const conn = tls.connect({
+      port: port,
+      rejectUnauthorized: false,
+      ciphers: 'ECDHE-RSA-AES128-GCM-SHA256'
+    }, () => {
+      conn.destroy();
+      connect();
+    });
+    conn.on('error', () => process.exit());
+  };
+  for (var i = 0; i < concurrency; i++)
+    connect();
+  process.on('disconnect', () => process.exit());
+  return;
+}
+
+const bench = common.createBenchmark(main, {
+  storm: [0, 16],
+  dur: [5]
+});
+
+function main(conf) {
+  const dur = +conf.dur;
+  const options = {
+    key: fs.readFileSync(cert_dir + '/test_key.pem'),
+    cert: fs.readFileSync(cert_dir + '/test_cert.pem')
+  };
+
+  const server = tls.createServer(options, (socket) => {
+    socket.on('error', () => {});
+    socket.pipe(socket);
+  });
+
+  server.listen(common.PORT, () => {
+    var child;
+    const samples = [];
+    const conn = tls.connect({
+      port: common.PORT,
+      rejectUnauthorized: false
+    }, () => {
+      if (+conf.storm > 0) {
+        const args = ['storm', common.PORT, conf.storm];
+        child = require('child_process').fork(__filename, args);
+      }
+
+      // Give the storm a moment to build up before sampling.
+      setTimeout(() => {
+        var sent;
+        var running = true;
+        const ping = () => {
+          sent = process.hrtime();
+          conn.write('x');
+        };
+        conn.on('data', () => {
+          const elapsed = process.hrtime(sent);
+          samples.push(elapsed[0] * 1e6 + elapsed[1] / 1e3);
+          if (running)
+            ping();
+        });
+
+        const start = process.hrtime();
+        bench.start();
+        ping();
+        setTimeout(() => {
+          running = false;
+          const time = process.hrtime(start);
+          samples.sort((a, b) => a - b);
+          const p99 = samples[Math.floor(samples.length * 0.99)];
+          bench.report(p99, time);
+          if (child)
+            child.kill();
+          conn.destroy();
+          server.close();
+        }, dur * 1000);
+      }, 500);
+    });
+  });
+}
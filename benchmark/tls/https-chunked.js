@@ -0,0 +1,66 @@
+// Throughput of chunked HTTPS responses. Every res.write() turns into a
+// writev of the chunk size line, the chunk and a CRLF, which is where
+// gathering small buffers into full TLS records pays off.
+'use strict';
+var common = require('../common.js');
+var bench = common.createBenchmark(main, {
+  dur: [5],
+  size: [64, 1024, 16 * 1024],
+  chunks: [16, 256]
+});
+
+var fs = require('fs');
+var https = require('https');
+var path = require('path');
+var cert_dir = path.resolve(__dirname, '../../test/fixtures');
+
+function main(conf) {
+  var dur = +conf.dur;
+  var chunks = +conf.chunks;
+  var chunk = Buffer.alloc(+conf.size, 'x');
+
+  var options = {
+    key: fs.readFileSync(cert_dir + '/test_key.pem'),
+    cert: fs.readFileSync(cert_dir + '/test_cert.pem'),
+    ciphers: 'AES128-GCM-SHA256'
+  };
+
+  var server = https.createServer(options, function(req, res) {
+    res.writeHead(200, { 'Content-Type': 'application/octet-stream' });
+    for (var i = 0; i < chunks; i++)
+      res.write(chunk);
+    res.end();
+  });
+
+  var agent = new https.Agent({ keepAlive: true, maxSockets: 1 });
+  var received = 0;
+  var running = true;
+
+  function request() {
+    https.get({
+      port: common.PORT,
+      agent: agent,
+      rejectUnauthorized: false
+    }, function(res) {
+      res.on('data', function(data) {
+        received += data.length;
+      });
+      res.on('end', function() {
+        if (running)
+          request();
+      });
+    });
+  }
+
+  server.listen(common.PORT, function() {
+    bench.start();
+    request();
+    setTimeout(function() {
+      running = false;
+      var mbits = (received * 8) / (1024 * 1024);
+      bench.end(mbits);
+      agent.destroy();
+      server.close();
+    }, dur * 1000);
+  });
+}
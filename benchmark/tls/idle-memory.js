@@ -0,0 +1,66 @@
+// Memory held per idle TLS socket, in bytes, after every connection has
+// completed its handshake and one round trip. `bio` counts the buffers
+// held by the sockets' BIOs, `rss` is the growth of the resident set size
+// divided by the number of sockets (client and server side). Lower is better.
+'use strict';
+const common = require('../common.js');
+const fs = require('fs');
+const path = require('path');
+const tls = require('tls');
+
+const bench = common.createBenchmark(main, {
+  conns: [100, 1000],
+  metric: ['bio', 'rss']
+});
+
+function main(conf) {
+  const conns = +conf.conns;
+  const cert_dir = path.resolve(__dirname, '../../test/fixtures');
+  const options = {
+    key: fs.readFileSync(cert_dir + '/test_key.pem'),
+    cert: fs.readFileSync(cert_dir + '/test_cert.pem')
+  };
+  const sockets = [];
+
+  const server = tls.createServer(options, (socket) => {
+    sockets.push(socket);
+    socket.pipe(socket);
+  });
+
+  server.listen(common.PORT, () => {
+    const rss = process.memoryUsage().rss;
+    const start = process.hrtime();
+    var pending = conns;
+
+    bench.start();
+    for (var i = 0; i < conns; i++) {
+      const conn = tls.connect({
+        port: common.PORT,
+        rejectUnauthorized: false
+      }, () => {
+        conn.write('x');
+      });
+      conn.once('data', () => {
+        sockets.push(conn);
+        if (--pending === 0)
+          setTimeout(done, 100);
+      });
+    }
+
+    function done() {
+      const time = process.hrtime(start);
+      var bytes;
+      if (conf.metric === 'bio') {
+        bytes = 0;
+        for (const socket of sockets)
+          bytes += socket._handle.getMemoryUsage();
+      } else {
+        bytes = process.memoryUsage().rss - rss;
+      }
+      bench.report(bytes / sockets.length, time);
+      for (const socket of sockets)
+        socket.destroy();
+      server.close();
+    }
+  });
+}
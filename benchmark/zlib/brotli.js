@@ -0,0 +1,63 @@
+// Brotli against gzip on text, at comparable settings. `throughput` is in
+// MB/s of uncompressed data, `ratio` is the compressed size in percent of
+// the original (lower is better). Needs node built with --shared-brotli.
+'use strict';
+const common = require('../common.js');
+const fs = require('fs');
+const path = require('path');
+const zlib = require('zlib');
+
+const bench = common.createBenchmark(main, {
+  method: ['gzip', 'brotli'],
+  op: ['compress', 'decompress'],
+  preset: ['fast', 'default', 'best'],
+  metric: ['throughput', 'ratio'],
+  n: [20]
+});
+
+// gzip levels and brotli qualities for each preset.
+const presets = {
+  fast: { level: 1, quality: 1 },
+  default: { level: 6, quality: 6 },
+  best: { level: 9, quality: 11 }
+};
+
+function main(conf) {
+  const n = +conf.n;
+  const preset = presets[conf.preset];
+
+  const file = path.resolve(__dirname, '../fixtures/alice.html');
+  var input = fs.readFileSync(file);
+  input = Buffer.concat(new Array(Math.ceil((1 << 20) / input.length))
+                          .fill(input));
+  const mb = input.length / (1024 * 1024);
+
+  var compress, decompress;
+  if (conf.method === 'brotli') {
+    if (!zlib.brotliCompressSync)
+      throw new Error('node was built without brotli support');
+    compress = () => zlib.brotliCompressSync(input, {
+      quality: preset.quality,
+      mode: zlib.constants.BROTLI_MODE_TEXT
+    });
+    decompress = zlib.brotliDecompressSync;
+  } else {
+    compress = () => zlib.gzipSync(input, { level: preset.level });
+    decompress = zlib.gunzipSync;
+  }
+
+  const compressed = compress();
+  if (conf.metric === 'ratio') {
+    bench.report(compressed.length / input.length * 100, [0, 0]);
+    return;
+  }
+
+  var fn = compress;
+  if (conf.op === 'decompress')
+    fn = () => decompress(compressed);
+
+  bench.start();
+  for (var i = 0; i < n; i++)
+    fn();
+  bench.end(n * mb);
+}
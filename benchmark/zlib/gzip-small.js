@@ -0,0 +1,47 @@
+// Compression and decompression of small payloads with the convenience
+// methods, the way an HTTP server compresses individual responses. The async
+// methods are called one after the other, so their rate is the inverse of
+// the latency of one call.
+'use strict';
+const common = require('../common.js');
+const zlib = require('zlib');
+
+const bench = common.createBenchmark(main, {
+  method: ['gzipSync', 'gunzipSync', 'deflateSync', 'inflateSync',
+           'gzip', 'gunzip'],
+  len: [64, 1024, 16384],
+  n: [5e3]
+});
+
+function main(conf) {
+  const method = conf.method;
+  const len = +conf.len;
+  const n = +conf.n;
+
+  var input = Buffer.alloc(len);
+  for (var i = 0; i < len; i++)
+    input[i] = 97 + (i % 13) * (i % 7) % 26;
+  if (method === 'gunzipSync' || method === 'gunzip')
+    input = zlib.gzipSync(input);
+  else if (method === 'inflateSync')
+    input = zlib.deflateSync(input);
+
+  const fn = zlib[method];
+  if (/Sync$/.test(method)) {
+    bench.start();
+    for (i = 0; i < n; i++)
+      fn(input);
+    bench.end(n);
+    return;
+  }
+
+  i = 0;
+  bench.start();
+  (function next(err) {
+    if (err)
+      throw err;
+    if (i++ === n)
+      return bench.end(n);
+    fn(input, next);
+  })();
+}
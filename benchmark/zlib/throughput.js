@@ -0,0 +1,49 @@
+// Compression and decompression throughput in MB/s of uncompressed data, per
+// compression level, for text and for data that doesn't compress.
+'use strict';
+const common = require('../common.js');
+const fs = require('fs');
+const path = require('path');
+const zlib = require('zlib');
+
+const bench = common.createBenchmark(main, {
+  method: ['gzip', 'gunzip', 'deflate', 'inflate'],
+  level: [1, 6, 9],
+  content: ['text', 'random'],
+  n: [20]
+});
+
+function main(conf) {
+  const method = conf.method;
+  const level = +conf.level;
+  const n = +conf.n;
+
+  var input;
+  if (conf.content === 'text') {
+    const file = path.resolve(__dirname, '../fixtures/alice.html');
+    input = fs.readFileSync(file);
+    input = Buffer.concat(new Array(Math.ceil((4 << 20) / input.length))
+                            .fill(input));
+  } else {
+    input = Buffer.alloc(4 << 20);
+    for (var i = 0; i < input.length; i++)
+      input[i] = Math.random() * 256;
+  }
+  const mb = input.length / (1024 * 1024);
+
+  var fn;
+  if (method === 'gunzip' || method === 'inflate') {
+    const compress = method === 'gunzip' ? zlib.gzipSync : zlib.deflateSync;
+    const compressed = compress(input, { level });
+    const decompress = zlib[method + 'Sync'];
+    fn = () => decompress(compressed);
+  } else {
+    const compress = zlib[method + 'Sync'];
+    fn = () => compress(input, { level });
+  }
+
+  bench.start();
+  for (i = 0; i < n; i++)
+    fn();
+  bench.end(n * mb);
+}
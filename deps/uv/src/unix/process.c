@@ -44,6 +44,18 @@ extern char **environ;
 # include <grp.h>
 #endif
 
+/* glibc implements posix_spawn() with clone(CLONE_VM | CLONE_VFORK) since
+ * 2.24 and reports exec() errors to the caller instead of through the exit
+ * status of the child, which is what uv__spawn_posix() relies on.
+ */
+#if defined(__GLIBC__) && !defined(__UCLIBC__)
+# if __GLIBC_PREREQ(2, 24)
+#  define UV__USE_POSIX_SPAWN 1
+#  include <spawn.h>
+#  include <string.h>
+# endif
+#endif
+
 
 static void uv__chld(uv_signal_t* handle, int signum) {
   uv_process_t* process;
@@ -383,6 +395,289 @@ static void uv__process_child_init(const uv_process_options_t* options,
 #endif
 
 
+#if defined(UV__USE_POSIX_SPAWN)
+/* Returns the value of the PATH variable that execvp() would use in a child
+ * that runs with `env`.
+ */
+static const char* uv__spawn_path(char** env) {
+  const char* path;
+
+  if (env == NULL)
+    path = getenv("PATH");
+  else
+    for (path = NULL; *env != NULL; env++)
+      if (strncmp(*env, "PATH=", 5) == 0)
+        path = *env + 5;
+
+  return path != NULL ? path : "/bin:/usr/bin";
+}
+
+
+static int uv__spawn_posix_file_actions(const uv_process_options_t* options,
+                                        int stdio_count,
+                                        int (*pipes)[2],
+                                        int* temp_fds,
+                                        posix_spawn_file_actions_t* actions) {
+  int use_fd;
+  int fd;
+  int i;
+
+  /* Same as uv__process_child_init(): low numbered fds are moved out of the
+   * way first so that they can't get replaced before they are duplicated.
+   * The parent does it here; the copies are close-on-exec.
+   */
+  for (fd = 0; fd < stdio_count; fd++) {
+    use_fd = pipes[fd][1];
+    if (use_fd < 0 || use_fd >= fd)
+      continue;
+    temp_fds[fd] = fcntl(use_fd, F_DUPFD_CLOEXEC, stdio_count);
+    if (temp_fds[fd] == -1)
+      return -errno;
+  }
+
+  for (fd = 0; fd < stdio_count; fd++) {
+    use_fd = temp_fds[fd] != -1 ? temp_fds[fd] : pipes[fd][1];
+
+    if (use_fd < 0) {
+      if (fd >= 3)
+        continue;
+      /* redirect stdin, stdout and stderr to /dev/null even if UV_IGNORE is
+       * set
+       */
+      if (posix_spawn_file_actions_addopen(actions,
+                                           fd,
+                                           "/dev/null",
+                                           fd == 0 ? O_RDONLY : O_RDWR,
+                                           0))
+        return -ENOMEM;
+      continue;
+    }
+
+    /* The child clears O_NONBLOCK on its stdio in uv__process_child_init().
+     * The flag lives in the open file description, which the parent shares,
+     * so clearing it from here has the same effect.
+     */
+    if (fd <= 2)
+      uv__nonblock(use_fd, 0);
+
+    if (fd == use_fd)
+      continue;  /* Checked not to be close-on-exec in uv__spawn_posix(). */
+
+    if (posix_spawn_file_actions_adddup2(actions, use_fd, fd))
+      return -ENOMEM;
+  }
+
+  /* Don't leak inherited fds that were only needed as a source of dup2(). */
+  for (fd = 0; fd < stdio_count; fd++) {
+    use_fd = pipes[fd][1];
+    if (use_fd < stdio_count)
+      continue;
+    for (i = 0; i < fd; i++)
+      if (pipes[i][1] == use_fd)
+        break;
+    if (i < fd)
+      continue;  /* Already closed. */
+    if (posix_spawn_file_actions_addclose(actions, use_fd))
+      return -ENOMEM;
+  }
+
+  if (options->cwd != NULL) {
+#if __GLIBC_PREREQ(2, 29)
+    if (posix_spawn_file_actions_addchdir_np(actions, options->cwd))
+      return -ENOMEM;
+#else
+    return -ENOSYS;
+#endif
+  }
+
+  return 0;
+}
+
+
+/* Creates the child with posix_spawn() rather than fork(). The cost of fork()
+ * grows with the size of the parent's address space because the page tables
+ * have to be copied, which makes spawning from a process with a large heap
+ * slow. Returns -ENOSYS when the options need the fork() path, another error
+ * when the child could not be set up, or 0 when the child was started. In
+ * the last case `exec_errorno` is what exec() failed with, or 0.
+ */
+static int uv__spawn_posix(uv_loop_t* loop,
+                           const uv_process_options_t* options,
+                           int stdio_count,
+                           int (*pipes)[2],
+                           pid_t* pid,
+                           int* exec_errorno) {
+  posix_spawn_file_actions_t actions;
+  posix_spawnattr_t attr;
+  const char* path;
+  const char* end;
+  char** env;
+  char* file;
+  size_t dir_len;
+  size_t file_len;
+  int* temp_fds;
+  int seen_eacces;
+  int use_fd;
+  int flags;
+  int err;
+  int fd;
+  int r;
+
+  if (options->flags & (UV_PROCESS_SETUID | UV_PROCESS_SETGID))
+    return -ENOSYS;
+
+#if !__GLIBC_PREREQ(2, 29)
+  if (options->cwd != NULL)
+    return -ENOSYS;
+#endif
+
+#if !defined(POSIX_SPAWN_SETSID)
+  if (options->flags & UV_PROCESS_DETACHED)
+    return -ENOSYS;
+#endif
+
+  /* A dup2() onto itself is how the child would clear FD_CLOEXEC but
+   * posix_spawn() implementations differ in whether they honor that.
+   */
+  for (fd = 0; fd < stdio_count; fd++) {
+    use_fd = pipes[fd][1];
+    if (use_fd != fd)
+      continue;
+    flags = fcntl(use_fd, F_GETFD);
+    if (flags == -1 || (flags & FD_CLOEXEC))
+      return -ENOSYS;
+  }
+
+  temp_fds = uv__malloc(stdio_count * sizeof(*temp_fds));
+  if (temp_fds == NULL)
+    return -ENOMEM;
+
+  for (fd = 0; fd < stdio_count; fd++)
+    temp_fds[fd] = -1;
+
+  file = NULL;
+  env = options->env != NULL ? options->env : environ;
+  r = 0;
+
+  if (posix_spawn_file_actions_init(&actions)) {
+    uv__free(temp_fds);
+    return -ENOMEM;
+  }
+
+  if (posix_spawnattr_init(&attr)) {
+    posix_spawn_file_actions_destroy(&actions);
+    uv__free(temp_fds);
+    return -ENOMEM;
+  }
+
+  /* Keep worker threads from opening fds that aren't close-on-exec while the
+   * child is being set up.
+   */
+  uv_rwlock_wrlock(&loop->cloexec_lock);
+
+  err = uv__spawn_posix_file_actions(options,
+                                     stdio_count,
+                                     pipes,
+                                     temp_fds,
+                                     &actions);
+  if (err)
+    goto out;
+
+#if defined(POSIX_SPAWN_SETSID)
+  if (options->flags & UV_PROCESS_DETACHED) {
+    err = -posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETSID);
+    if (err)
+      goto out;
+  }
+#endif
+
+  uv_signal_start(&loop->child_watcher, uv__chld, SIGCHLD);
+
+  /* Search PATH the way execvp() does in the fork() path, where environ has
+   * already been replaced with options->env at that point.
+   */
+  if (strchr(options->file, '/') != NULL) {
+    r = -posix_spawn(pid, options->file, &actions, &attr, options->args, env);
+    goto out;
+  }
+
+  file_len = strlen(options->file);
+  seen_eacces = 0;
+  r = -ENOENT;
+
+  for (path = uv__spawn_path(options->env); ; path = end + 1) {
+    end = strchr(path, ':');
+    if (end == NULL)
+      end = path + strlen(path);
+    dir_len = end - path;
+
+    uv__free(file);
+    file = uv__malloc(dir_len + 1 + file_len + 1);
+    if (file == NULL) {
+      err = -ENOMEM;
+      goto out;
+    }
+
+    /* An empty element means the current directory. */
+    if (dir_len == 0) {
+      memcpy(file, options->file, file_len + 1);
+    } else {
+      memcpy(file, path, dir_len);
+      file[dir_len] = '/';
+      memcpy(file + dir_len + 1, options->file, file_len + 1);
+    }
+
+    /* Skip the clone() for entries that obviously don't exist. Relative paths
+     * are checked by the child, after options->cwd has been applied.
+     */
+    if (file[0] == '/' && access(file, F_OK) && errno != EACCES)
+      r = -errno;
+    else
+      r = -posix_spawn(pid, file, &actions, &attr, options->args, env);
+
+    if (r == 0)
+      break;
+
+    if (r == -EACCES)
+      seen_eacces = 1;
+    else if (r != -ENOENT && r != -ENOTDIR && r != -ESTALE &&
+             r != -ENODEV && r != -ETIMEDOUT)
+      break;
+
+    if (*end == '\0') {
+      if (seen_eacces)
+        r = -EACCES;
+      break;
+    }
+  }
+
+out:
+  uv_rwlock_wrunlock(&loop->cloexec_lock);
+
+  for (fd = 0; fd < stdio_count; fd++)
+    if (temp_fds[fd] != -1)
+      uv__close_nocheckstdio(temp_fds[fd]);
+
+  uv__free(file);
+  uv__free(temp_fds);
+  posix_spawnattr_destroy(&attr);
+  posix_spawn_file_actions_destroy(&actions);
+
+  if (err)
+    return err;
+
+  /* execvp() falls back to running the file with /bin/sh when the kernel
+   * doesn't recognize it as an executable, posix_spawn() doesn't.
+   */
+  if (r == -ENOEXEC)
+    return -ENOSYS;
+
+  *exec_errorno = r;
+  return 0;
+}
+#endif
+
+
 int uv_spawn(uv_loop_t* loop,
              uv_process_t* process,
              const uv_process_options_t* options) {
@@ -430,6 +725,17 @@ int uv_spawn(uv_loop_t* loop,
       goto error;
   }
 
+#if defined(UV__USE_POSIX_SPAWN)
+  pid = 0;
+  err = uv__spawn_posix(loop, options, stdio_count, pipes, &pid, &exec_errorno);
+  if (err == 0) {
+    process->status = 0;
+    goto spawned;
+  }
+  if (err != -ENOSYS)
+    goto error;
+#endif
+
   /* This pipe is used by the parent to wait until
    * the child has called `execve()`. We need this
    * to avoid the following race condition:
@@ -500,6 +806,9 @@ int uv_spawn(uv_loop_t* loop,
 
   uv__close_nocheckstdio(signal_pipe[0]);
 
+#if defined(UV__USE_POSIX_SPAWN)
+spawned:
+#endif
   for (i = 0; i < options->stdio_count; i++) {
     err = uv__process_open_stream(options->stdio + i, pipes[i], i == 0);
     if (err == 0)
@@ -0,0 +1,98 @@
+/* adler32_simd.c -- Adler-32 using SSSE3
+ * For conditions of distribution and use, see copyright notice in zlib.h
+ *
+ * Takes the input 32 bytes at a time.  For a block b[0..31] added to sums
+ * (s1, s2):
+ *
+ *   s1' = s1 + sum(b[i])
+ *   s2' = s2 + 32 * s1 + sum((32 - i) * b[i])
+ *
+ * PSADBW gives the byte sums, PMADDUBSW/PMADDWD the weighted sums.  The
+ * 32 * s1 terms of all blocks are collected in one vector and added at the
+ * end, and the modulo is taken once per NMAX bytes, as in adler32.c.
+ */
+
+#include "adler32_simd.h"
+
+#ifdef ZLIB_X86_SIMD
+
+#include <emmintrin.h>
+#include <tmmintrin.h>
+
+#define BASE 65521U     /* largest prime smaller than 65536 */
+#define NMAX 5552       /* see adler32.c */
+#define BLOCK_SIZE 32
+
+ZLIB_TARGET("ssse3")
+uLong ZLIB_INTERNAL adler32_simd_(adler, buf, len)
+    uLong adler;
+    const Bytef *buf;
+    uInt len;
+{
+    unsigned s1 = (unsigned)(adler & 0xffff);
+    unsigned s2 = (unsigned)((adler >> 16) & 0xffff);
+    unsigned blocks = len / BLOCK_SIZE;
+
+    const __m128i tap1 = _mm_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25,
+                                       24, 23, 22, 21, 20, 19, 18, 17);
+    const __m128i tap2 = _mm_setr_epi8(16, 15, 14, 13, 12, 11, 10, 9,
+                                       8, 7, 6, 5, 4, 3, 2, 1);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ones = _mm_set1_epi16(1);
+
+    len -= blocks * BLOCK_SIZE;
+
+    while (blocks) {
+        unsigned n = NMAX / BLOCK_SIZE;
+        unsigned lanes[4];
+        unsigned long long sum;
+        __m128i v_ps, v_s1, v_s2;
+
+        if (n > blocks)
+            n = blocks;
+        blocks -= n;
+
+        /* s1 as it stands before each block, summed over the blocks. */
+        v_ps = _mm_setr_epi32((int)(s1 * n), 0, 0, 0);
+        v_s2 = _mm_setr_epi32((int)s2, 0, 0, 0);
+        v_s1 = zero;
+
+        do {
+            const __m128i bytes1 = _mm_loadu_si128((const __m128i *)buf);
+            const __m128i bytes2 = _mm_loadu_si128((const __m128i *)(buf + 16));
+
+            v_ps = _mm_add_epi32(v_ps, v_s1);
+
+            v_s1 = _mm_add_epi32(v_s1, _mm_sad_epu8(bytes1, zero));
+            v_s2 = _mm_add_epi32(v_s2,
+                _mm_madd_epi16(_mm_maddubs_epi16(bytes1, tap1), ones));
+            v_s1 = _mm_add_epi32(v_s1, _mm_sad_epu8(bytes2, zero));
+            v_s2 = _mm_add_epi32(v_s2,
+                _mm_madd_epi16(_mm_maddubs_epi16(bytes2, tap2), ones));
+
+            buf += BLOCK_SIZE;
+        } while (--n);
+
+        v_s2 = _mm_add_epi32(v_s2, _mm_slli_epi32(v_ps, 5));
+
+        /* Each lane stays below 2^32 for NMAX bytes, their sum may not. */
+        _mm_storeu_si128((__m128i *)lanes, v_s1);
+        sum = (unsigned long long)s1 + lanes[0] + lanes[2];
+        s1 = (unsigned)(sum % BASE);
+        _mm_storeu_si128((__m128i *)lanes, v_s2);
+        sum = (unsigned long long)lanes[0] + lanes[1] + lanes[2] + lanes[3];
+        s2 = (unsigned)(sum % BASE);
+    }
+
+    /* Fewer than 32 bytes left. */
+    while (len--) {
+        s1 += *buf++;
+        s2 += s1;
+    }
+    s1 %= BASE;
+    s2 %= BASE;
+
+    return (uLong)s1 | ((uLong)s2 << 16);
+}
+
+#endif /* ZLIB_X86_SIMD */
@@ -0,0 +1,20 @@
+/* adler32_simd.h -- Adler-32 using SSSE3
+ * For conditions of distribution and use, see copyright notice in zlib.h
+ */
+
+#ifndef ADLER32_SIMD_H
+#define ADLER32_SIMD_H
+
+#include "cpu_features.h"
+
+#ifdef ZLIB_X86_SIMD
+
+/* Worth it from this many bytes on. */
+#  define Z_ADLER32_SIMD_MIN_LEN 64
+
+uLong ZLIB_INTERNAL adler32_simd_ OF((uLong adler, const Bytef *buf,
+                                      uInt len));
+
+#endif /* ZLIB_X86_SIMD */
+
+#endif /* ADLER32_SIMD_H */
@@ -0,0 +1,50 @@
+/* cpu_features.c -- runtime detection of x86 SIMD extensions
+ * For conditions of distribution and use, see copyright notice in zlib.h
+ */
+
+#include "cpu_features.h"
+
+#ifdef ZLIB_X86_SIMD
+
+#ifdef _MSC_VER
+#  include <intrin.h>
+#else
+#  include <cpuid.h>
+#endif
+
+int ZLIB_INTERNAL x86_cpu_enable_crc32_simd = 0;
+int ZLIB_INTERNAL x86_cpu_enable_adler32_simd = 0;
+
+/* Several threads may get here at once.  They all store the same values,
+   and a thread that sees the flags before they are set simply takes the
+   portable path, so no locking is needed. */
+local volatile int features_checked = 0;
+
+void ZLIB_INTERNAL cpu_check_features()
+{
+    unsigned ecx;
+
+    if (features_checked)
+        return;
+
+#ifdef _MSC_VER
+    {
+        int regs[4];
+        __cpuid(regs, 1);
+        ecx = (unsigned)regs[2];
+    }
+#else
+    {
+        unsigned eax, ebx, edx;
+        if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+            ecx = 0;
+    }
+#endif
+
+    /* CPUID.1:ECX bit 1 is PCLMULQDQ, bit 9 SSSE3, bit 19 SSE4.1. */
+    x86_cpu_enable_crc32_simd = (ecx & (1u << 1)) && (ecx & (1u << 19));
+    x86_cpu_enable_adler32_simd = (ecx & (1u << 9)) != 0;
+    features_checked = 1;
+}
+
+#endif /* ZLIB_X86_SIMD */
@@ -0,0 +1,35 @@
+/* cpu_features.h -- runtime detection of x86 SIMD extensions
+ * For conditions of distribution and use, see copyright notice in zlib.h
+ */
+
+#ifndef CPU_FEATURES_H
+#define CPU_FEATURES_H
+
+#include "zutil.h"
+
+#if !defined(ZLIB_NO_SIMD) && \
+    (defined(__x86_64__) || defined(_M_X64) || \
+     defined(__i386__) || defined(_M_IX86))
+#  define ZLIB_X86_SIMD
+#endif
+
+#ifdef ZLIB_X86_SIMD
+
+/* GCC and clang only emit SSE4.1/SSSE3/PCLMULQDQ instructions in functions
+   that ask for them, which keeps the rest of zlib runnable on any x86 CPU.
+   MSVC accepts the intrinsics anywhere. */
+#  if defined(__GNUC__) || defined(__clang__)
+#    define ZLIB_TARGET(features) __attribute__((target(features)))
+#  else
+#    define ZLIB_TARGET(features)
+#  endif
+
+/* Set by cpu_check_features(), zero until it has run. */
+extern int ZLIB_INTERNAL x86_cpu_enable_crc32_simd;
+extern int ZLIB_INTERNAL x86_cpu_enable_adler32_simd;
+
+void ZLIB_INTERNAL cpu_check_features OF((void));
+
+#endif /* ZLIB_X86_SIMD */
+
+#endif /* CPU_FEATURES_H */
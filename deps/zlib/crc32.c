@@ -29,6 +29,7 @@
 #endif /* MAKECRCH */
 
 #include "zutil.h"      /* for STDC and FAR definitions */
+#include "crc32_simd.h"
 
 #define local static
 
@@ -208,6 +209,20 @@ unsigned long ZEXPORT crc32(crc, buf, len)
 {
     if (buf == Z_NULL) return 0UL;
 
+#ifdef ZLIB_X86_SIMD
+    if (len >= Z_CRC32_SIMD_MIN_LEN) {
+        cpu_check_features();
+        if (x86_cpu_enable_crc32_simd) {
+            uInt chunk = len & ~(uInt)Z_CRC32_SIMD_CHUNK_MASK;
+            crc = crc32_simd_(buf, chunk, (unsigned)crc ^ 0xffffffffU) ^
+                  0xffffffffUL;
+            buf += chunk;
+            len -= chunk;
+            if (len == 0) return crc;
+        }
+    }
+#endif /* ZLIB_X86_SIMD */
+
 #ifdef DYNAMIC_CRC_TABLE
     if (crc_table_empty)
         make_crc_table();
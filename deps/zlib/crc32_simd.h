@@ -0,0 +1,22 @@
+/* crc32_simd.h -- CRC-32 using carry-less multiplication
+ * For conditions of distribution and use, see copyright notice in zlib.h
+ */
+
+#ifndef CRC32_SIMD_H
+#define CRC32_SIMD_H
+
+#include "cpu_features.h"
+
+#ifdef ZLIB_X86_SIMD
+
+/* crc32_simd_() takes and returns the CRC register, i.e. the bit-inverted
+   CRC.  `len` must be a multiple of 16 and at least Z_CRC32_SIMD_MIN_LEN. */
+#  define Z_CRC32_SIMD_MIN_LEN 64
+#  define Z_CRC32_SIMD_CHUNK_MASK 15
+
+unsigned ZLIB_INTERNAL crc32_simd_ OF((const unsigned char FAR *buf,
+                                       uInt len, unsigned crc));
+
+#endif /* ZLIB_X86_SIMD */
+
+#endif /* CRC32_SIMD_H */
@@ -14,9 +14,15 @@
           'type': 'static_library',
           'sources': [
             'adler32.c',
+            'adler32_simd.c',
+            'adler32_simd.h',
             'compress.c',
+            'cpu_features.c',
+            'cpu_features.h',
             'crc32.c',
             'crc32.h',
+            'crc32_simd.c',
+            'crc32_simd.h',
             'deflate.c',
             'deflate.h',
             'gzclose.c',
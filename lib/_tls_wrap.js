@@ -17,6 +17,9 @@ const tls_wrap = process.binding('tls_wrap');
 const TCP = process.binding('tcp_wrap').TCP;
 const Pipe = process.binding('pipe_wrap').Pipe;
 
+// Tickets that outlive a year of rotation are not a policy anyone wants.
+const kMaxTicketKeyRotation = 365 * 24 * 60 * 60;
+
 function onhandshakestart() {
   debug('onhandshakestart');
 
@@ -87,6 +90,18 @@ function loadSNI(self, servername, cb) {
   if (!servername || !self._SNICallback)
     return cb(null);
 
+  // Contexts that SNICallback returned recently, least recently used first.
+  const cache = self.server && self.server._SNICache;
+  if (cache) {
+    const context = cache.get(servername);
+    if (context !== undefined) {
+      cache.delete(servername);
+      cache.set(servername, context);
+      self._handle.sni_context = context;
+      return cb(null, context);
+    }
+  }
+
   var once = false;
   self._SNICallback(servername, function(err, context) {
     if (once)
@@ -100,8 +115,14 @@ function loadSNI(self, servername, cb) {
       return cb(new Error('Socket is closed'));
 
     // TODO(indutny): eventually disallow raw `SecureContext`
-    if (context)
+    if (context) {
       self._handle.sni_context = context.context || context;
+      if (cache) {
+        cache.set(servername, self._handle.sni_context);
+        if (cache.size > self.server.SNICacheSize)
+          cache.delete(cache.keys().next().value);
+      }
+    }
 
     cb(null, self._handle.sni_context);
   });
@@ -745,6 +766,40 @@ TLSSocket.prototype.getProtocol = function() {
 //   "PATH_LENGTH_EXCEEDED", "INVALID_PURPOSE" "CERT_UNTRUSTED",
 //   "CERT_REJECTED"
 //
+// Cluster workers share a session cache when the master set
+// cluster.settings.tlsSessionCache.  A session may only be resumed by a
+// server that would have accepted the full handshake the same way, so the
+// cache entries are scoped to the settings that decide that.
+function sharedSessionCacheScope(server) {
+  const hash = crypto.createHash('sha256');
+  function update(value) {
+    if (Array.isArray(value)) {
+      hash.update(`[${value.length}`);
+      value.forEach(update);
+    } else if (value === undefined || value === null) {
+      hash.update('-');
+    } else {
+      const data = Buffer.isBuffer(value) ? value : Buffer.from('' + value);
+      hash.update(`${data.length}:`);
+      hash.update(data);
+    }
+  }
+  update(server.sessionIdContext);
+  update(server.requestCert ? 1 : 0);
+  update(server.rejectUnauthorized ? 1 : 0);
+  update(server.ca);
+  update(server.crl);
+  // Sessions carry no trace of the certificate they were established with,
+  // so servers with different credentials must not resume each other's.
+  update(server._sharedCreds.context.getCredentialFingerprint());
+  update(server._contexts.length);
+  server._contexts.forEach(function(elem) {
+    update(elem[0].source);
+    update(elem[1].getCredentialFingerprint());
+  });
+  return hash.digest();
+}
+
 function Server(options, listener) {
   if (!(this instanceof Server))
     return new Server(options, listener);
@@ -793,10 +848,45 @@ function Server(options, listener) {
     sharedCreds.context.setSessionTimeout(self.sessionTimeout);
   }
 
+  this._SNICache = null;
+  if (self.SNICacheSize) {
+    if (typeof self.SNICacheSize !== 'number' || self.SNICacheSize < 0)
+      throw new TypeError('SNICacheSize must be a positive number');
+    this._SNICache = new Map();
+  }
+
   if (self.ticketKeys) {
     sharedCreds.context.setTicketKeys(self.ticketKeys);
   }
 
+  if (self.ticketKeyRotation) {
+    const rotation = self.ticketKeyRotation;
+    const previous = self.ticketKeyPrevious;
+    if (typeof rotation !== 'number' || rotation <= 0 ||
+        rotation !== (rotation >>> 0)) {
+      throw new TypeError('ticketKeyRotation must be a positive integer');
+    }
+    if (rotation > kMaxTicketKeyRotation) {
+      throw new RangeError('ticketKeyRotation must be at most ' +
+                           kMaxTicketKeyRotation + ' seconds');
+    }
+    if (typeof previous !== 'number' || previous < 0 || previous > 15 ||
+        previous !== (previous | 0)) {
+      throw new RangeError('ticketKeyPrevious must be an integer ' +
+                           'between 0 and 15');
+    }
+    sharedCreds.context.enableTicketKeyRotation(rotation, previous);
+  }
+
+  // The contexts that an SNICallback hands out can't be known in advance,
+  // so such servers keep their sessions to themselves.
+  this._sharedSessionCache = !options.SNICallback &&
+      process.binding('crypto').isSessionCacheOpen();
+  if (this._sharedSessionCache) {
+    sharedCreds.context.enableSharedSessionCache(
+        sharedSessionCacheScope(self));
+  }
+
   // constructor call
   net.Server.call(this, function(raw_socket) {
     var socket = new TLSSocket(raw_socket, {
@@ -910,7 +1000,14 @@ Server.prototype.setOptions = function(options) {
     this.ecdhCurve = options.ecdhCurve;
   if (options.dhparam) this.dhparam = options.dhparam;
   if (options.sessionTimeout) this.sessionTimeout = options.sessionTimeout;
+  if (options.SNICacheSize) this.SNICacheSize = options.SNICacheSize;
   if (options.ticketKeys) this.ticketKeys = options.ticketKeys;
+  if (options.ticketKeyRotation)
+    this.ticketKeyRotation = options.ticketKeyRotation;
+  if (options.ticketKeyPrevious !== undefined)
+    this.ticketKeyPrevious = options.ticketKeyPrevious;
+  else if (this.ticketKeyPrevious === undefined)
+    this.ticketKeyPrevious = 1;
   var secureOptions = options.secureOptions || 0;
   if (options.honorCipherOrder !== undefined)
     this.honorCipherOrder = !!options.honorCipherOrder;
@@ -941,6 +1038,12 @@ Server.prototype.addContext = function(servername, context) {
                                 .replace(/\*/g, '[^.]*') +
                       '$');
   this._contexts.push([re, tls.createSecureContext(context).context]);
+  if (this._SNICache)
+    this._SNICache.clear();
+  if (this._sharedSessionCache) {
+    this._sharedCreds.context.enableSharedSessionCache(
+        sharedSessionCacheScope(this));
+  }
 };
 
 function SNICallback(servername, callback) {
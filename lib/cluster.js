@@ -295,14 +295,49 @@ function masterInit() {
 
   var debugPortOffset = 1;
 
+  // The TLS session cache that workers share. It is created when the first
+  // worker that needs it is forked and lives until the master exits, its
+  // size can't be changed later on.  The file is unlinked right away, the
+  // workers inherit the descriptor.
+  var tlsSessionCacheFd = -1;
+
+  function tlsSessionCache(entries) {
+    if (tlsSessionCacheFd !== -1)
+      return tlsSessionCacheFd;
+
+    const fs = require('fs');
+    const path = require('path');
+    const crypto = require('crypto');
+    // Prefer memory backed storage, the cache holds session secrets.
+    const dir = fs.existsSync('/dev/shm') ? '/dev/shm' : require('os').tmpdir();
+    const name = `node-tls-sessions-${process.pid}-` +
+                 crypto.randomBytes(16).toString('hex');
+    tlsSessionCacheFd = process.binding('crypto').createSessionCache(
+        path.join(dir, name), entries >>> 0);
+    return tlsSessionCacheFd;
+  }
+
   function createWorkerProcess(id, env) {
     var workerEnv = util._extend({}, process.env);
     var execArgv = cluster.settings.execArgv.slice();
+    var stdio = cluster.settings.stdio;
     var debugPort = 0;
 
     workerEnv = util._extend(workerEnv, env);
     workerEnv.NODE_UNIQUE_ID = '' + id;
 
+    if (cluster.settings.tlsSessionCache > 0) {
+      const fd = tlsSessionCache(cluster.settings.tlsSessionCache);
+      // Hand the descriptor over as an extra stdio entry, the worker learns
+      // where it ended up from the environment.
+      if (!Array.isArray(stdio)) {
+        stdio = cluster.settings.silent ? ['pipe', 'pipe', 'pipe', 'ipc'] :
+                                          [0, 1, 2, 'ipc'];
+      }
+      workerEnv.NODE_TLS_SESSION_CACHE = '' + stdio.length;
+      stdio = stdio.concat(fd);
+    }
+
     for (var i = 0; i < execArgv.length; i++) {
       var match = execArgv[i].match(
         /^(--inspect|--debug|--debug-(brk|port))(=\d+)?$/
@@ -322,9 +357,10 @@ function masterInit() {
       env: workerEnv,
       silent: cluster.settings.silent,
       execArgv: execArgv,
-      stdio: cluster.settings.stdio,
+      stdio: stdio,
       gid: cluster.settings.gid,
-      uid: cluster.settings.uid
+      uid: cluster.settings.uid,
+      serialization: cluster.settings.serialization
     });
   }
 
@@ -544,6 +580,19 @@ function workerInit() {
 
   // Called from src/node.js
   cluster._setupWorker = function() {
+    if (process.env.NODE_TLS_SESSION_CACHE !== undefined) {
+      const fd = +process.env.NODE_TLS_SESSION_CACHE;
+      delete process.env.NODE_TLS_SESSION_CACHE;
+      try {
+        if (!(fd > 2 && fd === (fd | 0)))
+          throw new Error(`Invalid descriptor: ${fd}`);
+        process.binding('crypto').openSessionCache(fd);
+      } catch (err) {
+        process.emitWarning(
+            `Shared TLS session cache unavailable: ${err.message}`);
+      }
+    }
+
     var worker = new Worker({
       id: +process.env.NODE_UNIQUE_ID | 0,
       process: process,
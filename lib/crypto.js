@@ -10,7 +10,6 @@ exports.DEFAULT_ENCODING = 'buffer';
 
 const constants = process.binding('constants').crypto;
 const binding = process.binding('crypto');
-const randomBytes = binding.randomBytes;
 const getCiphers = binding.getCiphers;
 const getHashes = binding.getHashes;
 const getCurves = binding.getCurves;
@@ -69,16 +68,37 @@ Hash.prototype._flush = function _flush(callback) {
   callback();
 };
 
-Hash.prototype.update = function update(data, encoding) {
+Hash.prototype.update = function update(data, encoding, callback) {
+  if (typeof encoding === 'function') {
+    callback = encoding;
+    encoding = undefined;
+  }
   encoding = encoding || exports.DEFAULT_ENCODING;
-  this._handle.update(data, encoding);
+  if (typeof callback === 'function')
+    this._handle.updateAsync(toBuf(data, encoding), callback);
+  else
+    this._handle.update(data, encoding);
   return this;
 };
 
 
-Hash.prototype.digest = function digest(outputEncoding) {
+Hash.prototype.digest = function digest(outputEncoding, options) {
+  if (outputEncoding !== null && typeof outputEncoding === 'object') {
+    options = outputEncoding;
+    outputEncoding = undefined;
+  }
   outputEncoding = outputEncoding || exports.DEFAULT_ENCODING;
-  return this._handle.digest(outputEncoding);
+  // With `reset`, the object can be used again for the next message.
+  const reset = options != null && options.reset === true;
+  return this._handle.digest(outputEncoding, reset);
+};
+
+
+Hash.prototype.copy = function copy(options) {
+  const hash = Object.create(Hash.prototype);
+  hash._handle = this._handle.copy();
+  LazyTransform.call(hash, options);
+  return hash;
 };
 
 
@@ -99,6 +119,82 @@ Hmac.prototype.digest = Hash.prototype.digest;
 Hmac.prototype._flush = Hash.prototype._flush;
 Hmac.prototype._transform = Hash.prototype._transform;
 
+Hmac.prototype.copy = function copy(options) {
+  const hmac = Object.create(Hmac.prototype);
+  hmac._handle = this._handle.copy();
+  LazyTransform.call(hmac, options);
+  return hmac;
+};
+
+
+exports.hash = function hash(algorithm, data, outputEncoding, callback) {
+  return oneShotHash(algorithm, undefined, data, outputEncoding, callback);
+};
+
+
+exports.hmac = function hmac(algorithm, key, data, outputEncoding, callback) {
+  return oneShotHash(algorithm, toBuf(key), data, outputEncoding, callback);
+};
+
+
+function oneShotHash(algorithm, key, data, outputEncoding, callback) {
+  if (typeof outputEncoding === 'function') {
+    callback = outputEncoding;
+    outputEncoding = undefined;
+  }
+  outputEncoding = outputEncoding || exports.DEFAULT_ENCODING;
+
+  if (callback === undefined)
+    return binding.hash(algorithm, key, data, outputEncoding);
+
+  if (typeof callback !== 'function')
+    throw new TypeError('"callback" argument must be a function');
+  binding.hash(algorithm, key, toBuf(data), outputEncoding, callback);
+}
+
+
+exports.hashMany = function hashMany(algorithm, data, offsets, outputEncoding,
+                                     callback) {
+  return digestMany(algorithm, undefined, data, offsets, outputEncoding,
+                    callback);
+};
+
+
+exports.hmacMany = function hmacMany(algorithm, key, data, offsets,
+                                     outputEncoding, callback) {
+  return digestMany(algorithm, toBuf(key), data, offsets, outputEncoding,
+                    callback);
+};
+
+
+function digestMany(algorithm, key, data, offsets, outputEncoding, callback) {
+  if (Array.isArray(data)) {
+    callback = outputEncoding;
+    outputEncoding = offsets;
+    offsets = undefined;
+  } else if (!(offsets instanceof Uint32Array)) {
+    if (!Array.isArray(offsets))
+      throw new TypeError('"offsets" argument must be an array');
+    offsets = Uint32Array.from(offsets);
+  }
+  if (typeof outputEncoding === 'function') {
+    callback = outputEncoding;
+    outputEncoding = undefined;
+  }
+  outputEncoding = outputEncoding || exports.DEFAULT_ENCODING;
+
+  if (callback === undefined)
+    return binding.hashMany(algorithm, key, data, offsets, outputEncoding);
+
+  if (typeof callback !== 'function')
+    throw new TypeError('"callback" argument must be a function');
+  // Strings are converted up front, and the copy of the array keeps the
+  // buffers alive until the digests are done.
+  if (Array.isArray(data))
+    data = data.map((message) => toBuf(message));
+  binding.hashMany(algorithm, key, data, offsets, outputEncoding, callback);
+}
+
 
 function getDecoder(decoder, encoding) {
   encoding = internalUtil.normalizeEncoding(encoding);
@@ -152,7 +248,17 @@ Cipher.prototype.update = function update(data, inputEncoding, outputEncoding) {
 };
 
 
-Cipher.prototype.final = function final(outputEncoding) {
+Cipher.prototype.updateInto = function updateInto(data, output, offset) {
+  return this._handle.updateInto(data, output, outputOffset(output, offset));
+};
+
+
+Cipher.prototype.final = function final(outputEncoding, offset) {
+  if (Buffer.isBuffer(outputEncoding)) {
+    const output = outputEncoding;
+    return this._handle.finalInto(output, outputOffset(output, offset));
+  }
+
   outputEncoding = outputEncoding || exports.DEFAULT_ENCODING;
   var ret = this._handle.final();
 
@@ -165,6 +271,17 @@ Cipher.prototype.final = function final(outputEncoding) {
 };
 
 
+function outputOffset(output, offset) {
+  if (offset === undefined)
+    return 0;
+  if (!Number.isInteger(offset) || offset < 0 ||
+      (output instanceof Uint8Array && offset > output.length)) {
+    throw new RangeError('"offset" is out of bounds');
+  }
+  return offset;
+}
+
+
 Cipher.prototype.setAutoPadding = function setAutoPadding(ap) {
   this._handle.setAutoPadding(ap);
   return this;
@@ -201,6 +318,7 @@ util.inherits(Cipheriv, LazyTransform);
 Cipheriv.prototype._transform = Cipher.prototype._transform;
 Cipheriv.prototype._flush = Cipher.prototype._flush;
 Cipheriv.prototype.update = Cipher.prototype.update;
+Cipheriv.prototype.updateInto = Cipher.prototype.updateInto;
 Cipheriv.prototype.final = Cipher.prototype.final;
 Cipheriv.prototype.setAutoPadding = Cipher.prototype.setAutoPadding;
 Cipheriv.prototype.getAuthTag = Cipher.prototype.getAuthTag;
@@ -224,6 +342,7 @@ util.inherits(Decipher, LazyTransform);
 Decipher.prototype._transform = Cipher.prototype._transform;
 Decipher.prototype._flush = Cipher.prototype._flush;
 Decipher.prototype.update = Cipher.prototype.update;
+Decipher.prototype.updateInto = Cipher.prototype.updateInto;
 Decipher.prototype.final = Cipher.prototype.final;
 Decipher.prototype.finaltol = Cipher.prototype.final;
 Decipher.prototype.setAutoPadding = Cipher.prototype.setAutoPadding;
@@ -249,6 +368,7 @@ util.inherits(Decipheriv, LazyTransform);
 Decipheriv.prototype._transform = Cipher.prototype._transform;
 Decipheriv.prototype._flush = Cipher.prototype._flush;
 Decipheriv.prototype.update = Cipher.prototype.update;
+Decipheriv.prototype.updateInto = Cipher.prototype.updateInto;
 Decipheriv.prototype.final = Cipher.prototype.final;
 Decipheriv.prototype.finaltol = Cipher.prototype.final;
 Decipheriv.prototype.setAutoPadding = Cipher.prototype.setAutoPadding;
@@ -274,17 +394,39 @@ Sign.prototype._write = function _write(chunk, encoding, callback) {
   callback();
 };
 
-Sign.prototype.update = Hash.prototype.update;
+Sign.prototype.update = function update(data, encoding) {
+  encoding = encoding || exports.DEFAULT_ENCODING;
+  this._handle.update(data, encoding);
+  return this;
+};
 
-Sign.prototype.sign = function sign(options, encoding) {
+Sign.prototype.sign = function sign(options, encoding, callback) {
+  if (typeof encoding === 'function') {
+    callback = encoding;
+    encoding = undefined;
+  }
   if (!options)
     throw new Error('No key provided to sign');
 
   var key = options.key || options;
   var passphrase = options.passphrase || null;
+  encoding = encoding || exports.DEFAULT_ENCODING;
+
+  if (callback !== undefined) {
+    if (typeof callback !== 'function')
+      throw new TypeError('"callback" argument must be a function');
+    this._handle.sign(toBuf(key), null, passphrase, function(err, ret) {
+      if (err)
+        return callback(err);
+      if (encoding && encoding !== 'buffer')
+        ret = ret.toString(encoding);
+      callback(null, ret);
+    });
+    return;
+  }
+
   var ret = this._handle.sign(toBuf(key), null, passphrase);
 
-  encoding = encoding || exports.DEFAULT_ENCODING;
   if (encoding && encoding !== 'buffer')
     ret = ret.toString(encoding);
 
@@ -308,26 +450,44 @@ util.inherits(Verify, stream.Writable);
 Verify.prototype._write = Sign.prototype._write;
 Verify.prototype.update = Sign.prototype.update;
 
-Verify.prototype.verify = function verify(object, signature, sigEncoding) {
+Verify.prototype.verify = function verify(object, signature, sigEncoding,
+                                           callback) {
+  if (typeof sigEncoding === 'function') {
+    callback = sigEncoding;
+    sigEncoding = undefined;
+  }
   sigEncoding = sigEncoding || exports.DEFAULT_ENCODING;
+
+  if (callback !== undefined) {
+    if (typeof callback !== 'function')
+      throw new TypeError('"callback" argument must be a function');
+    this._handle.verify(toBuf(object), toBuf(signature, sigEncoding), null,
+                        callback);
+    return;
+  }
+
   return this._handle.verify(toBuf(object), toBuf(signature, sigEncoding));
 };
 
 function rsaPublic(method, defaultPadding) {
-  return function(options, buffer) {
+  return function(options, buffer, callback) {
     var key = options.key || options;
     var padding = options.padding || defaultPadding;
     var passphrase = options.passphrase || null;
-    return method(toBuf(key), buffer, padding, passphrase);
+    if (callback !== undefined && typeof callback !== 'function')
+      throw new TypeError('"callback" argument must be a function');
+    return method(toBuf(key), buffer, padding, passphrase, callback);
   };
 }
 
 function rsaPrivate(method, defaultPadding) {
-  return function(options, buffer) {
+  return function(options, buffer, callback) {
     var key = options.key || options;
     var passphrase = options.passphrase || null;
     var padding = options.padding || defaultPadding;
-    return method(toBuf(key), buffer, padding, passphrase);
+    if (callback !== undefined && typeof callback !== 'function')
+      throw new TypeError('"callback" argument must be a function');
+    return method(toBuf(key), buffer, padding, passphrase, callback);
   };
 }
 
@@ -381,6 +541,39 @@ function DiffieHellman(sizeOrKey, keyEncoding, generator, genEncoding) {
 }
 
 
+exports.generateDiffieHellman = function generateDiffieHellman(primeLength,
+                                                               generator,
+                                                               callback) {
+  if (typeof generator === 'function') {
+    callback = generator;
+    generator = undefined;
+  }
+  if (typeof callback !== 'function')
+    throw new TypeError('"callback" argument must be a function');
+  if (primeLength !== (primeLength | 0) || primeLength <= 0)
+    throw new TypeError('"primeLength" argument must be a positive integer');
+  if (generator === undefined)
+    generator = DH_GENERATOR;
+  else if (generator !== (generator | 0) || generator <= 0)
+    throw new TypeError('"generator" argument must be a positive integer');
+
+  binding.generateDHParams(primeLength, generator, onparams);
+
+  function onparams(err, prime, generator, verifyError) {
+    if (err)
+      return callback(err);
+    const dh = Object.create(DiffieHellman.prototype);
+    dh._handle = new binding.DiffieHellman(prime, generator, verifyError);
+    Object.defineProperty(dh, 'verifyError', {
+      enumerable: true,
+      value: verifyError,
+      writable: false
+    });
+    callback(null, dh);
+  }
+};
+
+
 exports.DiffieHellmanGroup =
     exports.createDiffieHellmanGroup =
     exports.getDiffieHellman = DiffieHellmanGroup;
@@ -401,9 +594,25 @@ DiffieHellmanGroup.prototype.generateKeys =
     DiffieHellman.prototype.generateKeys =
     dhGenerateKeys;
 
-function dhGenerateKeys(encoding) {
-  var keys = this._handle.generateKeys();
+function dhGenerateKeys(encoding, callback) {
+  if (typeof encoding === 'function') {
+    callback = encoding;
+    encoding = undefined;
+  }
   encoding = encoding || exports.DEFAULT_ENCODING;
+
+  if (typeof callback === 'function') {
+    this._handle.generateKeys((err, keys) => {
+      if (err)
+        return callback(err);
+      if (encoding && encoding !== 'buffer')
+        keys = keys.toString(encoding);
+      callback(null, keys);
+    });
+    return;
+  }
+
+  var keys = this._handle.generateKeys();
   if (encoding && encoding !== 'buffer')
     keys = keys.toString(encoding);
   return keys;
@@ -506,7 +715,31 @@ ECDH.prototype.setPrivateKey = DiffieHellman.prototype.setPrivateKey;
 ECDH.prototype.setPublicKey = DiffieHellman.prototype.setPublicKey;
 ECDH.prototype.getPrivateKey = DiffieHellman.prototype.getPrivateKey;
 
-ECDH.prototype.generateKeys = function generateKeys(encoding, format) {
+ECDH.prototype.generateKeys = function generateKeys(encoding, format,
+                                                    callback) {
+  if (typeof encoding === 'function') {
+    callback = encoding;
+    encoding = undefined;
+  } else if (typeof format === 'function') {
+    callback = format;
+    format = undefined;
+  }
+
+  if (typeof callback === 'function') {
+    this._handle.generateKeys((err) => {
+      if (err)
+        return callback(err);
+      var key;
+      try {
+        key = this.getPublicKey(encoding, format);
+      } catch (err) {
+        return callback(err);
+      }
+      callback(null, key);
+    });
+    return;
+  }
+
   this._handle.generateKeys();
 
   return this.getPublicKey(encoding, format);
@@ -537,6 +770,90 @@ ECDH.prototype.getPublicKey = function getPublicKey(encoding, format) {
 };
 
 
+exports.generateKeyPair = function generateKeyPair(type, options, callback) {
+  if (typeof callback !== 'function')
+    throw new TypeError('"callback" argument must be a function');
+  const args = keyPairArgs(type, options);
+  args.push(callback);
+  binding.generateKeyPair.apply(binding, args);
+};
+
+
+exports.generateKeyPairSync = function generateKeyPairSync(type, options) {
+  const keys = binding.generateKeyPair.apply(binding,
+                                             keyPairArgs(type, options));
+  return { publicKey: keys[0], privateKey: keys[1] };
+};
+
+
+function keyPairArgs(type, options) {
+  if (options === null || typeof options !== 'object')
+    throw new TypeError('"options" argument must be an object');
+
+  var size;
+  var exponent = 0;
+  if (type === 'rsa') {
+    size = options.modulusLength;
+    if (size !== (size | 0) || size <= 0)
+      throw new TypeError('"modulusLength" must be a positive integer');
+    exponent = options.publicExponent;
+    if (exponent === undefined)
+      exponent = 0x10001;
+    else if (!Number.isInteger(exponent) || exponent <= 0 ||
+             exponent > 0xffffffff)
+      throw new TypeError('"publicExponent" must be a positive integer');
+  } else if (type === 'ec') {
+    size = options.namedCurve;
+    if (typeof size !== 'string')
+      throw new TypeError('"namedCurve" must be a string');
+  } else {
+    throw new TypeError('"type" argument must be \'rsa\' or \'ec\'');
+  }
+
+  const pub = keyEncoding(options.publicKeyEncoding, 'publicKeyEncoding',
+                          type === 'rsa' ? ['spki', 'pkcs1'] : ['spki']);
+  const priv = keyEncoding(options.privateKeyEncoding, 'privateKeyEncoding',
+                           ['pkcs8', type === 'rsa' ? 'pkcs1' : 'sec1']);
+
+  var cipher;
+  var passphrase;
+  if (options.privateKeyEncoding != null) {
+    cipher = options.privateKeyEncoding.cipher;
+    passphrase = options.privateKeyEncoding.passphrase;
+  }
+  if (cipher !== undefined) {
+    if (typeof cipher !== 'string')
+      throw new TypeError('"cipher" must be a string');
+    if (typeof passphrase !== 'string' && !(passphrase instanceof Buffer))
+      throw new TypeError('"passphrase" must be a string or Buffer');
+    if (!priv.pem && priv.type !== 'pkcs8') {
+      throw new TypeError(
+          'Only PKCS#8 private keys can be encrypted in DER format');
+    }
+    passphrase = toBuf(passphrase);
+  }
+
+  return [type, size, exponent, pub.type, pub.pem, priv.type, priv.pem,
+          cipher, passphrase];
+}
+
+
+function keyEncoding(encoding, name, types) {
+  if (encoding == null)
+    return { type: types[0], pem: true };
+  if (typeof encoding !== 'object')
+    throw new TypeError(`"${name}" must be an object`);
+
+  const type = encoding.type === undefined ? types[0] : encoding.type;
+  if (types.indexOf(type) === -1)
+    throw new TypeError(`"${name}.type" must be one of: ${types.join(', ')}`);
+  const format = encoding.format === undefined ? 'pem' : encoding.format;
+  if (format !== 'pem' && format !== 'der')
+    throw new TypeError(`"${name}.format" must be 'pem' or 'der'`);
+  return { type, pem: format === 'pem' };
+}
+
+
 const pbkdf2DeprecationWarning =
     internalUtil.deprecate(() => {}, 'crypto.pbkdf2 without specifying' +
       ' a digest is deprecated. Please specify a digest');
@@ -633,8 +950,61 @@ exports.setEngine = function setEngine(id, flags) {
   return binding.setEngine(id, flags);
 };
 
+function randomBytes(size, callback) {
+  if (typeof callback !== 'function')
+    return binding.randomBytes(size);
+  // Small requests are served from a pool right away, the callback is still
+  // called asynchronously.
+  const buf = binding.randomBytes(size, callback);
+  if (buf !== undefined)
+    process.nextTick(callback, null, buf);
+}
+
+
 exports.randomBytes = exports.pseudoRandomBytes = randomBytes;
 
+
+exports.randomFillSync = function randomFillSync(buf, offset, size) {
+  offset = outputOffset(checkFillBuffer(buf), offset);
+  size = fillSize(buf, offset, size);
+  binding.randomFill(buf, offset, size);
+  return buf;
+};
+
+
+exports.randomFill = function randomFill(buf, offset, size, callback) {
+  if (typeof offset === 'function') {
+    callback = offset;
+    offset = undefined;
+  } else if (typeof size === 'function') {
+    callback = size;
+    size = undefined;
+  }
+  if (typeof callback !== 'function')
+    throw new TypeError('"callback" argument must be a function');
+
+  offset = outputOffset(checkFillBuffer(buf), offset);
+  size = fillSize(buf, offset, size);
+  if (binding.randomFill(buf, offset, size, (err) => callback(err, buf)))
+    process.nextTick(callback, null, buf);
+};
+
+
+function checkFillBuffer(buf) {
+  if (!(buf instanceof Uint8Array))
+    throw new TypeError('"buf" argument must be a Buffer or Uint8Array');
+  return buf;
+}
+
+
+function fillSize(buf, offset, size) {
+  if (size === undefined)
+    return buf.length - offset;
+  if (!Number.isInteger(size) || size < 0 || size > buf.length - offset)
+    throw new RangeError('"size" is out of bounds');
+  return size;
+}
+
 exports.rng = exports.prng = randomBytes;
 
 exports.getCiphers = internalUtil.cachedResult(() => {
@@ -30,7 +30,6 @@ const Readable = Stream.Readable;
 const Writable = Stream.Writable;
 
 const kMinPoolSpace = 128;
-const kMaxLength = require('buffer').kMaxLength;
 
 const isWindows = process.platform === 'win32';
 
@@ -196,6 +195,60 @@ fs.Stats.prototype.isSocket = function() {
   return this._checkModeProperty(constants.S_IFSOCK);
 };
 
+// A directory entry as returned by readdir() with the withFileTypes option.
+const kType = Symbol('type');
+
+fs.Dirent = function(name, type) {
+  this.name = name;
+  this[kType] = type;
+};
+
+fs.Dirent.prototype.isDirectory = function() {
+  return this[kType] === constants.UV_DIRENT_DIR;
+};
+
+fs.Dirent.prototype.isFile = function() {
+  return this[kType] === constants.UV_DIRENT_FILE;
+};
+
+fs.Dirent.prototype.isBlockDevice = function() {
+  return this[kType] === constants.UV_DIRENT_BLOCK;
+};
+
+fs.Dirent.prototype.isCharacterDevice = function() {
+  return this[kType] === constants.UV_DIRENT_CHAR;
+};
+
+fs.Dirent.prototype.isSymbolicLink = function() {
+  return this[kType] === constants.UV_DIRENT_LINK;
+};
+
+fs.Dirent.prototype.isFIFO = function() {
+  return this[kType] === constants.UV_DIRENT_FIFO;
+};
+
+fs.Dirent.prototype.isSocket = function() {
+  return this[kType] === constants.UV_DIRENT_SOCKET;
+};
+
+function direntTypeFromStats(stats) {
+  if (stats.isFile())
+    return constants.UV_DIRENT_FILE;
+  if (stats.isDirectory())
+    return constants.UV_DIRENT_DIR;
+  if (stats.isSymbolicLink())
+    return constants.UV_DIRENT_LINK;
+  if (stats.isFIFO())
+    return constants.UV_DIRENT_FIFO;
+  if (stats.isSocket())
+    return constants.UV_DIRENT_SOCKET;
+  if (stats.isCharacterDevice())
+    return constants.UV_DIRENT_CHAR;
+  if (stats.isBlockDevice())
+    return constants.UV_DIRENT_BLOCK;
+  return constants.UV_DIRENT_UNKNOWN;
+}
+
 // Don't allow mode to accidentally be overwritten.
 ['F_OK', 'R_OK', 'W_OK', 'X_OK'].forEach(function(key) {
   Object.defineProperty(fs, key, {
@@ -251,6 +304,7 @@ fs.existsSync = function(path) {
   }
 };
 
+// Open, fstat, read and close all happen in a single threadpool request.
 fs.readFile = function(path, options, callback) {
   callback = maybeCallback(arguments[arguments.length - 1]);
   options = getOptions(options, { flag: 'r' });
@@ -258,160 +312,36 @@ fs.readFile = function(path, options, callback) {
   if (!nullCheck(path, callback))
     return;
 
-  var context = new ReadFileContext(callback, options.encoding);
-  context.isUserFd = isFd(path); // file descriptor ownership
-  var req = new FSReqWrap();
-  req.context = context;
-  req.oncomplete = readFileAfterOpen;
-
-  if (context.isUserFd) {
-    process.nextTick(function() {
-      req.oncomplete(null, path);
-    });
-    return;
-  }
-
-  binding.open(pathModule._makeLong(path),
-               stringToFlags(options.flag || 'r'),
-               0o666,
-               req);
-};
-
-const kReadFileBufferLength = 8 * 1024;
-
-function ReadFileContext(callback, encoding) {
-  this.fd = undefined;
-  this.isUserFd = undefined;
-  this.size = undefined;
-  this.callback = callback;
-  this.buffers = null;
-  this.buffer = null;
-  this.pos = 0;
-  this.encoding = encoding;
-  this.err = null;
-}
-
-ReadFileContext.prototype.read = function() {
-  var buffer;
-  var offset;
-  var length;
-
-  if (this.size === 0) {
-    buffer = this.buffer = Buffer.allocUnsafeSlow(kReadFileBufferLength);
-    offset = 0;
-    length = kReadFileBufferLength;
-  } else {
-    buffer = this.buffer;
-    offset = this.pos;
-    length = this.size - this.pos;
-  }
-
-  var req = new FSReqWrap();
-  req.oncomplete = readFileAfterRead;
-  req.context = this;
-
-  binding.read(this.fd, buffer, offset, length, -1, req);
-};
-
-ReadFileContext.prototype.close = function(err) {
+  const encoding = options.encoding;
   var req = new FSReqWrap();
-  req.oncomplete = readFileAfterClose;
-  req.context = this;
-  this.err = err;
+  req.oncomplete = readFileAfterComplete;
+  req.callback = callback;
+  req.encoding = encoding;
 
-  if (this.isUserFd) {
-    process.nextTick(function() {
-      req.oncomplete(null);
-    });
-    return;
-  }
+  if (!isFd(path))
+    path = pathModule._makeLong(path);
+  const flags = stringToFlags(options.flag || 'r');
 
-  binding.close(this.fd, req);
+  // utf8 is decoded straight from the native buffer, without a Buffer.
+  if (encoding === 'utf8' || encoding === 'utf-8')
+    binding.readFileUtf8(path, flags, req);
+  else
+    binding.readFile(path, flags, req);
 };
 
-function readFileAfterOpen(err, fd) {
-  var context = this.context;
-
-  if (err) {
-    context.callback(err);
-    return;
-  }
-
-  context.fd = fd;
-
-  var req = new FSReqWrap();
-  req.oncomplete = readFileAfterStat;
-  req.context = context;
-  binding.fstat(fd, req);
-}
-
-function readFileAfterStat(err, st) {
-  var context = this.context;
-
-  if (err)
-    return context.close(err);
-
-  var size = context.size = st.isFile() ? st.size : 0;
-
-  if (size === 0) {
-    context.buffers = [];
-    context.read();
-    return;
-  }
-
-  if (size > kMaxLength) {
-    err = new RangeError('File size is greater than possible Buffer: ' +
-                         `0x${kMaxLength.toString(16)} bytes`);
-    return context.close(err);
-  }
-
-  context.buffer = Buffer.allocUnsafeSlow(size);
-  context.read();
-}
-
-function readFileAfterRead(err, bytesRead) {
-  var context = this.context;
+function readFileAfterComplete(err, data) {
+  const callback = this.callback;
+  const encoding = this.encoding;
+  this.callback = null;
 
   if (err)
-    return context.close(err);
-
-  if (bytesRead === 0)
-    return context.close();
-
-  context.pos += bytesRead;
-
-  if (context.size !== 0) {
-    if (context.pos === context.size)
-      context.close();
-    else
-      context.read();
-  } else {
-    // unknown size, just read until we don't get bytes.
-    context.buffers.push(context.buffer.slice(0, bytesRead));
-    context.read();
-  }
-}
-
-function readFileAfterClose(err) {
-  var context = this.context;
-  var buffer = null;
-  var callback = context.callback;
-
-  if (context.err || err)
-    return callback(context.err || err);
-
-  if (context.size === 0)
-    buffer = Buffer.concat(context.buffers, context.pos);
-  else if (context.pos < context.size)
-    buffer = context.buffer.slice(0, context.pos);
-  else
-    buffer = context.buffer;
+    return callback(err);
 
-  if (context.encoding) {
-    return tryToString(buffer, context.encoding, callback);
-  }
+  // readFileUtf8() hands back a Buffer when the string would be too long.
+  if (encoding && typeof data !== 'string')
+    return tryToString(data, encoding, callback);
 
-  callback(null, buffer);
+  callback(null, data);
 }
 
 function tryToString(buf, encoding, callback) {
@@ -857,16 +787,97 @@ fs.readdir = function(path, options, callback) {
   callback = makeCallback(typeof options === 'function' ? options : callback);
   options = getOptions(options, {});
   if (!nullCheck(path, callback)) return;
+  const withFileTypes = !!options.withFileTypes;
   var req = new FSReqWrap();
-  req.oncomplete = callback;
-  binding.readdir(pathModule._makeLong(path), options.encoding, req);
+  if (withFileTypes) {
+    req.oncomplete = function(err, result) {
+      if (err)
+        return callback(err);
+      getDirents(path, result, callback);
+    };
+  } else {
+    req.oncomplete = callback;
+  }
+  binding.readdir(pathModule._makeLong(path),
+                  options.encoding,
+                  withFileTypes,
+                  req);
 };
 
 fs.readdirSync = function(path, options) {
   options = getOptions(options, {});
   nullCheck(path);
-  return binding.readdir(pathModule._makeLong(path), options.encoding);
-};
+  const withFileTypes = !!options.withFileTypes;
+  const result = binding.readdir(pathModule._makeLong(path),
+                                 options.encoding,
+                                 withFileTypes);
+  return withFileTypes ? getDirentsSync(path, result) : result;
+};
+
+// `result` is [names, types] from the binding.  The types come with the
+// directory listing, only entries of filesystems that don't report them
+// (UV_DIRENT_UNKNOWN) cost an extra lstat().
+function getDirents(path, result, callback) {
+  const names = result[0];
+  const types = result[1];
+  const dirents = new Array(names.length);
+  var pending = 1;
+  var failed = false;
+
+  for (var i = 0; i < names.length; i++) {
+    if (types[i] === constants.UV_DIRENT_UNKNOWN)
+      lstatDirent(i);
+    else
+      dirents[i] = new fs.Dirent(names[i], types[i]);
+  }
+  done(null);
+
+  function lstatDirent(i) {
+    pending++;
+    fs.lstat(joinDirentPath(path, names[i]), function(err, stats) {
+      if (!err)
+        dirents[i] = new fs.Dirent(names[i], direntTypeFromStats(stats));
+      done(err);
+    });
+  }
+
+  function done(err) {
+    if (failed)
+      return;
+    if (err) {
+      failed = true;
+      return callback(err);
+    }
+    if (--pending === 0)
+      callback(null, dirents);
+  }
+}
+
+function getDirentsSync(path, result) {
+  const names = result[0];
+  const types = result[1];
+  const dirents = new Array(names.length);
+
+  for (var i = 0; i < names.length; i++) {
+    var type = types[i];
+    if (type === constants.UV_DIRENT_UNKNOWN) {
+      const stats = fs.lstatSync(joinDirentPath(path, names[i]));
+      type = direntTypeFromStats(stats);
+    }
+    dirents[i] = new fs.Dirent(names[i], type);
+  }
+  return dirents;
+}
+
+function joinDirentPath(path, name) {
+  if (typeof path === 'string' && typeof name === 'string')
+    return pathModule.join(path, name);
+  return Buffer.concat([
+    Buffer.from(path),
+    Buffer.from(pathModule.sep),
+    Buffer.from(name)
+  ]);
+}
 
 fs.fstat = function(fd, callback) {
   var req = new FSReqWrap();
@@ -1153,62 +1164,32 @@ fs.futimesSync = function(fd, atime, mtime) {
   binding.futimes(fd, atime, mtime);
 };
 
-function writeAll(fd, isUserFd, buffer, offset, length, position, callback_) {
-  var callback = maybeCallback(arguments[arguments.length - 1]);
-
-  // write(fd, buffer, offset, length, position, callback)
-  fs.write(fd, buffer, offset, length, position, function(writeErr, written) {
-    if (writeErr) {
-      if (isUserFd) {
-        callback(writeErr);
-      } else {
-        fs.close(fd, function() {
-          callback(writeErr);
-        });
-      }
-    } else {
-      if (written === length) {
-        if (isUserFd) {
-          callback(null);
-        } else {
-          fs.close(fd, callback);
-        }
-      } else {
-        offset += written;
-        length -= written;
-        if (position !== null) {
-          position += written;
-        }
-        writeAll(fd, isUserFd, buffer, offset, length, position, callback);
-      }
-    }
-  });
-}
-
+// Open, the writes and close all happen in a single threadpool request.
 fs.writeFile = function(path, data, options, callback) {
   callback = maybeCallback(arguments[arguments.length - 1]);
   options = getOptions(options, { encoding: 'utf8', mode: 0o666, flag: 'w' });
   const flag = options.flag || 'w';
 
   if (isFd(path)) {
-    writeFd(path, true);
-    return;
+    writeFile(path);
+  } else if (nullCheck(path, callback)) {
+    writeFile(pathModule._makeLong(path));
   }
 
-  fs.open(path, flag, options.mode, function(openErr, fd) {
-    if (openErr) {
-      callback(openErr);
-    } else {
-      writeFd(fd, false);
-    }
-  });
-
-  function writeFd(fd, isUserFd) {
+  function writeFile(file) {
     var buffer = isUint8Array(data) ?
         data : Buffer.from('' + data, options.encoding || 'utf8');
     var position = /a/.test(flag) ? null : 0;
 
-    writeAll(fd, isUserFd, buffer, 0, buffer.length, position, callback);
+    var req = new FSReqWrap();
+    req.oncomplete = callback;
+    req.buffer = buffer;  // keep the data alive until the write is done
+    binding.writeFile(file,
+                      buffer,
+                      stringToFlags(flag),
+                      modeNum(options.mode, 0o666),
+                      position,
+                      req);
   }
 };
 
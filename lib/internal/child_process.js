@@ -1,6 +1,5 @@
 'use strict';
 
-const StringDecoder = require('string_decoder').StringDecoder;
 const Buffer = require('buffer').Buffer;
 const EventEmitter = require('events');
 const net = require('net');
@@ -17,6 +16,7 @@ const TTY = process.binding('tty_wrap').TTY;
 const TCP = process.binding('tcp_wrap').TCP;
 const UDP = process.binding('udp_wrap').UDP;
 const SocketList = require('internal/socket_list');
+const serialization = require('internal/child_process/serialization');
 
 const errnoException = util._errnoException;
 const SocketListSend = SocketList.SocketListSend;
@@ -270,6 +270,10 @@ ChildProcess.prototype.spawn = function(options) {
   var ipcFd;
   // If no `stdio` option was given - use default
   var stdio = options.stdio || 'pipe';
+  const serializationMode = options.serialization || 'json';
+
+  if (serializationMode !== 'json' && serializationMode !== 'advanced')
+    throw new TypeError('"serialization" must be "json" or "advanced"');
 
   stdio = _validateStdio(stdio, false);
 
@@ -281,6 +285,8 @@ ChildProcess.prototype.spawn = function(options) {
     // Let child process know about opened IPC channel
     options.envPairs = options.envPairs || [];
     options.envPairs.push('NODE_CHANNEL_FD=' + ipcFd);
+    options.envPairs.push('NODE_CHANNEL_SERIALIZATION_MODE=' +
+                          serializationMode);
   }
 
   this.spawnfile = options.file;
@@ -349,7 +355,7 @@ ChildProcess.prototype.spawn = function(options) {
   });
 
   // Add .send() method and start listening for IPC data
-  if (ipc !== undefined) setupChannel(this, ipc);
+  if (ipc !== undefined) setupChannel(this, ipc, serializationMode);
 
   return err;
 };
@@ -408,7 +414,7 @@ ChildProcess.prototype.unref = function() {
 };
 
 
-function setupChannel(target, channel) {
+function setupChannel(target, channel, serializationMode) {
   target.channel = channel;
 
   // _channel can be deprecated in version 8
@@ -440,20 +446,24 @@ function setupChannel(target, channel) {
     }
   }();
 
-  var decoder = new StringDecoder('utf8');
-  var jsonBuffer = '';
+  const format = serialization[serializationMode || 'json'];
+  const reader = new format.Reader();
   channel.buffering = false;
   channel.onread = function(nread, pool, recvHandle) {
     // TODO(bnoordhuis) Check that nread > 0.
     if (pool) {
-      jsonBuffer += decoder.write(pool);
-
-      var i, start = 0;
+      var messages;
+      try {
+        messages = reader.read(pool);
+      } catch (err) {
+        // Whatever follows can't be trusted either, give up on the channel.
+        closeChannel();
+        target.emit('error', err);
+        return;
+      }
 
-      //Linebreak is used as a message end sign
-      while ((i = jsonBuffer.indexOf('\n', start)) >= 0) {
-        var json = jsonBuffer.slice(start, i);
-        var message = JSON.parse(json);
+      for (var i = 0; i < messages.length; i++) {
+        const message = messages[i];
 
         // There will be at most one NODE_HANDLE message in every chunk we
         // read because SCM_RIGHTS messages don't get coalesced. Make sure
@@ -462,22 +472,23 @@ function setupChannel(target, channel) {
           handleMessage(target, message, recvHandle);
         else
           handleMessage(target, message, undefined);
-
-        start = i + 1;
       }
-      jsonBuffer = jsonBuffer.slice(start);
-      this.buffering = jsonBuffer.length !== 0;
+      this.buffering = reader.buffering;
 
     } else {
-      this.buffering = false;
-      target.disconnect();
-      channel.onread = nop;
-      channel.close();
-      target.channel = null;
-      maybeClose(target);
+      closeChannel();
     }
   };
 
+  function closeChannel() {
+    channel.buffering = false;
+    target.disconnect();
+    channel.onread = nop;
+    channel.close();
+    target.channel = null;
+    maybeClose(target);
+  }
+
   // object where socket lists will live
   channel.sockets = { got: {}, send: {} };
 
@@ -631,8 +642,7 @@ function setupChannel(target, channel) {
     var req = new WriteWrap();
     req.async = false;
 
-    var string = JSON.stringify(message) + '\n';
-    var err = channel.writeUtf8String(req, string, handle);
+    var err = format.write(channel, req, message, handle);
 
     if (err === 0) {
       if (handle) {
@@ -0,0 +1,465 @@
+'use strict';
+
+// Wire formats for the IPC channel set up by child_process.fork() and
+// cluster. Each format provides a Reader that turns the chunks handed to
+// channel.onread into messages, and a write() that puts one message on the
+// channel.
+//
+// 'json' is the historical format: one JSON document per line.
+//
+// 'advanced' frames every message with a 4 byte big-endian length and encodes
+// it with a structured clone algorithm, so Buffers, typed arrays, Maps, Sets,
+// Dates, RegExps and circular references survive the round trip. Buffer
+// contents are copied verbatim instead of being expanded into JSON arrays.
+
+const Buffer = require('buffer').Buffer;
+const StringDecoder = require('string_decoder').StringDecoder;
+
+// JSON ------------------------------------------------------------------------
+
+class JSONReader {
+  constructor() {
+    this.decoder = new StringDecoder('utf8');
+    this.buffer = '';
+  }
+
+  // Returns the messages that are complete after appending `chunk`.
+  read(chunk) {
+    const messages = [];
+    var buffer = this.buffer + this.decoder.write(chunk);
+    var i, start = 0;
+
+    // Linebreak is used as a message end sign
+    while ((i = buffer.indexOf('\n', start)) >= 0) {
+      messages.push(JSON.parse(buffer.slice(start, i)));
+      start = i + 1;
+    }
+    this.buffer = buffer.slice(start);
+    return messages;
+  }
+
+  get buffering() {
+    return this.buffer.length !== 0;
+  }
+}
+
+function writeJSON(channel, req, message, handle) {
+  const string = JSON.stringify(message) + '\n';
+  return channel.writeUtf8String(req, string, handle);
+}
+
+// Advanced --------------------------------------------------------------------
+
+const kFrameHeaderSize = 4;
+
+const kUndefined = 0;
+const kNull = 1;
+const kTrue = 2;
+const kFalse = 3;
+const kInt32 = 4;
+const kDouble = 5;
+const kString = 6;
+const kArray = 7;
+const kObject = 8;
+const kDate = 9;
+const kRegExp = 10;
+const kMap = 11;
+const kSet = 12;
+const kBuffer = 13;
+const kArrayBuffer = 14;
+const kArrayBufferView = 15;
+const kReference = 16;
+
+// Order matters, the index is what goes on the wire.
+const arrayBufferViewTypes = [
+  Int8Array,
+  Uint8Array,
+  Uint8ClampedArray,
+  Int16Array,
+  Uint16Array,
+  Int32Array,
+  Uint32Array,
+  Float32Array,
+  Float64Array,
+  DataView
+];
+
+function cloneError(value) {
+  return new TypeError(`${typeof value} could not be cloned`);
+}
+
+class Serializer {
+  constructor() {
+    this.buffer = Buffer.allocUnsafe(256);
+    this.offset = kFrameHeaderSize;
+    this.objects = new Map();
+  }
+
+  reserve(size) {
+    const needed = this.offset + size;
+    if (needed <= this.buffer.length)
+      return;
+    const buffer = Buffer.allocUnsafe(Math.max(needed, this.buffer.length * 2));
+    this.buffer.copy(buffer, 0, 0, this.offset);
+    this.buffer = buffer;
+  }
+
+  writeTag(tag) {
+    this.reserve(1);
+    this.buffer[this.offset++] = tag;
+  }
+
+  writeUInt32(value) {
+    this.reserve(4);
+    this.offset = this.buffer.writeUInt32LE(value, this.offset, true);
+  }
+
+  writeDouble(value) {
+    this.reserve(8);
+    this.offset = this.buffer.writeDoubleLE(value, this.offset, true);
+  }
+
+  writeString(value) {
+    // A UTF-8 encoding is never more than three bytes per UTF-16 code unit.
+    this.reserve(4 + value.length * 3);
+    const length = this.buffer.write(value, this.offset + 4, 'utf8');
+    this.buffer.writeUInt32LE(length, this.offset, true);
+    this.offset += 4 + length;
+  }
+
+  writeBytes(source, byteOffset, byteLength) {
+    this.writeUInt32(byteLength);
+    this.reserve(byteLength);
+    const bytes = Buffer.from(source, byteOffset, byteLength);
+    this.offset += bytes.copy(this.buffer, this.offset);
+  }
+
+  writeValue(value) {
+    switch (typeof value) {
+      case 'undefined':
+        return this.writeTag(kUndefined);
+      case 'boolean':
+        return this.writeTag(value ? kTrue : kFalse);
+      case 'number':
+        if ((value | 0) === value && (value !== 0 || 1 / value > 0)) {
+          this.writeTag(kInt32);
+          this.reserve(4);
+          this.offset = this.buffer.writeInt32LE(value, this.offset, true);
+        } else {
+          this.writeTag(kDouble);
+          this.writeDouble(value);
+        }
+        return;
+      case 'string':
+        this.writeTag(kString);
+        return this.writeString(value);
+      case 'object':
+        if (value === null)
+          return this.writeTag(kNull);
+        return this.writeObject(value);
+      default:
+        throw cloneError(value);
+    }
+  }
+
+  writeObject(value) {
+    const id = this.objects.get(value);
+    if (id !== undefined) {
+      this.writeTag(kReference);
+      return this.writeUInt32(id);
+    }
+    this.objects.set(value, this.objects.size);
+
+    if (Array.isArray(value)) {
+      this.writeTag(kArray);
+      this.writeUInt32(value.length);
+      for (var i = 0; i < value.length; i++)
+        this.writeValue(value[i]);
+    } else if (Buffer.isBuffer(value)) {
+      this.writeTag(kBuffer);
+      this.writeBytes(value.buffer, value.byteOffset, value.length);
+    } else if (ArrayBuffer.isView(value)) {
+      const type = arrayBufferViewTypes.indexOf(value.constructor);
+      if (type === -1)
+        throw cloneError(value);
+      this.writeTag(kArrayBufferView);
+      this.writeTag(type);
+      this.writeBytes(value.buffer, value.byteOffset, value.byteLength);
+    } else if (value instanceof ArrayBuffer) {
+      this.writeTag(kArrayBuffer);
+      this.writeBytes(value, 0, value.byteLength);
+    } else if (value instanceof Date) {
+      this.writeTag(kDate);
+      this.writeDouble(value.getTime());
+    } else if (value instanceof RegExp) {
+      this.writeTag(kRegExp);
+      this.writeString(value.source);
+      this.writeString(value.flags);
+    } else if (value instanceof Map) {
+      this.writeTag(kMap);
+      this.writeUInt32(value.size);
+      for (const entry of value) {
+        this.writeValue(entry[0]);
+        this.writeValue(entry[1]);
+      }
+    } else if (value instanceof Set) {
+      this.writeTag(kSet);
+      this.writeUInt32(value.size);
+      for (const entry of value)
+        this.writeValue(entry);
+    } else {
+      // Everything else is cloned as a plain object with its own enumerable
+      // properties. Unlike JSON.stringify(), toJSON() is not consulted.
+      const keys = Object.keys(value);
+      this.writeTag(kObject);
+      this.writeUInt32(keys.length);
+      for (var j = 0; j < keys.length; j++) {
+        this.writeString(keys[j]);
+        this.writeValue(value[keys[j]]);
+      }
+    }
+  }
+
+  // Returns the framed message.
+  release() {
+    this.buffer.writeUInt32BE(this.offset - kFrameHeaderSize, 0, true);
+    return this.buffer.slice(0, this.offset);
+  }
+}
+
+function invalidMessage(reason) {
+  return new Error(`Invalid IPC message: ${reason}`);
+}
+
+// Nothing that comes off the channel is trusted: every length is checked
+// against what is left of the message before it is acted upon.
+class Deserializer {
+  constructor(buffer, offset, end) {
+    this.buffer = buffer;
+    this.offset = offset;
+    this.end = end;
+    this.objects = [];
+  }
+
+  // Makes sure that `count` items of at least `size` bytes each are left.
+  need(count, size) {
+    if (count * size > this.end - this.offset)
+      throw invalidMessage('unexpected end of message');
+  }
+
+  readTag() {
+    this.need(1, 1);
+    return this.buffer[this.offset++];
+  }
+
+  readUInt32() {
+    this.need(1, 4);
+    const value = this.buffer.readUInt32LE(this.offset, true);
+    this.offset += 4;
+    return value;
+  }
+
+  readInt32() {
+    this.need(1, 4);
+    const value = this.buffer.readInt32LE(this.offset, true);
+    this.offset += 4;
+    return value;
+  }
+
+  readDouble() {
+    this.need(1, 8);
+    const value = this.buffer.readDoubleLE(this.offset, true);
+    this.offset += 8;
+    return value;
+  }
+
+  // Returns the number of entries that follow, each at least `size` bytes.
+  readCount(size) {
+    const count = this.readUInt32();
+    this.need(count, size);
+    return count;
+  }
+
+  readString() {
+    const length = this.readCount(1);
+    const start = this.offset;
+    this.offset += length;
+    return this.buffer.toString('utf8', start, this.offset);
+  }
+
+  // Returns a copy of the next byte string as a fresh, aligned ArrayBuffer.
+  readArrayBuffer() {
+    const length = this.readCount(1);
+    const copy = new Uint8Array(length);
+    copy.set(this.buffer.subarray(this.offset, this.offset + length));
+    this.offset += length;
+    return copy.buffer;
+  }
+
+  readValue() {
+    const tag = this.readTag();
+    var value, length, i;
+    switch (tag) {
+      case kUndefined:
+        return undefined;
+      case kNull:
+        return null;
+      case kTrue:
+        return true;
+      case kFalse:
+        return false;
+      case kInt32:
+        return this.readInt32();
+      case kDouble:
+        return this.readDouble();
+      case kString:
+        return this.readString();
+      case kReference:
+        i = this.readUInt32();
+        if (i >= this.objects.length)
+          throw invalidMessage('unknown reference');
+        return this.objects[i];
+      case kArray:
+        // Every element is at least a tag.
+        length = this.readCount(1);
+        value = new Array(length);
+        this.objects.push(value);
+        for (i = 0; i < length; i++)
+          value[i] = this.readValue();
+        return value;
+      case kObject:
+        // A key is at least its length, the value at least a tag.
+        length = this.readCount(5);
+        value = {};
+        this.objects.push(value);
+        for (i = 0; i < length; i++) {
+          const key = this.readString();
+          // Not an assignment, a '__proto__' key would replace the prototype.
+          Object.defineProperty(value, key, {
+            value: this.readValue(),
+            enumerable: true,
+            writable: true,
+            configurable: true
+          });
+        }
+        return value;
+      case kBuffer:
+        // The chunk that was read from the pipe is not reused, so the Buffer
+        // can share its memory instead of copying the payload again.
+        length = this.readCount(1);
+        value = this.buffer.slice(this.offset, this.offset + length);
+        this.offset += length;
+        this.objects.push(value);
+        return value;
+      case kArrayBufferView: {
+        const type = arrayBufferViewTypes[this.readTag()];
+        if (type === undefined)
+          throw invalidMessage('unknown view type');
+        const buffer = this.readArrayBuffer();
+        if (type !== DataView && buffer.byteLength % type.BYTES_PER_ELEMENT)
+          throw invalidMessage('misaligned view');
+        value = type === DataView ?
+            new DataView(buffer) :
+            new type(buffer, 0, buffer.byteLength / type.BYTES_PER_ELEMENT);
+        this.objects.push(value);
+        return value;
+      }
+      case kArrayBuffer:
+        value = this.readArrayBuffer();
+        this.objects.push(value);
+        return value;
+      case kDate:
+        value = new Date(this.readDouble());
+        this.objects.push(value);
+        return value;
+      case kRegExp: {
+        const source = this.readString();
+        value = new RegExp(source, this.readString());
+        this.objects.push(value);
+        return value;
+      }
+      case kMap:
+        length = this.readCount(2);
+        value = new Map();
+        this.objects.push(value);
+        for (i = 0; i < length; i++) {
+          const key = this.readValue();
+          value.set(key, this.readValue());
+        }
+        return value;
+      case kSet:
+        length = this.readCount(1);
+        value = new Set();
+        this.objects.push(value);
+        for (i = 0; i < length; i++)
+          value.add(this.readValue());
+        return value;
+      default:
+        throw invalidMessage(`unknown tag ${tag}`);
+    }
+  }
+}
+
+class AdvancedReader {
+  constructor() {
+    // Chunks of a message that has not been received in full yet. They are
+    // only concatenated once the whole message is there.
+    this.chunks = [];
+    this.length = 0;
+    this.needed = kFrameHeaderSize;
+  }
+
+  read(chunk) {
+    const messages = [];
+
+    if (this.length !== 0) {
+      this.chunks.push(chunk);
+      this.length += chunk.length;
+      if (this.length < this.needed)
+        return messages;
+      chunk = Buffer.concat(this.chunks, this.length);
+      this.chunks = [];
+      this.length = 0;
+    }
+
+    var offset = 0;
+    while (chunk.length - offset >= kFrameHeaderSize) {
+      const size = chunk.readUInt32BE(offset, true);
+      const end = offset + kFrameHeaderSize + size;
+      if (end > chunk.length)
+        break;
+      const deserializer =
+          new Deserializer(chunk, offset + kFrameHeaderSize, end);
+      messages.push(deserializer.readValue());
+      if (deserializer.offset !== end)
+        throw invalidMessage('trailing data');
+      offset = end;
+    }
+
+    if (offset !== chunk.length) {
+      const rest = chunk.slice(offset);
+      this.chunks.push(rest);
+      this.length = rest.length;
+      this.needed = rest.length < kFrameHeaderSize ?
+          kFrameHeaderSize :
+          kFrameHeaderSize + rest.readUInt32BE(0, true);
+    }
+
+    return messages;
+  }
+
+  get buffering() {
+    return this.length !== 0;
+  }
+}
+
+function writeAdvanced(channel, req, message, handle) {
+  const serializer = new Serializer();
+  serializer.writeValue(message);
+  return channel.writeBuffer(req, serializer.release(), handle);
+}
+
+module.exports = {
+  json: { Reader: JSONReader, write: writeJSON },
+  advanced: { Reader: AdvancedReader, write: writeAdvanced }
+};
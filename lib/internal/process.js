@@ -227,8 +227,17 @@ function setupChannel() {
     const fd = parseInt(process.env.NODE_CHANNEL_FD, 10);
     assert(fd >= 0);
 
+    // Parents that predate the option don't set it and speak JSON.
+    const serializationMode =
+        process.env.NODE_CHANNEL_SERIALIZATION_MODE || 'json';
+    if (serializationMode !== 'json' && serializationMode !== 'advanced') {
+      throw new TypeError('Invalid NODE_CHANNEL_SERIALIZATION_MODE: ' +
+                          serializationMode);
+    }
+
     // Make sure it's not accidentally inherited by child processes.
     delete process.env.NODE_CHANNEL_FD;
+    delete process.env.NODE_CHANNEL_SERIALIZATION_MODE;
 
     const cp = require('child_process');
 
@@ -237,7 +246,7 @@ function setupChannel() {
     // FIXME is this really necessary?
     process.binding('tcp_wrap');
 
-    cp._forkChild(fd);
+    cp._forkChild(fd, serializationMode);
     assert(process.send);
   }
 }
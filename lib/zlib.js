@@ -86,6 +86,44 @@ exports.createUnzip = function(o) {
   return new Unzip(o);
 };
 
+// Brotli is only available when node is built with --shared-brotli.
+if (binding.Brotli) {
+  exports.BrotliCompress = BrotliCompress;
+  exports.BrotliDecompress = BrotliDecompress;
+
+  exports.createBrotliCompress = function(o) {
+    return new BrotliCompress(o);
+  };
+
+  exports.createBrotliDecompress = function(o) {
+    return new BrotliDecompress(o);
+  };
+
+  exports.brotliCompress = function(buffer, opts, callback) {
+    if (typeof opts === 'function') {
+      callback = opts;
+      opts = {};
+    }
+    return zlibBuffer(constants.BROTLI_ENCODE, opts, buffer, callback);
+  };
+
+  exports.brotliCompressSync = function(buffer, opts) {
+    return zlibBufferSync(constants.BROTLI_ENCODE, opts, buffer);
+  };
+
+  exports.brotliDecompress = function(buffer, opts, callback) {
+    if (typeof opts === 'function') {
+      callback = opts;
+      opts = {};
+    }
+    return zlibBuffer(constants.BROTLI_DECODE, opts, buffer, callback);
+  };
+
+  exports.brotliDecompressSync = function(buffer, opts) {
+    return zlibBufferSync(constants.BROTLI_DECODE, opts, buffer);
+  };
+}
+
 
 // Convenience methods.
 // compress/decompress a string or buffer in one step.
@@ -94,11 +132,11 @@ exports.deflate = function(buffer, opts, callback) {
     callback = opts;
     opts = {};
   }
-  return zlibBuffer(new Deflate(opts), buffer, callback);
+  return zlibBuffer(constants.DEFLATE, opts, buffer, callback);
 };
 
 exports.deflateSync = function(buffer, opts) {
-  return zlibBufferSync(new Deflate(opts), buffer);
+  return zlibBufferSync(constants.DEFLATE, opts, buffer);
 };
 
 exports.gzip = function(buffer, opts, callback) {
@@ -106,11 +144,11 @@ exports.gzip = function(buffer, opts, callback) {
     callback = opts;
     opts = {};
   }
-  return zlibBuffer(new Gzip(opts), buffer, callback);
+  return zlibBuffer(constants.GZIP, opts, buffer, callback);
 };
 
 exports.gzipSync = function(buffer, opts) {
-  return zlibBufferSync(new Gzip(opts), buffer);
+  return zlibBufferSync(constants.GZIP, opts, buffer);
 };
 
 exports.deflateRaw = function(buffer, opts, callback) {
@@ -118,11 +156,11 @@ exports.deflateRaw = function(buffer, opts, callback) {
     callback = opts;
     opts = {};
   }
-  return zlibBuffer(new DeflateRaw(opts), buffer, callback);
+  return zlibBuffer(constants.DEFLATERAW, opts, buffer, callback);
 };
 
 exports.deflateRawSync = function(buffer, opts) {
-  return zlibBufferSync(new DeflateRaw(opts), buffer);
+  return zlibBufferSync(constants.DEFLATERAW, opts, buffer);
 };
 
 exports.unzip = function(buffer, opts, callback) {
@@ -130,11 +168,11 @@ exports.unzip = function(buffer, opts, callback) {
     callback = opts;
     opts = {};
   }
-  return zlibBuffer(new Unzip(opts), buffer, callback);
+  return zlibBuffer(constants.UNZIP, opts, buffer, callback);
 };
 
 exports.unzipSync = function(buffer, opts) {
-  return zlibBufferSync(new Unzip(opts), buffer);
+  return zlibBufferSync(constants.UNZIP, opts, buffer);
 };
 
 exports.inflate = function(buffer, opts, callback) {
@@ -142,11 +180,11 @@ exports.inflate = function(buffer, opts, callback) {
     callback = opts;
     opts = {};
   }
-  return zlibBuffer(new Inflate(opts), buffer, callback);
+  return zlibBuffer(constants.INFLATE, opts, buffer, callback);
 };
 
 exports.inflateSync = function(buffer, opts) {
-  return zlibBufferSync(new Inflate(opts), buffer);
+  return zlibBufferSync(constants.INFLATE, opts, buffer);
 };
 
 exports.gunzip = function(buffer, opts, callback) {
@@ -154,11 +192,11 @@ exports.gunzip = function(buffer, opts, callback) {
     callback = opts;
     opts = {};
   }
-  return zlibBuffer(new Gunzip(opts), buffer, callback);
+  return zlibBuffer(constants.GUNZIP, opts, buffer, callback);
 };
 
 exports.gunzipSync = function(buffer, opts) {
-  return zlibBufferSync(new Gunzip(opts), buffer);
+  return zlibBufferSync(constants.GUNZIP, opts, buffer);
 };
 
 exports.inflateRaw = function(buffer, opts, callback) {
@@ -166,63 +204,127 @@ exports.inflateRaw = function(buffer, opts, callback) {
     callback = opts;
     opts = {};
   }
-  return zlibBuffer(new InflateRaw(opts), buffer, callback);
+  return zlibBuffer(constants.INFLATERAW, opts, buffer, callback);
 };
 
 exports.inflateRawSync = function(buffer, opts) {
-  return zlibBufferSync(new InflateRaw(opts), buffer);
+  return zlibBufferSync(constants.INFLATERAW, opts, buffer);
 };
 
-function zlibBuffer(engine, buffer, callback) {
-  var buffers = [];
-  var nread = 0;
+// The convenience methods don't go through a Zlib stream, they run the whole
+// input through a bare binding in one call and get the output back as a
+// single buffer.
+function zlibBuffer(mode, opts, buffer, callback) {
+  if (typeof buffer === 'string')
+    buffer = Buffer.from(buffer);
+  if (!(buffer instanceof Buffer)) {
+    process.nextTick(callback,
+                     new TypeError('Invalid non-string/buffer chunk'));
+    return;
+  }
+
+  var error = null;
+  const handle = createHandle(mode, opts, function(message, errno, code) {
+    error = zlibError(message, errno, code);
+  });
+  if (error !== null) {
+    handle.close();
+    process.nextTick(callback, error);
+    return;
+  }
 
-  engine.on('error', onError);
-  engine.on('end', onEnd);
+  handle.onerror = function(message, errno, code) {
+    handle.close();
+    callback(zlibError(message, errno, code));
+  };
+  handle.buffer = buffer;
+  handle.callback = function(result) {
+    handle.close();
+    if (result === null)
+      callback(new RangeError(kRangeErrorMessage));
+    else
+      callback(null, result);
+  };
+  handle.writeAll(finishFlushFlag(mode, opts), buffer, kMaxLength);
+}
 
-  engine.end(buffer);
-  flow();
+function zlibBufferSync(mode, opts, buffer) {
+  if (typeof buffer === 'string')
+    buffer = Buffer.from(buffer);
+  if (!(buffer instanceof Buffer))
+    throw new TypeError('Not a string or buffer');
 
-  function flow() {
-    var chunk;
-    while (null !== (chunk = engine.read())) {
-      buffers.push(chunk);
-      nread += chunk.length;
-    }
-    engine.once('readable', flow);
+  var error = null;
+  const handle = createHandle(mode, opts, function(message, errno, code) {
+    error = zlibError(message, errno, code);
+  });
+  var result;
+  if (error === null) {
+    result = handle.writeAllSync(finishFlushFlag(mode, opts),
+                                 buffer,
+                                 kMaxLength);
   }
+  handle.close();
+
+  if (error !== null)
+    throw error;
+  if (result === null)
+    throw new RangeError(kRangeErrorMessage);
+  return result;
+}
 
-  function onError(err) {
-    engine.removeListener('end', onEnd);
-    engine.removeListener('readable', flow);
-    callback(err);
+function createHandle(mode, opts, onerror) {
+  opts = opts || {};
+  if (isBrotliMode(mode)) {
+    validateBrotliOptions(opts);
+    const handle = new binding.Brotli(mode);
+    handle.onerror = onerror;
+    initBrotliHandle(handle, opts);
+    return handle;
   }
 
-  function onEnd() {
-    var buf;
-    var err = null;
+  validateOptions(opts);
+  const handle = new binding.Zlib(mode);
+  handle.onerror = onerror;
 
-    if (nread >= kMaxLength) {
-      err = new RangeError(kRangeErrorMessage);
-    } else {
-      buf = Buffer.concat(buffers, nread);
-    }
+  var level = constants.Z_DEFAULT_COMPRESSION;
+  if (typeof opts.level === 'number') level = opts.level;
 
-    buffers = [];
-    engine.close();
-    callback(err, buf);
-  }
+  var strategy = constants.Z_DEFAULT_STRATEGY;
+  if (typeof opts.strategy === 'number') strategy = opts.strategy;
+
+  handle.init(opts.windowBits || constants.Z_DEFAULT_WINDOWBITS,
+              level,
+              opts.memLevel || constants.Z_DEFAULT_MEMLEVEL,
+              strategy,
+              opts.dictionary);
+  return handle;
 }
 
-function zlibBufferSync(engine, buffer) {
-  if (typeof buffer === 'string')
-    buffer = Buffer.from(buffer);
-  if (!(buffer instanceof Buffer))
-    throw new TypeError('Not a string or buffer');
+function zlibError(message, errno, code) {
+  var error = new Error(message);
+  error.errno = errno;
+  error.code = code || exports.codes[errno];
+  return error;
+}
 
-  var flushFlag = engine._finishFlushFlag;
+function isBrotliMode(mode) {
+  return mode === constants.BROTLI_ENCODE || mode === constants.BROTLI_DECODE;
+}
+
+function finishFlushFlag(mode, opts) {
+  if (opts && typeof opts.finishFlush !== 'undefined')
+    return opts.finishFlush;
+  return isBrotliMode(mode) ?
+    constants.BROTLI_OPERATION_FINISH : constants.Z_FINISH;
+}
 
-  return engine._processChunk(buffer, flushFlag);
+function initBrotliHandle(handle, opts) {
+  handle.init(typeof opts.quality === 'number' ?
+                opts.quality : constants.BROTLI_DEFAULT_QUALITY,
+              opts.lgwin || constants.BROTLI_DEFAULT_WINDOW,
+              typeof opts.mode === 'number' ?
+                opts.mode : constants.BROTLI_DEFAULT_MODE);
 }
 
 // generic zlib
@@ -268,6 +370,18 @@ function Unzip(opts) {
   Zlib.call(this, opts, constants.UNZIP);
 }
 
+
+// brotli
+function BrotliCompress(opts) {
+  if (!(this instanceof BrotliCompress)) return new BrotliCompress(opts);
+  Brotli.call(this, opts, constants.BROTLI_ENCODE);
+}
+
+function BrotliDecompress(opts) {
+  if (!(this instanceof BrotliDecompress)) return new BrotliDecompress(opts);
+  Brotli.call(this, opts, constants.BROTLI_DECODE);
+}
+
 function isValidFlushFlag(flag) {
   return flag === constants.Z_NO_FLUSH ||
          flag === constants.Z_PARTIAL_FLUSH ||
@@ -277,17 +391,7 @@ function isValidFlushFlag(flag) {
          flag === constants.Z_BLOCK;
 }
 
-// the Zlib class they all inherit from
-// This thing manages the queue of requests, and returns
-// true or false if there is anything in the queue when
-// you call the .write() method.
-
-function Zlib(opts, mode) {
-  this._opts = opts = opts || {};
-  this._chunkSize = opts.chunkSize || constants.Z_DEFAULT_CHUNK;
-
-  Transform.call(this, opts);
-
+function validateOptions(opts) {
   if (opts.flush && !isValidFlushFlag(opts.flush)) {
     throw new Error('Invalid flush flag: ' + opts.flush);
   }
@@ -295,10 +399,6 @@ function Zlib(opts, mode) {
     throw new Error('Invalid flush flag: ' + opts.finishFlush);
   }
 
-  this._flushFlag = opts.flush || constants.Z_NO_FLUSH;
-  this._finishFlushFlag = typeof opts.finishFlush !== 'undefined' ?
-    opts.finishFlush : constants.Z_FINISH;
-
   if (opts.chunkSize) {
     if (opts.chunkSize < constants.Z_MIN_CHUNK) {
       throw new Error('Invalid chunk size: ' + opts.chunkSize);
@@ -341,23 +441,102 @@ function Zlib(opts, mode) {
       throw new Error('Invalid dictionary: it should be a Buffer instance');
     }
   }
+}
+
+function isValidBrotliFlushFlag(flag) {
+  return flag === constants.BROTLI_OPERATION_PROCESS ||
+         flag === constants.BROTLI_OPERATION_FLUSH ||
+         flag === constants.BROTLI_OPERATION_FINISH;
+}
+
+function validateBrotliOptions(opts) {
+  if (opts.flush && !isValidBrotliFlushFlag(opts.flush)) {
+    throw new Error('Invalid flush flag: ' + opts.flush);
+  }
+  if (opts.finishFlush && !isValidBrotliFlushFlag(opts.finishFlush)) {
+    throw new Error('Invalid flush flag: ' + opts.finishFlush);
+  }
+
+  if (opts.chunkSize) {
+    if (opts.chunkSize < constants.Z_MIN_CHUNK) {
+      throw new Error('Invalid chunk size: ' + opts.chunkSize);
+    }
+  }
 
-  this._handle = new binding.Zlib(mode);
+  if (opts.quality) {
+    if (opts.quality < constants.BROTLI_MIN_QUALITY ||
+        opts.quality > constants.BROTLI_MAX_QUALITY) {
+      throw new Error('Invalid quality: ' + opts.quality);
+    }
+  }
+
+  if (opts.lgwin) {
+    if (opts.lgwin < constants.BROTLI_MIN_WINDOW_BITS ||
+        opts.lgwin > constants.BROTLI_MAX_WINDOW_BITS) {
+      throw new Error('Invalid lgwin: ' + opts.lgwin);
+    }
+  }
+
+  if (opts.mode) {
+    if (opts.mode !== constants.BROTLI_MODE_GENERIC &&
+        opts.mode !== constants.BROTLI_MODE_TEXT &&
+        opts.mode !== constants.BROTLI_MODE_FONT) {
+      throw new Error('Invalid mode: ' + opts.mode);
+    }
+  }
+}
+
+// the ZlibBase class the zlib and brotli streams inherit from
+// This thing manages the queue of requests, and returns
+// true or false if there is anything in the queue when
+// you call the .write() method.
+// `noFlush` and `fullFlush` are the flush values for normal writes and for
+// flush() without arguments, they differ between zlib and brotli.
+
+function ZlibBase(opts, mode, handle, noFlush, fullFlush) {
+  this._opts = opts;
+  this._chunkSize = opts.chunkSize || constants.Z_DEFAULT_CHUNK;
+
+  Transform.call(this, opts);
+
+  this._defaultFlushFlag = noFlush;
+  this._defaultFullFlushFlag = fullFlush;
+  this._flushFlag = opts.flush || noFlush;
+  this._finishFlushFlag = finishFlushFlag(mode, opts);
+
+  this._handle = handle;
 
   var self = this;
   this._hadError = false;
-  this._handle.onerror = function(message, errno) {
+  this._handle.onerror = function(message, errno, code) {
     // there is no way to cleanly recover.
     // continuing only obscures problems.
     _close(self);
     self._hadError = true;
-
-    var error = new Error(message);
-    error.errno = errno;
-    error.code = exports.codes[errno];
-    self.emit('error', error);
+    self.emit('error', zlibError(message, errno, code));
   };
 
+  this._buffer = Buffer.allocUnsafe(this._chunkSize);
+  this._offset = 0;
+
+  this.once('end', this.close);
+
+  Object.defineProperty(this, '_closed', {
+    get: () => { return !this._handle; },
+    configurable: true,
+    enumerable: true
+  });
+}
+
+util.inherits(ZlibBase, Transform);
+
+function Zlib(opts, mode) {
+  opts = opts || {};
+  validateOptions(opts);
+
+  ZlibBase.call(this, opts, mode, new binding.Zlib(mode),
+                constants.Z_NO_FLUSH, constants.Z_FULL_FLUSH);
+
   var level = constants.Z_DEFAULT_COMPRESSION;
   if (typeof opts.level === 'number') level = opts.level;
 
@@ -370,21 +549,26 @@ function Zlib(opts, mode) {
                     strategy,
                     opts.dictionary);
 
-  this._buffer = Buffer.allocUnsafe(this._chunkSize);
-  this._offset = 0;
   this._level = level;
   this._strategy = strategy;
+}
 
-  this.once('end', this.close);
+util.inherits(Zlib, ZlibBase);
 
-  Object.defineProperty(this, '_closed', {
-    get: () => { return !this._handle; },
-    configurable: true,
-    enumerable: true
-  });
+// Brotli streams can't change their parameters once started, there is no
+// params() method.
+function Brotli(opts, mode) {
+  opts = opts || {};
+  validateBrotliOptions(opts);
+
+  ZlibBase.call(this, opts, mode, new binding.Brotli(mode),
+                constants.BROTLI_OPERATION_PROCESS,
+                constants.BROTLI_OPERATION_FLUSH);
+
+  initBrotliHandle(this._handle, opts);
 }
 
-util.inherits(Zlib, Transform);
+util.inherits(Brotli, ZlibBase);
 
 Zlib.prototype.params = function(level, strategy, callback) {
   if (level < constants.Z_MIN_LEVEL ||
@@ -415,23 +599,23 @@ Zlib.prototype.params = function(level, strategy, callback) {
   }
 };
 
-Zlib.prototype.reset = function() {
+ZlibBase.prototype.reset = function() {
   assert(this._handle, 'zlib binding closed');
   return this._handle.reset();
 };
 
 // This is the _flush function called by the transform class,
 // internally, when the last chunk has been written.
-Zlib.prototype._flush = function(callback) {
+ZlibBase.prototype._flush = function(callback) {
   this._transform(Buffer.alloc(0), '', callback);
 };
 
-Zlib.prototype.flush = function(kind, callback) {
+ZlibBase.prototype.flush = function(kind, callback) {
   var ws = this._writableState;
 
   if (typeof kind === 'function' || (kind === undefined && !callback)) {
     callback = kind;
-    kind = constants.Z_FULL_FLUSH;
+    kind = this._defaultFullFlushFlag;
   }
 
   if (ws.ended) {
@@ -451,7 +635,7 @@ Zlib.prototype.flush = function(kind, callback) {
   }
 };
 
-Zlib.prototype.close = function(callback) {
+ZlibBase.prototype.close = function(callback) {
   _close(this, callback);
   process.nextTick(emitCloseNT, this);
 };
@@ -472,7 +656,7 @@ function emitCloseNT(self) {
   self.emit('close');
 }
 
-Zlib.prototype._transform = function(chunk, encoding, cb) {
+ZlibBase.prototype._transform = function(chunk, encoding, cb) {
   var flushFlag;
   var ws = this._writableState;
   var ending = ws.ending || ws.ended;
@@ -496,14 +680,14 @@ Zlib.prototype._transform = function(chunk, encoding, cb) {
     // once we've flushed the last of the queue, stop flushing and
     // go back to the normal behavior.
     if (chunk.length >= ws.length) {
-      this._flushFlag = this._opts.flush || constants.Z_NO_FLUSH;
+      this._flushFlag = this._opts.flush || this._defaultFlushFlag;
     }
   }
 
   this._processChunk(chunk, flushFlag, cb);
 };
 
-Zlib.prototype._processChunk = function(chunk, flushFlag, cb) {
+ZlibBase.prototype._processChunk = function(chunk, flushFlag, cb) {
   var availInBefore = chunk && chunk.length;
   var availOutBefore = this._chunkSize - this._offset;
   var inOff = 0;
@@ -633,3 +817,5 @@ util.inherits(Gunzip, Zlib);
 util.inherits(DeflateRaw, Zlib);
 util.inherits(InflateRaw, Zlib);
 util.inherits(Unzip, Zlib);
+util.inherits(BrotliCompress, Brotli);
+util.inherits(BrotliDecompress, Brotli);
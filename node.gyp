@@ -12,6 +12,7 @@
     'force_dynamic_crt%': 0,
     'node_module_version%': '',
     'node_shared_zlib%': 'false',
+    'node_shared_brotli%': 'false',
     'node_shared_http_parser%': 'false',
     'node_shared_cares%': 'false',
     'node_shared_libuv%': 'false',
@@ -76,6 +77,7 @@
       'lib/zlib.js',
       'lib/internal/buffer.js',
       'lib/internal/child_process.js',
+      'lib/internal/child_process/serialization.js',
       'lib/internal/cluster.js',
       'lib/internal/freelist.js',
       'lib/internal/fs.js',
@@ -200,6 +202,7 @@
         'src/node_buffer.h',
         'src/node_constants.h',
         'src/node_debug_options.h',
+        'src/node_dtrace_probes.h',
         'src/node_file.h',
         'src/node_http_parser.h',
         'src/node_internals.h',
@@ -348,9 +351,11 @@
             'src/node_crypto.cc',
             'src/node_crypto_bio.cc',
             'src/node_crypto_clienthello.cc',
+            'src/node_crypto_session_cache.cc',
             'src/node_crypto.h',
             'src/node_crypto_bio.h',
             'src/node_crypto_clienthello.h',
+            'src/node_crypto_session_cache.h',
             'src/tls_wrap.cc',
             'src/tls_wrap.h'
           ],
@@ -490,6 +495,10 @@
           'dependencies': [ 'deps/zlib/zlib.gyp:zlib' ],
         }],
 
+        [ 'node_shared_brotli=="true"', {
+          'defines': [ 'HAVE_BROTLI=1' ],
+        }],
+
         [ 'node_shared_http_parser=="false"', {
           'dependencies': [ 'deps/http_parser/http_parser.gyp:http_parser' ],
         }],
@@ -519,7 +528,11 @@
           'libraries': [ '-lpsapi.lib' ]
         }, { # POSIX
           'defines': [ '__POSIX__' ],
-          'sources': [ 'src/backtrace_posix.cc' ],
+          'sources': [
+            'src/backtrace_posix.cc',
+            'src/node_metrics_shm.cc',
+            'src/node_metrics_shm.h',
+          ],
         }],
         [ 'OS=="mac"', {
           # linking Corefoundation is needed since certain OSX debugging tools
@@ -0,0 +1,456 @@
+0,184,184,120,218,237,61,107,111,220,200,145,127,133,16,14,176,13,140,181,
+73,14,184,59,36,193,1,178,100,103,21,248,33,72,118,114,192,193,31,56,
+100,143,166,215,28,114,142,205,145,60,9,246,191,95,189,250,69,54,57,28,
+89,251,240,198,192,98,173,33,155,221,213,221,213,245,174,234,127,158,148,205,
+38,215,181,57,249,227,255,254,243,164,104,54,155,188,46,249,71,171,186,93,
+43,47,116,167,54,240,215,63,79,254,173,85,171,147,63,158,92,208,71,39,
+63,46,78,186,253,86,193,131,188,109,243,253,201,226,164,206,55,248,211,118,
+186,56,41,149,41,90,189,237,116,83,195,243,215,218,116,89,179,202,204,110,
+187,109,218,78,149,153,180,60,61,249,241,227,226,100,13,131,87,170,197,49,
+79,150,109,115,111,84,11,93,180,170,46,85,11,127,126,116,253,223,170,238,
+98,100,136,107,6,123,108,8,254,1,237,110,138,181,218,228,131,207,175,218,
+230,78,195,163,76,215,171,166,221,228,248,56,203,151,205,174,203,186,181,202,
+182,109,211,53,69,83,101,134,62,63,61,225,21,224,85,82,159,121,196,147,
+63,118,237,78,185,181,105,150,63,168,162,131,150,186,244,75,183,56,129,174,
+182,170,237,180,124,44,141,77,215,234,250,214,175,36,253,211,7,146,251,200,
+240,29,204,106,49,250,241,29,172,37,126,49,242,189,188,150,133,137,91,248,
+95,184,95,209,212,121,9,241,43,28,58,194,153,220,236,235,194,78,63,68,
+160,184,247,151,119,121,181,227,165,109,149,217,85,221,169,135,153,31,192,111,
+65,181,107,181,105,58,245,142,215,16,7,236,117,245,185,80,12,102,169,186,
+92,87,6,187,106,232,73,94,89,72,164,107,101,219,94,112,83,63,200,203,
+254,155,31,61,174,41,6,22,119,97,155,183,240,172,99,12,29,93,117,64,
+3,152,68,114,225,95,186,87,89,215,100,182,103,222,195,62,208,35,189,51,
+54,253,165,109,118,219,65,247,55,251,205,178,169,116,145,221,226,107,194,15,
+216,186,188,203,138,188,206,150,42,219,25,56,14,48,112,171,42,149,27,149,
+109,96,165,245,182,82,25,119,106,38,1,89,54,13,124,85,123,72,116,93,
+84,187,82,157,51,2,188,214,181,58,187,186,28,226,26,174,215,6,94,154,
+236,126,173,0,145,218,76,190,200,240,147,12,190,201,204,186,217,85,37,66,
+152,223,193,242,231,75,0,169,220,225,188,9,243,148,67,151,227,0,52,186,
+82,117,55,128,232,178,206,248,77,182,105,74,232,221,238,189,129,193,128,232,
+212,118,104,63,108,150,183,42,171,155,14,22,78,104,10,130,95,54,244,108,
+155,195,178,66,47,170,216,17,136,217,59,56,87,45,209,144,63,23,48,192,
+127,27,213,93,97,155,119,181,67,179,63,127,71,111,50,211,185,237,239,237,
+228,86,21,122,165,137,14,193,186,233,98,237,71,200,138,166,238,212,231,14,
+119,18,40,8,146,169,112,137,178,75,57,175,22,89,51,109,178,102,163,59,
+132,59,94,206,236,94,87,21,46,187,116,3,13,96,56,108,99,135,144,179,
+15,228,19,0,194,14,182,249,173,154,56,98,242,221,101,25,158,45,129,251,
+220,189,59,102,19,153,138,188,216,255,13,128,30,82,194,191,11,74,33,144,
+76,57,112,182,112,2,25,90,88,33,68,170,236,175,55,239,222,10,146,243,
+129,240,24,103,16,17,150,251,12,23,69,29,135,95,183,170,86,45,108,224,
+85,171,238,180,186,135,23,56,112,171,55,208,165,255,58,13,240,150,191,9,
+0,177,189,149,25,108,69,48,161,227,96,2,60,107,255,162,12,172,153,58,
+10,30,143,93,30,162,174,85,4,79,142,88,168,59,77,63,96,169,112,12,
+139,40,31,46,143,131,47,191,207,117,7,76,118,163,205,248,110,14,128,193,
+143,104,89,182,252,165,108,44,44,80,83,221,169,210,225,188,160,0,96,109,
+128,228,128,16,120,78,243,76,134,93,100,186,123,98,16,197,141,70,193,194,
+161,73,157,193,193,109,218,20,63,20,142,165,8,183,44,9,135,255,110,171,
+102,153,87,130,90,188,18,51,121,160,0,99,55,57,251,59,30,69,60,62,
+200,153,91,245,3,35,48,97,101,166,87,110,226,247,176,25,246,237,35,114,
+77,28,2,136,81,241,9,254,223,230,133,194,69,115,180,248,209,89,106,15,
+9,122,108,181,71,173,75,192,94,36,133,109,32,136,224,135,193,236,229,9,
+79,55,164,61,225,50,252,150,233,206,35,208,152,1,202,159,149,101,38,2,
+57,113,26,139,128,186,91,103,183,250,78,213,238,145,76,80,151,71,29,128,
+243,28,16,254,215,47,254,21,0,230,171,93,93,224,235,119,245,241,216,106,
+119,191,201,176,167,108,37,93,101,40,204,244,132,186,3,152,59,34,16,218,
+30,47,84,81,1,104,93,82,224,247,239,44,92,14,16,129,140,247,206,41,
+122,137,189,202,219,219,29,178,146,83,15,37,62,63,147,199,227,218,160,253,
+208,36,246,102,98,28,115,154,157,33,77,140,158,129,204,10,42,228,82,85,
+13,10,135,13,77,197,160,156,251,87,32,87,55,212,85,118,223,180,21,113,
+45,124,217,193,167,170,139,40,244,111,82,126,252,197,232,26,75,167,223,4,
+170,111,2,213,49,2,21,158,116,227,137,80,192,85,202,144,86,241,154,240,
+11,57,194,25,19,69,209,113,155,85,15,87,117,13,19,214,180,235,0,221,
+24,9,152,50,110,93,177,97,102,111,109,32,77,59,78,218,28,187,138,103,
+39,32,122,19,79,100,166,177,125,244,201,10,240,148,218,9,147,193,199,217,
+211,166,174,246,118,170,160,187,35,254,193,154,27,85,173,158,77,48,60,45,
+61,94,121,75,211,98,48,219,203,184,81,52,235,95,130,223,194,78,69,240,
+62,152,221,242,22,135,203,184,66,84,124,16,207,245,167,110,100,174,64,246,
+35,168,123,96,2,108,216,90,96,50,33,80,204,202,144,95,208,38,11,75,
+139,55,121,65,231,13,94,193,79,182,195,33,92,89,177,102,59,220,17,112,
+230,69,1,202,75,211,122,96,223,193,168,179,8,219,96,18,182,175,8,83,
+249,32,171,14,54,236,59,67,255,60,163,137,253,41,179,216,24,54,247,124,
+17,187,132,51,171,52,210,171,95,35,215,48,41,42,118,61,220,79,192,195,
+252,39,32,88,142,222,144,229,238,157,53,41,127,193,233,160,142,142,58,15,
+137,233,83,39,168,145,98,75,39,17,120,98,110,117,130,20,248,214,134,57,
+207,170,58,203,238,217,132,43,45,230,241,113,168,89,1,9,32,55,172,164,
+121,233,210,238,36,117,24,207,100,87,95,174,254,14,92,20,128,124,213,180,
+23,106,185,187,189,37,119,69,60,216,123,133,124,206,219,207,224,175,46,175,
+11,98,184,208,7,234,221,192,137,81,171,191,231,206,8,237,74,233,142,96,
+232,64,47,95,71,131,171,26,213,242,161,117,153,30,27,145,50,137,164,172,
+134,102,67,96,212,40,134,224,19,16,61,54,112,148,8,105,89,214,84,61,
+99,221,57,75,44,86,222,84,119,40,255,103,112,122,106,193,98,59,18,224,
+43,200,137,4,128,181,50,34,253,178,6,70,18,10,245,102,163,74,20,122,
+128,206,225,44,85,78,102,77,109,168,135,1,160,209,148,75,109,146,115,190,
+224,231,243,39,221,239,181,200,219,18,38,11,114,143,122,89,3,206,37,200,
+247,5,183,66,9,167,170,120,27,3,161,31,69,249,130,59,32,99,54,234,
+43,194,239,83,116,200,234,22,170,59,7,77,166,217,240,89,120,69,190,38,
+56,3,188,135,229,232,177,24,80,63,89,115,241,198,140,171,219,151,165,37,
+2,252,116,130,113,115,131,144,18,220,216,39,191,136,6,222,108,182,160,111,
+49,12,143,239,133,145,238,39,29,105,166,217,181,133,250,112,253,122,72,122,
+232,77,182,107,43,17,122,97,99,29,231,176,43,157,228,208,214,118,133,78,
+56,211,185,217,141,249,1,238,3,205,76,64,46,101,128,128,123,73,111,170,
+124,12,167,130,244,14,100,234,151,117,42,168,161,7,97,210,187,48,84,54,
+120,189,66,227,237,81,166,170,235,221,215,224,168,132,125,26,59,35,211,164,
+64,120,81,48,183,163,40,192,191,10,90,125,141,62,218,223,164,9,235,87,
+239,120,254,186,108,108,63,175,61,237,43,181,87,1,11,48,150,114,69,250,
+13,82,33,171,38,120,193,53,140,52,130,79,59,157,136,226,145,231,18,79,
+131,8,208,160,86,18,24,178,91,105,17,202,233,162,176,132,39,19,48,122,
+163,17,112,71,35,178,65,132,13,235,218,78,207,6,125,35,250,132,73,16,
+131,224,30,193,14,46,50,166,109,120,236,161,35,148,100,221,152,187,90,255,
+31,58,39,189,150,57,160,99,184,99,171,93,75,123,42,189,2,125,133,37,
+7,13,8,168,68,171,111,181,183,120,49,136,184,22,232,3,101,250,190,129,
+217,182,123,24,10,184,55,217,243,247,212,136,205,4,8,47,80,82,221,129,
+62,33,228,18,56,91,43,51,149,223,57,233,114,180,101,164,1,7,176,24,
+225,32,186,141,20,199,56,168,171,79,226,41,136,235,198,243,199,120,79,63,
+240,154,8,162,248,165,73,75,151,212,87,79,203,30,233,209,249,216,226,30,
+85,189,219,96,180,220,101,189,66,139,50,90,114,222,230,111,225,255,207,131,
+39,207,127,135,161,115,201,193,63,212,6,52,148,188,210,255,64,218,151,166,
+87,87,160,194,128,106,122,167,196,27,205,196,8,182,25,15,21,236,52,18,
+170,231,220,45,66,86,58,221,231,112,48,92,36,51,13,66,226,236,228,220,
+55,214,92,12,127,238,234,82,173,16,75,224,111,207,126,119,155,37,233,224,
+158,234,24,98,183,169,249,11,61,162,199,35,246,91,124,151,166,110,22,52,
+103,14,222,85,21,254,3,44,141,34,22,111,97,250,216,43,199,141,109,114,
+252,1,76,144,237,175,64,68,27,132,82,8,42,253,77,132,135,151,224,243,
+158,255,21,10,137,64,148,60,206,248,44,204,110,57,53,17,121,157,173,53,
+170,239,86,96,227,243,201,28,154,215,216,50,101,106,76,187,109,200,122,119,
+84,132,90,81,229,198,188,77,197,45,10,52,212,32,123,138,244,23,58,42,
+96,1,158,177,177,230,177,33,203,235,192,84,127,151,68,238,235,200,114,37,
+225,22,64,201,81,244,106,48,236,34,194,125,131,228,133,24,179,252,124,234,
+237,55,173,130,115,138,170,215,179,148,238,53,122,136,178,145,83,4,108,65,
+49,223,90,231,240,21,175,5,125,43,75,177,200,150,187,142,237,46,221,90,
+59,27,228,126,66,226,221,37,79,187,136,188,41,82,112,196,174,135,211,29,
+200,188,73,30,18,217,36,83,107,54,70,250,178,167,136,29,117,83,63,239,
+111,207,148,55,100,150,189,191,191,105,44,3,73,88,14,206,33,95,46,241,
+33,137,65,118,197,101,240,135,161,239,40,188,219,73,115,182,76,129,129,183,
+178,92,106,187,236,161,36,99,211,213,156,62,207,163,166,67,81,232,77,36,
+56,88,126,78,150,55,203,208,3,25,38,220,222,36,15,56,159,1,217,188,
+88,233,181,202,65,156,155,180,182,172,115,243,162,41,247,161,13,112,101,77,
+111,179,194,135,228,163,165,174,203,240,173,141,16,57,50,248,200,71,77,174,
+244,237,225,241,201,196,247,47,207,36,191,14,46,248,40,244,112,12,141,27,
+208,175,87,85,51,212,222,222,183,20,46,184,202,76,179,81,65,192,156,243,
+78,129,208,204,86,110,55,92,44,132,103,37,168,52,200,117,86,186,235,133,
+4,245,220,227,158,232,140,248,198,183,227,14,81,155,7,18,67,151,30,15,
+173,242,135,7,83,206,118,63,29,97,20,142,44,223,164,81,1,208,209,226,
+1,42,59,206,142,225,236,22,130,76,49,126,124,28,17,116,99,58,61,199,
+67,105,101,165,52,235,105,135,98,203,4,137,237,111,217,151,16,217,100,66,
+138,29,32,72,73,121,68,186,180,112,110,235,47,33,81,217,153,245,87,179,
+46,77,202,106,128,128,123,113,182,83,232,107,61,240,110,31,119,250,211,194,
+230,7,144,176,158,175,0,231,234,18,84,214,88,124,16,69,59,37,7,189,
+37,177,82,154,137,88,48,33,56,80,59,191,213,179,37,133,223,32,185,254,
+56,122,36,34,170,50,235,60,164,69,67,33,37,159,212,190,15,34,44,208,
+243,74,127,82,214,107,136,36,222,82,156,241,205,131,142,166,246,108,18,8,
+33,3,3,36,76,247,150,18,38,30,124,230,145,177,240,105,205,130,86,41,
+100,126,111,1,205,64,9,108,10,38,103,206,60,51,67,137,233,205,106,224,
+118,153,107,136,188,111,117,151,116,41,11,15,245,75,58,9,41,236,243,30,
+245,183,98,157,215,183,208,224,41,156,143,220,45,66,211,50,46,38,117,194,
+179,32,254,141,13,188,170,189,195,184,4,131,22,69,10,158,113,166,86,59,
+220,34,115,216,239,168,168,61,0,12,115,171,216,224,105,123,120,234,40,89,
+2,168,209,85,190,85,243,93,91,147,243,48,95,60,15,243,37,243,48,147,
+243,24,195,13,22,200,119,237,65,252,32,154,67,199,47,208,192,3,0,251,
+216,129,162,132,94,37,17,168,84,149,138,162,128,138,166,5,241,112,219,212,
+37,233,86,51,196,66,164,224,234,16,208,33,160,102,221,220,155,108,183,117,
+254,30,238,160,151,246,233,132,199,250,0,92,179,143,94,110,222,147,159,105,
+114,109,197,150,127,159,247,189,82,41,215,204,220,0,56,109,222,29,24,214,
+139,3,48,227,251,58,112,119,140,91,42,28,45,20,26,200,45,23,201,46,
+249,145,200,147,212,60,100,96,83,168,108,165,161,36,54,143,73,158,137,184,
+206,233,104,213,16,125,121,174,95,192,36,206,155,26,227,128,104,58,126,0,
+47,37,254,156,188,97,108,133,38,34,96,71,86,170,31,202,24,45,89,246,
+62,58,98,218,212,79,58,32,99,237,38,175,64,232,187,211,70,163,151,81,
+215,161,145,4,247,63,185,214,15,55,108,246,12,142,143,98,147,124,108,211,
+226,148,41,150,83,143,190,200,158,55,182,225,81,214,202,208,32,44,74,121,
+16,157,30,165,160,156,102,47,217,251,20,235,96,186,140,132,210,203,210,153,
+105,189,145,50,101,196,141,23,174,111,112,70,46,89,139,183,11,40,7,25,
+62,29,191,124,134,199,98,19,186,133,173,0,26,209,68,196,86,14,77,100,
+201,55,21,246,144,10,16,65,119,104,58,38,111,82,50,254,96,221,130,78,
+205,30,116,146,93,14,194,29,24,244,253,84,8,137,56,213,2,207,103,20,
+247,196,65,33,129,248,171,15,199,115,140,197,111,144,77,36,17,55,214,7,
+137,27,78,134,142,37,201,226,247,187,77,142,158,217,188,164,77,39,9,154,
+91,44,41,152,178,231,77,30,103,173,14,177,173,119,125,247,249,2,228,207,
+33,232,160,91,151,37,104,159,130,34,69,6,45,117,165,243,22,104,23,124,
+48,97,186,232,47,221,197,132,97,171,87,54,34,71,223,123,83,49,25,199,
+164,172,41,126,226,209,180,31,5,149,192,80,31,77,165,203,201,229,71,136,
+39,190,198,215,139,65,120,133,32,229,45,7,35,16,3,114,192,248,144,12,
+216,162,32,69,54,121,224,4,136,10,78,235,91,107,222,232,219,163,106,216,
+127,122,231,207,139,29,170,106,10,70,244,167,191,123,190,68,111,246,179,233,
+113,64,211,220,109,234,145,145,206,233,229,209,99,245,44,151,124,6,47,47,
+198,59,120,120,96,233,76,219,202,174,173,134,150,149,235,215,227,16,45,36,
+190,131,182,245,222,198,46,219,96,142,220,68,113,77,169,89,7,156,154,147,
+164,37,71,122,53,43,71,154,62,121,143,95,4,243,246,207,166,66,5,45,
+111,89,29,151,140,61,91,115,27,102,8,88,202,118,79,10,152,95,203,117,
+190,221,170,122,82,4,120,64,152,230,8,193,25,68,63,14,34,187,114,10,
+127,29,214,232,241,0,63,69,83,55,26,160,158,177,165,111,168,70,24,43,
+123,97,112,168,232,60,65,232,81,116,212,156,113,146,32,124,175,55,10,118,
+117,51,140,238,123,235,78,215,70,87,149,54,10,214,179,52,153,209,24,242,
+15,24,102,3,249,231,137,212,86,0,73,58,211,3,164,116,130,202,152,96,
+29,34,176,13,77,153,31,238,121,196,57,28,14,100,173,67,208,250,193,68,
+114,216,107,21,144,205,199,32,142,195,17,138,136,92,134,99,76,137,149,175,
+218,212,86,209,105,39,227,31,39,62,216,184,46,194,79,206,32,0,133,7,
+241,161,169,205,17,225,51,55,33,101,153,167,57,60,192,77,5,100,71,85,
+206,200,17,16,192,211,236,21,70,91,97,12,53,63,144,72,4,49,104,228,
+178,247,253,124,115,60,141,62,253,21,223,113,23,137,44,244,32,205,156,87,
+118,212,255,83,216,38,230,139,14,202,25,66,2,84,162,110,118,81,36,94,
+72,246,105,2,160,36,20,170,36,248,237,162,44,230,210,233,109,222,178,230,
+145,96,6,201,68,217,108,69,51,35,220,241,136,146,89,10,151,193,59,147,
+223,42,73,81,163,204,27,70,130,17,202,44,89,61,135,226,196,207,64,245,
+184,7,157,181,144,180,229,190,72,126,122,210,175,251,51,78,240,67,169,113,
+56,201,75,99,118,150,55,195,152,9,225,95,27,11,70,156,9,53,28,166,
+107,155,253,225,185,249,24,248,210,126,146,249,73,60,86,226,65,56,175,228,
+156,220,224,147,179,50,231,149,2,156,73,40,106,65,255,136,39,131,15,179,
+123,100,227,5,127,142,202,149,45,171,23,141,38,60,211,217,228,38,87,206,
+49,191,129,192,21,224,67,23,112,72,89,48,207,52,83,99,207,203,116,152,
+90,93,203,248,3,70,207,81,170,108,73,232,175,176,52,191,86,119,205,167,
+137,124,171,62,189,4,28,52,9,82,121,77,143,67,29,238,126,189,239,1,
+213,242,80,211,92,106,74,233,65,243,24,171,213,210,149,31,96,145,229,198,
+135,230,195,62,219,116,62,121,255,193,174,130,216,29,78,15,44,167,91,181,
+169,57,248,179,143,201,111,103,87,151,72,171,82,107,105,61,139,85,115,75,
+147,90,238,40,0,21,164,183,32,242,241,62,111,107,94,234,82,183,252,255,
+207,27,148,48,172,151,166,19,70,71,216,76,158,227,188,117,73,22,254,7,
+232,57,85,190,53,4,135,170,75,219,128,233,38,243,201,149,174,148,255,235,
+101,93,30,235,87,126,239,204,254,106,130,109,245,132,239,241,234,40,67,158,
+213,43,132,242,0,209,221,130,70,219,182,201,203,208,49,248,128,204,151,4,
+120,238,140,31,115,238,83,130,17,179,213,34,223,98,145,141,64,67,27,128,
+255,64,5,107,18,211,195,212,77,28,171,32,28,142,16,92,50,138,174,109,
+128,231,16,193,35,147,228,97,127,83,223,106,131,30,238,67,4,78,84,65,
+111,164,240,121,78,100,21,84,159,97,137,43,181,96,175,155,207,131,144,102,
+79,159,101,82,169,147,101,103,155,169,250,44,89,199,115,94,158,177,203,82,
+182,14,18,41,11,133,105,87,217,121,165,201,136,42,0,83,2,6,76,199,
+102,59,49,231,197,239,145,88,174,115,44,132,128,100,92,50,136,81,64,174,
+66,47,16,15,129,82,128,204,66,35,49,42,148,190,235,109,214,193,68,225,
+8,234,0,226,176,19,163,186,23,64,233,63,109,27,220,153,179,2,13,178,
+243,83,114,115,219,190,31,198,113,47,70,93,28,121,233,251,207,248,3,151,
+10,53,44,197,133,239,169,250,220,119,0,126,238,126,225,249,8,251,17,7,
+93,106,58,55,159,244,246,172,170,40,11,203,204,159,138,129,207,14,76,4,
+155,112,6,152,25,159,193,155,252,19,188,70,192,8,19,200,129,210,238,48,
+60,20,185,244,222,126,255,212,207,102,17,50,183,178,217,4,140,72,117,197,
+179,97,25,151,49,249,206,74,175,190,235,40,45,197,231,163,248,89,251,166,
+33,101,124,17,62,77,209,251,215,98,111,26,167,245,214,34,53,29,17,231,
+90,49,198,7,128,219,124,39,92,192,38,219,109,113,245,202,82,119,174,138,
+111,10,127,95,236,63,144,166,158,222,242,135,26,43,59,114,204,135,192,229,
+221,233,35,154,241,112,170,152,90,109,18,35,29,200,199,75,140,116,141,209,
+75,9,169,13,158,2,238,97,124,65,237,168,24,0,97,102,64,129,199,205,
+249,130,36,146,161,117,190,220,38,120,70,195,216,23,82,191,172,239,171,25,
+153,202,113,86,140,119,171,21,194,40,121,177,68,231,191,120,155,208,128,165,
+187,195,105,244,152,1,74,172,39,24,202,125,43,37,35,220,156,23,158,10,
+83,90,47,149,190,49,93,179,181,36,44,232,196,6,45,4,133,55,149,171,
+198,137,229,114,218,93,146,228,220,96,102,68,160,194,71,75,32,132,223,25,
+189,29,100,54,181,108,185,207,8,25,91,250,135,130,223,78,179,119,84,184,
+163,199,133,52,49,233,133,232,95,82,204,2,206,154,113,249,249,134,39,73,
+121,28,33,254,184,211,140,61,185,212,60,39,188,59,50,96,81,199,57,192,
+179,87,66,188,54,121,87,172,3,91,38,14,75,202,135,118,181,21,177,63,
+179,91,26,20,94,96,234,220,181,135,226,90,96,136,42,124,216,73,137,47,
+27,196,118,13,178,66,184,130,52,128,217,181,119,200,183,136,172,183,170,106,
+242,210,252,26,232,114,143,104,217,61,158,36,166,167,17,251,222,229,149,35,
+230,139,33,121,31,33,180,135,52,103,15,201,224,80,234,80,121,174,38,134,
+254,151,63,184,121,239,232,246,234,11,109,154,59,53,181,35,71,96,210,199,
+84,174,216,157,26,129,173,175,18,3,25,216,169,247,77,128,70,179,113,195,
+126,157,69,104,89,77,35,228,32,238,134,186,48,129,217,137,101,106,231,0,
+118,180,143,36,233,188,88,247,4,105,208,116,182,152,199,159,48,11,171,45,
+48,191,59,73,97,39,153,143,235,130,246,190,190,132,115,53,242,53,201,47,
+145,89,216,171,209,225,248,187,110,108,248,93,55,176,44,15,186,32,169,50,
+209,65,179,117,178,114,141,26,115,108,232,77,204,6,73,105,42,131,155,30,
+71,8,209,115,31,165,226,138,167,106,15,222,168,188,45,214,111,144,172,31,
+93,116,208,93,174,65,125,48,111,176,54,97,71,174,240,213,37,235,246,245,
+131,10,133,72,239,122,186,92,136,228,182,159,206,241,35,1,99,106,247,99,
+206,7,63,226,170,57,178,46,28,230,112,222,168,218,232,164,54,230,202,217,
+217,9,25,78,250,52,246,139,35,107,82,152,180,136,233,134,161,218,159,198,
+166,211,251,130,39,100,84,67,233,34,73,9,17,52,49,252,51,217,147,239,
+145,169,91,63,21,109,229,144,239,78,231,193,160,14,23,249,178,37,231,85,
+149,92,133,12,53,114,235,243,197,248,136,74,101,127,123,67,6,18,164,246,
+91,118,4,207,112,197,76,184,114,142,170,99,130,160,158,115,16,237,104,213,
+136,98,215,162,99,133,237,70,60,57,54,31,53,37,203,118,249,138,86,124,
+187,173,246,54,142,148,3,115,205,168,47,40,92,36,118,240,212,83,1,136,
+228,201,186,73,216,163,220,129,152,231,248,15,202,178,79,15,56,110,64,183,
+35,78,149,12,66,195,0,141,207,101,172,30,66,15,16,97,30,141,20,152,
+24,152,33,202,10,182,247,75,153,29,131,74,101,187,7,144,6,189,103,114,
+82,3,172,96,17,135,44,87,36,18,86,236,214,4,244,65,181,45,187,104,
+247,84,194,79,220,157,54,146,13,43,55,138,232,29,140,64,81,68,200,180,
+92,87,132,149,30,15,57,2,116,120,241,64,169,99,105,136,245,81,80,238,
+44,133,154,98,39,95,230,56,237,209,136,95,228,140,124,12,185,30,218,248,
+173,135,125,18,81,189,211,52,42,79,226,175,220,137,203,175,187,53,8,241,
+246,60,120,152,146,5,9,26,180,105,181,157,46,118,85,222,74,129,119,26,
+213,5,241,47,213,173,174,107,151,216,21,110,214,67,206,64,132,4,167,189,
+186,185,95,122,148,17,115,5,189,226,82,185,115,14,245,104,109,84,223,99,
+20,118,53,90,35,52,81,43,202,140,187,148,234,166,86,148,81,88,228,187,
+219,53,74,52,176,9,83,57,103,29,167,175,245,34,161,169,128,85,83,135,
+149,176,54,35,39,242,130,130,111,141,20,189,138,191,97,251,103,118,206,177,
+173,168,227,161,252,34,234,17,27,8,108,91,140,252,101,152,195,14,168,174,
+65,240,224,52,187,164,72,137,106,124,56,148,92,88,171,199,181,240,254,189,
+73,53,92,2,217,239,91,100,241,222,128,175,142,185,152,75,80,224,103,169,
+123,55,135,153,217,179,253,174,14,35,113,126,94,58,177,248,53,222,10,198,
+34,227,160,54,46,213,228,219,117,222,78,4,191,159,194,100,48,37,8,240,
+66,151,82,68,137,83,213,177,77,208,13,187,135,13,112,61,124,200,248,55,
+172,238,43,216,248,236,167,168,239,54,44,141,57,112,112,165,202,187,217,2,
+219,178,202,101,96,158,64,227,198,42,167,98,89,208,106,149,87,70,125,171,
+182,247,237,2,174,99,238,131,114,149,224,28,97,233,243,182,191,229,173,14,
+83,100,102,122,101,76,209,108,199,220,50,18,155,24,132,118,83,235,140,138,
+74,27,56,14,70,130,66,248,49,151,141,207,176,240,123,246,4,173,64,213,
+147,69,246,164,168,26,179,107,213,19,194,180,39,5,26,15,158,200,7,84,
+12,141,80,146,168,3,202,190,239,104,13,233,53,26,195,101,5,225,244,233,
+237,142,227,253,225,111,146,115,167,47,168,148,197,72,6,184,218,149,26,13,
+214,99,63,164,52,234,39,63,215,234,190,151,133,100,121,72,239,210,154,180,
+100,132,27,200,140,129,208,117,221,84,165,113,131,125,153,232,200,106,172,177,
+9,62,43,63,7,42,37,232,70,182,133,227,101,119,101,177,45,101,240,247,
+155,82,253,63,241,42,109,118,93,98,245,61,246,145,188,142,224,145,140,125,
+1,196,97,61,31,7,55,249,103,251,69,223,187,251,89,111,118,27,32,159,
+240,150,18,63,92,64,39,235,6,88,99,67,117,157,24,116,152,74,253,206,
+210,36,210,178,212,106,165,200,11,14,72,41,46,124,151,56,143,181,47,250,
+29,102,79,133,86,63,75,30,79,137,80,192,100,97,235,247,31,118,129,10,
+203,39,39,154,79,23,235,126,81,65,219,101,243,249,138,157,133,9,137,212,
+233,94,49,174,143,151,71,241,61,245,116,42,108,199,81,94,88,114,65,42,
+85,216,242,183,86,205,44,214,10,111,107,99,105,26,203,79,83,80,129,64,
+57,238,136,191,86,219,10,237,61,68,254,48,200,213,125,98,225,97,209,124,
+139,241,82,112,18,106,172,143,242,170,33,23,232,18,90,170,154,211,181,208,
+233,143,22,218,45,204,241,59,228,72,145,85,74,58,65,176,156,139,10,186,
+114,57,197,50,212,41,217,148,112,98,24,25,13,221,2,121,71,31,153,128,
+228,11,92,3,123,144,12,47,236,233,9,14,12,131,1,125,82,192,250,114,
+9,69,90,100,43,44,100,67,197,32,141,212,130,135,62,185,53,168,222,79,
+80,53,221,213,102,71,121,228,171,93,117,204,190,171,242,154,78,237,177,122,
+213,241,166,145,129,73,152,94,94,53,70,79,199,22,108,165,133,25,13,191,
+176,251,231,54,207,22,192,116,73,1,117,184,246,45,91,198,162,61,10,54,
+72,216,138,221,240,159,104,139,50,59,113,164,124,120,46,164,32,14,232,95,
+238,5,7,188,197,184,79,246,92,182,23,2,254,234,214,72,208,9,16,93,
+73,201,245,51,61,205,248,200,5,50,137,77,5,74,104,127,226,254,26,175,
+218,234,195,154,138,124,155,47,117,165,169,184,17,38,61,138,116,109,132,22,
+178,223,119,211,220,225,143,192,51,188,112,71,139,36,68,80,18,189,184,183,
+160,170,167,13,103,176,120,187,11,124,163,186,2,177,205,213,157,141,238,164,
+216,226,37,218,117,193,217,1,174,36,109,50,90,156,167,123,69,30,236,227,
+175,24,9,60,209,170,124,52,195,224,104,176,72,27,37,25,68,131,83,113,
+198,188,222,31,200,11,33,59,14,42,25,233,112,151,134,99,42,226,1,144,
+186,233,58,138,16,9,45,26,8,25,5,229,89,219,74,126,107,230,64,193,
+41,122,99,153,123,15,132,228,64,188,49,43,88,195,185,231,70,178,108,18,
+166,214,137,206,70,166,240,90,213,183,44,26,80,100,202,84,231,99,90,158,
+245,119,216,203,75,92,122,236,172,176,86,111,64,56,38,17,120,157,155,117,
+170,166,1,217,160,241,229,17,134,232,126,208,103,31,218,179,135,167,238,30,
+229,167,122,13,136,129,86,229,89,218,210,123,242,93,89,79,190,101,19,38,
+208,149,122,225,166,28,120,116,199,142,164,12,227,85,14,215,79,79,223,182,
+241,38,223,166,46,220,144,16,49,65,245,77,190,29,212,138,16,40,227,211,
+63,119,125,96,83,111,130,203,62,30,184,66,232,61,115,119,134,164,216,8,
+112,36,27,216,123,167,91,244,8,192,84,80,78,82,76,188,108,79,18,129,
+195,151,233,96,97,178,202,52,192,67,91,81,82,81,152,253,84,251,84,7,
+127,65,141,101,203,20,35,72,81,181,200,48,108,240,70,172,22,80,211,87,
+148,82,249,190,33,186,255,141,236,127,35,251,223,200,254,215,75,246,191,81,
+212,144,162,174,200,149,142,214,110,36,16,131,141,27,132,132,217,152,200,67,
+84,208,135,139,13,239,66,248,210,168,197,51,114,19,135,177,111,97,125,133,
+135,132,132,5,11,20,6,233,5,97,168,120,217,92,45,14,106,187,238,100,
+79,79,133,218,145,21,186,156,48,131,60,138,11,250,220,135,114,80,57,190,
+222,206,74,44,74,22,132,91,69,89,211,214,75,248,63,223,95,67,215,23,
+239,222,192,255,95,34,47,197,88,41,20,97,8,33,125,213,4,151,36,70,
+140,82,28,16,190,26,255,181,250,65,217,26,166,116,145,196,132,163,113,36,
+81,144,61,141,252,242,40,186,81,166,136,196,176,72,44,109,109,138,102,244,
+203,236,78,135,7,125,175,227,80,247,203,11,51,26,239,179,214,97,178,76,
+24,243,211,179,132,253,50,225,3,163,167,96,26,161,162,124,131,54,172,255,
+210,82,198,10,95,36,66,190,221,2,175,239,108,117,158,8,25,28,6,43,
+29,0,64,62,139,226,8,63,30,188,143,228,69,76,98,70,201,212,172,11,
+73,206,35,147,246,12,135,233,233,84,212,181,181,48,49,119,225,48,151,145,
+114,6,97,172,236,84,133,169,155,254,237,42,253,228,87,95,96,207,218,64,
+78,67,163,134,243,145,63,80,74,125,104,202,76,108,108,235,149,173,120,148,
+4,144,184,198,207,248,120,31,31,103,195,122,166,201,99,202,74,79,173,225,
+236,42,30,169,121,132,85,245,188,19,46,115,70,245,34,174,167,176,241,153,
+166,68,134,70,231,26,197,20,76,97,103,250,136,176,30,23,160,172,230,218,
+165,232,5,210,54,194,50,69,16,180,68,154,148,143,20,135,48,89,83,230,
+109,160,84,165,202,102,112,114,108,102,147,41,250,94,206,163,48,106,132,188,
+219,177,2,98,48,113,87,69,148,24,113,212,240,243,114,45,134,198,120,216,
+249,113,73,134,124,116,231,232,95,77,68,110,57,223,107,144,204,58,185,128,
+76,194,176,161,203,42,99,126,159,252,222,231,96,195,155,163,195,116,124,233,
+205,165,226,128,15,78,71,114,53,76,29,14,160,21,162,115,183,171,115,234,
+195,232,110,114,179,17,71,108,175,60,103,170,218,24,174,89,84,80,122,148,
+18,53,91,53,126,131,212,109,213,44,115,52,37,144,187,27,139,13,104,114,
+99,138,211,27,255,162,144,251,197,201,18,90,124,194,122,2,124,147,230,145,
+117,1,110,156,191,60,181,159,239,236,141,41,82,97,210,198,126,18,214,112,
+49,29,222,114,6,119,120,253,0,66,237,34,57,216,29,172,131,254,12,23,
+211,97,249,157,215,231,79,97,44,67,96,68,192,111,241,26,60,218,205,22,
+73,82,129,65,102,32,131,213,70,83,128,45,195,234,10,2,83,142,89,67,
+5,214,217,89,77,229,157,229,62,122,39,88,46,70,51,225,199,176,112,166,
+2,91,179,2,113,196,25,23,175,16,3,205,177,154,147,21,4,218,238,245,
+52,41,120,216,200,10,83,234,199,3,222,234,114,50,207,44,113,36,130,228,
+14,174,37,165,108,48,232,24,171,117,181,203,142,150,86,156,105,41,74,50,
+24,217,34,236,214,231,149,36,250,37,83,2,3,238,251,251,184,152,89,234,
+42,72,140,73,113,132,7,23,49,176,245,31,216,109,134,233,32,88,176,13,
+183,212,86,85,10,174,253,70,227,107,222,218,24,178,130,74,28,68,183,51,
+122,201,83,190,62,43,75,159,92,89,55,116,210,146,247,144,79,23,45,232,
+67,137,238,123,169,81,219,74,236,27,55,112,64,83,4,178,165,229,34,26,
+71,112,199,9,107,88,83,229,141,124,59,4,67,174,34,91,115,176,196,199,
+97,97,26,44,101,196,14,81,42,106,132,213,177,200,124,244,156,210,11,237,
+77,151,128,174,175,27,12,19,0,229,59,39,129,198,55,117,122,168,117,95,
+202,165,236,199,122,47,195,117,63,24,254,25,47,154,132,250,216,90,20,57,
+118,17,208,52,105,21,72,92,252,185,44,219,140,178,86,189,77,34,226,203,
+131,196,58,222,8,23,227,114,56,63,128,92,102,236,61,207,181,234,238,155,
+22,25,150,244,253,60,223,106,42,135,211,180,12,107,190,221,22,152,220,71,
+87,120,192,42,202,161,53,160,94,182,124,61,36,91,50,252,94,48,49,194,
+110,39,13,28,38,29,161,46,171,225,67,212,23,253,250,63,190,208,143,45,
+253,19,85,4,26,31,177,130,221,174,198,7,196,64,3,221,237,143,47,7,
+107,123,56,88,109,247,200,18,6,118,155,195,42,193,115,213,188,106,212,51,
+17,43,119,142,68,19,238,122,183,28,23,226,19,0,158,254,254,11,84,205,
+121,74,230,209,112,140,86,81,140,15,213,98,250,200,58,93,214,82,141,43,
+174,233,52,21,244,176,240,145,17,31,23,83,44,35,65,160,123,69,85,176,
+228,14,96,196,165,68,150,204,15,165,211,254,139,68,206,141,116,27,68,172,
+212,217,70,23,109,35,245,68,79,39,162,10,207,175,62,100,82,216,170,29,
+246,116,154,189,145,72,65,81,229,150,10,132,8,21,126,69,117,117,154,182,
+148,0,147,182,27,228,5,195,179,3,233,5,215,212,3,95,145,136,125,158,
+70,183,130,73,249,45,127,159,24,61,8,211,210,186,102,59,77,18,71,215,
+117,244,2,93,95,143,188,118,197,246,123,150,57,171,225,36,44,237,69,160,
+253,39,194,73,173,129,123,254,217,90,235,238,188,217,213,243,188,240,190,170,
+44,109,168,50,174,198,23,221,144,130,34,103,206,25,205,205,54,44,75,102,
+77,26,145,38,219,131,104,220,42,191,214,85,9,44,227,224,149,106,231,216,
+144,193,208,165,57,242,146,60,104,120,157,182,148,191,95,91,59,57,78,137,
+37,25,12,124,197,174,55,250,31,92,157,34,208,75,221,53,42,174,65,70,
+247,175,180,159,56,74,161,108,48,234,203,190,140,125,25,98,193,122,175,139,
+79,169,164,213,171,224,253,37,242,168,31,23,163,55,51,200,34,30,222,212,
+179,90,34,218,188,239,205,194,145,117,8,200,233,228,165,30,120,102,222,242,
+213,92,131,187,72,240,29,163,121,246,61,5,46,35,50,64,215,42,172,152,
+188,8,111,89,199,43,8,13,140,202,197,104,11,183,163,38,89,174,56,113,
+37,160,3,103,20,159,168,187,228,46,87,146,184,190,13,32,55,46,106,15,
+198,66,65,137,152,76,211,116,193,241,29,209,111,136,64,189,215,155,177,165,
+113,132,205,87,176,75,16,216,241,254,129,169,28,232,157,130,100,103,245,109,
+215,168,31,94,97,194,195,142,167,90,54,99,92,131,229,182,9,239,139,59,
+232,7,135,197,89,57,78,129,66,112,119,207,114,240,15,121,129,138,142,133,
+167,63,33,62,135,180,91,165,170,186,156,157,138,88,82,251,206,229,219,216,
+189,117,155,51,49,23,92,186,11,236,104,122,58,7,14,199,216,193,56,234,
+14,130,164,24,118,99,83,112,131,26,212,191,159,85,131,186,19,2,115,136,
+188,231,29,16,202,229,46,208,217,140,31,115,138,46,244,9,213,28,66,228,
+99,45,242,48,133,36,9,74,158,21,176,106,168,231,245,72,214,88,233,97,
+81,75,100,237,111,88,158,152,93,109,85,79,22,244,65,107,62,119,127,42,
+232,245,244,217,164,105,215,121,131,30,82,79,167,211,221,56,82,101,244,214,
+70,205,231,124,131,164,228,152,72,73,151,62,156,169,114,15,117,231,149,69,
+123,98,80,26,43,185,232,131,177,2,153,164,221,13,122,29,150,64,137,215,
+255,149,174,181,89,255,132,27,240,178,46,31,180,7,7,133,195,95,114,159,
+14,218,150,14,40,10,68,242,36,215,228,123,149,111,217,252,153,72,37,152,
+27,82,67,137,43,103,149,175,38,200,16,6,210,243,163,14,199,246,35,88,
+193,91,204,116,27,43,113,146,61,225,118,56,228,77,157,111,205,186,113,223,
+60,177,117,197,108,22,139,87,16,217,243,101,228,3,196,113,22,245,186,252,
+147,170,189,159,220,230,234,240,33,144,10,36,209,180,241,131,112,236,175,113,
+190,189,41,137,225,241,47,121,187,36,3,211,164,206,245,242,139,115,183,163,
+98,2,252,240,197,222,99,208,229,161,194,183,161,55,50,92,149,201,43,208,
+31,146,208,76,23,225,233,34,202,101,70,179,67,239,78,41,201,71,206,54,
+152,186,12,204,76,156,26,166,183,202,121,89,94,218,90,186,126,182,135,108,
+135,216,210,111,163,191,4,76,50,94,41,129,133,110,122,11,205,195,255,246,
+121,144,164,124,26,221,95,191,125,55,115,37,63,30,178,103,211,252,87,202,
+25,171,89,77,12,171,46,100,119,58,71,136,158,26,165,50,137,117,202,94,
+219,220,105,186,194,22,77,3,182,20,13,180,180,186,150,57,162,252,234,58,
+181,78,241,21,146,86,68,100,162,220,191,86,173,183,64,131,165,56,188,80,
+30,169,167,145,249,80,140,179,205,95,230,74,25,52,49,191,239,113,197,140,
+196,229,116,137,35,71,240,245,57,133,53,42,205,166,95,3,253,103,104,149,
+234,105,158,152,145,133,22,83,18,241,34,43,211,114,223,161,234,117,213,104,
+67,245,236,181,97,233,79,28,191,116,178,172,71,209,105,10,172,0,72,62,
+166,120,145,161,241,191,255,225,63,255,227,191,164,71,153,231,12,139,145,51,
+89,209,250,206,176,31,217,245,194,189,29,177,37,185,37,165,99,99,77,133,
+193,7,135,114,164,18,50,244,80,212,5,58,18,162,224,249,122,87,127,154,
+45,104,21,212,58,194,6,116,234,118,2,160,137,67,203,198,248,206,124,3,
+100,137,117,83,38,85,149,6,39,123,76,160,239,202,10,151,209,44,48,232,
+251,6,212,200,241,99,55,170,123,245,191,156,208,201,125,221,249,132,23,102,
+21,158,85,159,246,235,61,61,86,170,238,40,56,86,178,36,91,117,139,85,
+125,246,226,17,204,93,121,49,95,250,154,2,218,141,242,213,217,53,103,99,
+247,200,155,171,147,79,53,166,224,168,240,165,28,98,176,21,3,58,211,73,
+186,39,138,186,229,148,15,130,136,50,103,133,26,19,9,236,242,206,124,216,
+226,69,236,125,57,131,139,41,176,77,55,39,53,162,191,138,252,69,164,35,
+244,250,60,156,218,124,208,118,104,162,222,198,237,94,112,8,128,2,1,71,
+206,94,230,197,218,254,180,215,104,144,70,186,2,82,197,215,110,122,43,131,
+140,111,205,66,182,9,60,47,213,231,5,235,203,100,155,8,91,230,25,161,
+52,86,43,224,2,98,22,31,44,61,179,221,112,7,221,90,183,201,239,141,
+254,135,138,57,194,176,139,211,199,67,67,52,107,34,6,102,59,222,112,28,
+42,68,8,59,164,153,19,39,250,125,154,129,206,146,108,102,92,253,249,40,
+22,244,49,174,166,170,213,13,44,253,16,159,188,30,196,123,99,217,152,219,
+149,90,170,174,84,59,58,143,214,176,157,190,180,35,193,78,166,237,154,129,
+157,124,204,46,62,101,202,29,27,111,32,244,90,190,72,219,51,223,200,155,
+87,190,200,245,113,86,94,79,29,202,73,110,203,203,115,196,252,38,44,115,
+31,177,31,16,79,168,78,18,108,202,38,255,161,105,161,197,239,225,155,141,
+174,233,239,63,156,252,248,227,255,3,122,72,9,221
\ No newline at end of file
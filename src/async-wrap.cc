@@ -2,6 +2,7 @@
 #include "async-wrap-inl.h"
 #include "env.h"
 #include "env-inl.h"
+#include "node_dtrace_probes.h"
 #include "util.h"
 #include "util-inl.h"
 
@@ -336,7 +337,11 @@ Local<Value> AsyncWrap::MakeCallback(const Local<Function> cb,
     }
   }
 
+  if (NODE_CALLBACK_START_ENABLED())
+    NODE_CALLBACK_START(this, provider_type());
   Local<Value> ret = cb->Call(context, argc, argv);
+  if (NODE_CALLBACK_DONE_ENABLED())
+    NODE_CALLBACK_DONE(this, provider_type());
 
   if (ran_init_callback() && !post_fn.IsEmpty()) {
     Local<Value> did_throw = Boolean::New(env()->isolate(), ret.IsEmpty());
@@ -5,6 +5,7 @@
 #include "env.h"
 #include "env-inl.h"
 #include "node.h"
+#include "node_dtrace_probes.h"
 #include "req-wrap.h"
 #include "req-wrap-inl.h"
 #include "tree.h"
@@ -314,6 +315,9 @@ class QueryWrap : public AsyncWrap {
       unsigned char* answer_buf, int answer_len) {
     QueryWrap* wrap = static_cast<QueryWrap*>(arg);
 
+    if (NODE_DNS_DONE_ENABLED())
+      NODE_DNS_DONE(wrap, status);
+
     if (status != ARES_SUCCESS) {
       wrap->ParseError(status);
     } else {
@@ -327,6 +331,9 @@ class QueryWrap : public AsyncWrap {
       struct hostent* host) {
     QueryWrap* wrap = static_cast<QueryWrap*>(arg);
 
+    if (NODE_DNS_DONE_ENABLED())
+      NODE_DNS_DONE(wrap, status);
+
     if (status != ARES_SUCCESS) {
       wrap->ParseError(status);
     } else {
@@ -953,6 +960,8 @@ static void Query(const FunctionCallbackInfo<Value>& args) {
   int err = wrap->Send(*name);
   if (err)
     delete wrap;
+  else if (NODE_DNS_QUERY_ENABLED())
+    NODE_DNS_QUERY(wrap, *name);
 
   args.GetReturnValue().Set(err);
 }
@@ -962,6 +971,9 @@ void AfterGetAddrInfo(uv_getaddrinfo_t* req, int status, struct addrinfo* res) {
   GetAddrInfoReqWrap* req_wrap = static_cast<GetAddrInfoReqWrap*>(req->data);
   Environment* env = req_wrap->env();
 
+  if (NODE_DNS_DONE_ENABLED())
+    NODE_DNS_DONE(req, status);
+
   HandleScope handle_scope(env->isolate());
   Context::Scope context_scope(env->context());
 
@@ -1162,6 +1174,8 @@ static void GetAddrInfo(const FunctionCallbackInfo<Value>& args) {
   req_wrap->Dispatched();
   if (err)
     delete req_wrap;
+  else if (NODE_DNS_QUERY_ENABLED())
+    NODE_DNS_QUERY(req_wrap->req(), *hostname);
 
   args.GetReturnValue().Set(err);
 }
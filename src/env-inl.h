@@ -232,6 +232,11 @@ inline Environment::~Environment() {
   delete[] heap_statistics_buffer_;
   delete[] heap_space_statistics_buffer_;
   delete[] http_parser_buffer_;
+  DeleteZlibContextPool(zlib_context_pool_);
+#if HAVE_OPENSSL
+  crypto::DeleteRandomPool(random_pool_);
+  DeleteTLSHandshakeQueue(tls_handshake_queue_);
+#endif
 }
 
 inline v8::Isolate* Environment::isolate() const {
@@ -359,6 +364,35 @@ inline void Environment::set_http_parser_buffer(char* buffer) {
   http_parser_buffer_ = buffer;
 }
 
+inline ZlibContextPool* Environment::zlib_context_pool() const {
+  return zlib_context_pool_;
+}
+
+inline void Environment::set_zlib_context_pool(ZlibContextPool* pool) {
+  CHECK_EQ(zlib_context_pool_, nullptr);  // Should be set only once.
+  zlib_context_pool_ = pool;
+}
+
+#if HAVE_OPENSSL
+inline crypto::RandomPool* Environment::random_pool() const {
+  return random_pool_;
+}
+
+inline void Environment::set_random_pool(crypto::RandomPool* pool) {
+  CHECK_EQ(random_pool_, nullptr);  // Should be set only once.
+  random_pool_ = pool;
+}
+
+inline TLSHandshakeQueue* Environment::tls_handshake_queue() const {
+  return tls_handshake_queue_;
+}
+
+inline void Environment::set_tls_handshake_queue(TLSHandshakeQueue* queue) {
+  CHECK_EQ(tls_handshake_queue_, nullptr);  // Should be set only once.
+  tls_handshake_queue_ = queue;
+}
+#endif
+
 inline Environment* Environment::from_cares_timer_handle(uv_timer_t* handle) {
   return ContainerOf(&Environment::cares_timer_handle_, handle);
 }
@@ -241,6 +241,8 @@ namespace node {
   V(domains_stack_array, v8::Array)                                           \
   V(fs_stats_constructor_function, v8::Function)                              \
   V(generic_internal_field_template, v8::ObjectTemplate)                      \
+  V(hash_constructor_template, v8::FunctionTemplate)                          \
+  V(hmac_constructor_template, v8::FunctionTemplate)                          \
   V(jsstream_constructor_template, v8::FunctionTemplate)                      \
   V(module_load_list_array, v8::Array)                                        \
   V(pipe_constructor_template, v8::FunctionTemplate)                          \
@@ -260,6 +262,19 @@ namespace node {
 
 class Environment;
 
+class ZlibContextPool;
+void DeleteZlibContextPool(ZlibContextPool* pool);
+
+#if HAVE_OPENSSL
+namespace crypto {
+class RandomPool;
+void DeleteRandomPool(RandomPool* pool);
+}  // namespace crypto
+
+class TLSHandshakeQueue;
+void DeleteTLSHandshakeQueue(TLSHandshakeQueue* queue);
+#endif
+
 struct node_ares_task {
   Environment* env;
   ares_socket_t sock;
@@ -478,6 +493,17 @@ class Environment {
   inline char* http_parser_buffer() const;
   inline void set_http_parser_buffer(char* buffer);
 
+  inline ZlibContextPool* zlib_context_pool() const;
+  inline void set_zlib_context_pool(ZlibContextPool* pool);
+
+#if HAVE_OPENSSL
+  inline crypto::RandomPool* random_pool() const;
+  inline void set_random_pool(crypto::RandomPool* pool);
+
+  inline TLSHandshakeQueue* tls_handshake_queue() const;
+  inline void set_tls_handshake_queue(TLSHandshakeQueue* queue);
+#endif
+
   inline void ThrowError(const char* errmsg);
   inline void ThrowTypeError(const char* errmsg);
   inline void ThrowRangeError(const char* errmsg);
@@ -586,6 +612,13 @@ class Environment {
 
   char* http_parser_buffer_;
 
+  ZlibContextPool* zlib_context_pool_ = nullptr;
+
+#if HAVE_OPENSSL
+  crypto::RandomPool* random_pool_ = nullptr;
+  TLSHandshakeQueue* tls_handshake_queue_ = nullptr;
+#endif
+
 #define V(PropertyName, TypeName)                                             \
   v8::Persistent<TypeName> PropertyName ## _;
   ENVIRONMENT_STRONG_PERSISTENT_PROPERTIES(V)
@@ -8,11 +8,16 @@
 #include "node_internals.h"
 #include "node_revert.h"
 #include "node_debug_options.h"
+#include "node_dtrace_probes.h"
 
 #if defined HAVE_PERFCTR
 #include "node_counters.h"
 #endif
 
+#ifdef __POSIX__
+#include "node_metrics_shm.h"
+#endif
+
 #if HAVE_OPENSSL
 #include "node_crypto.h"
 #endif
@@ -159,6 +164,11 @@ static const char* trace_enabled_categories = nullptr;
 static const char* icu_data_dir = nullptr;
 #endif
 
+#ifdef __POSIX__
+// Path of the shared-memory metrics file (--metrics-shm)
+static const char* metrics_shm_path = nullptr;
+#endif
+
 // used by C++ modules as well
 bool no_deprecation = false;
 
@@ -1219,7 +1229,12 @@ Local<Value> MakeCallback(Environment* env,
     }
   }
 
+  // There is no AsyncWrap here, report it as PROVIDER_NONE.
+  if (NODE_CALLBACK_START_ENABLED())
+    NODE_CALLBACK_START(nullptr, AsyncWrap::PROVIDER_NONE);
   Local<Value> ret = callback->Call(recv, argc, argv);
+  if (NODE_CALLBACK_DONE_ENABLED())
+    NODE_CALLBACK_DONE(nullptr, AsyncWrap::PROVIDER_NONE);
 
   if (ran_init_callback && !post_fn.IsEmpty()) {
     Local<Value> did_throw = Boolean::New(env->isolate(), ret.IsEmpty());
@@ -3517,6 +3532,10 @@ static void PrintHelp() {
 #endif
          "  --preserve-symlinks      preserve symbolic links when resolving\n"
          "                           and caching modules\n"
+#endif
+#ifdef __POSIX__
+         "  --metrics-shm=path       export runtime counters through a\n"
+         "                           shared-memory file at path\n"
 #endif
          "\n"
          "Environment variables:\n"
@@ -3686,6 +3705,10 @@ static void ParseArgs(int* argc,
 #if defined(NODE_HAVE_I18N_SUPPORT)
     } else if (strncmp(arg, "--icu-data-dir=", 15) == 0) {
       icu_data_dir = arg + 15;
+#endif
+#ifdef __POSIX__
+    } else if (strncmp(arg, "--metrics-shm=", 14) == 0) {
+      metrics_shm_path = arg + 14;
 #endif
     } else if (strcmp(arg, "--expose-internals") == 0 ||
                strcmp(arg, "--expose_internals") == 0) {
@@ -4347,6 +4370,10 @@ inline int Start(Isolate* isolate, IsolateData* isolate_data,
   Environment env(isolate_data, context);
   env.Start(argc, argv, exec_argc, exec_argv, v8_is_profiling);
 
+#ifdef __POSIX__
+  metrics::Attach(&env);
+#endif
+
   bool debug_enabled =
       debug_options.debugger_enabled() || debug_options.inspector_enabled();
 
@@ -4466,6 +4493,18 @@ int Start(int argc, char** argv) {
   const char** exec_argv;
   Init(&argc, const_cast<const char**>(argv), &exec_argc, &exec_argv);
 
+#ifdef __POSIX__
+  if (metrics_shm_path != nullptr) {
+    const int err = metrics::Open(metrics_shm_path);
+    if (err != 0) {
+      fprintf(stderr, "%s: cannot create metrics file %s: %s\n",
+              argv[0], metrics_shm_path, uv_strerror(err));
+      exit(9);
+    }
+    atexit([] () { metrics::Close(); });
+  }
+#endif
+
 #if HAVE_OPENSSL
   if (const char* extra = secure_getenv("NODE_EXTRA_CA_CERTS"))
     crypto::UseExtraCaCerts(extra);
@@ -15,12 +15,25 @@
 #define NODE_COUNT_HTTP_CLIENT_RESPONSE() do { } while (false)
 #define NODE_COUNT_HTTP_SERVER_REQUEST() do { } while (false)
 #define NODE_COUNT_HTTP_SERVER_RESPONSE() do { } while (false)
+#define NODE_COUNT_SERVER_CONN_CLOSE() do { } while (false)
+#define NODE_COUNT_SERVER_CONN_OPEN() do { } while (false)
+#ifdef __POSIX__
+// Exported through --metrics-shm, see node_metrics_shm.h.
+#include "node_metrics_shm.h"
+#define NODE_COUNT_NET_BYTES_RECV(bytes)                                      \
+  node::metrics::Add(node::metrics::kNetBytesRecv, bytes)
+#define NODE_COUNT_NET_BYTES_SENT(bytes)                                      \
+  node::metrics::Add(node::metrics::kNetBytesSent, bytes)
+#define NODE_COUNT_PIPE_BYTES_RECV(bytes)                                     \
+  node::metrics::Add(node::metrics::kPipeBytesRecv, bytes)
+#define NODE_COUNT_PIPE_BYTES_SENT(bytes)                                     \
+  node::metrics::Add(node::metrics::kPipeBytesSent, bytes)
+#else
 #define NODE_COUNT_NET_BYTES_RECV(bytes) do { } while (false)
 #define NODE_COUNT_NET_BYTES_SENT(bytes) do { } while (false)
 #define NODE_COUNT_PIPE_BYTES_RECV(bytes) do { } while (false)
 #define NODE_COUNT_PIPE_BYTES_SENT(bytes) do { } while (false)
-#define NODE_COUNT_SERVER_CONN_CLOSE() do { } while (false)
-#define NODE_COUNT_SERVER_CONN_OPEN() do { } while (false)
+#endif  // __POSIX__
 #endif
 
 #include "v8.h"
@@ -3,6 +3,7 @@
 #include "node_crypto.h"
 #include "node_crypto_bio.h"
 #include "node_crypto_groups.h"
+#include "node_crypto_session_cache.h"
 #include "tls_wrap.h"  // TLSWrap
 
 #include "async-wrap.h"
@@ -24,6 +25,11 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #define THROW_AND_RETURN_IF_NOT_STRING_OR_BUFFER(val, prefix)                  \
   do {                                                                         \
     if (!Buffer::HasInstance(val) && !val->IsString()) {                       \
@@ -83,6 +89,7 @@ using v8::PropertyAttribute;
 using v8::PropertyCallbackInfo;
 using v8::ReadOnly;
 using v8::String;
+using v8::Uint32Array;
 using v8::Value;
 
 
@@ -298,6 +305,15 @@ void SecureContext::Initialize(Environment* env, Local<Object> target) {
   env->SetProtoMethod(t,
                       "enableTicketKeyCallback",
                       SecureContext::EnableTicketKeyCallback);
+  env->SetProtoMethod(t,
+                      "enableTicketKeyRotation",
+                      SecureContext::EnableTicketKeyRotation);
+  env->SetProtoMethod(t,
+                      "enableSharedSessionCache",
+                      SecureContext::EnableSharedSessionCache);
+  env->SetProtoMethod(t,
+                      "getCredentialFingerprint",
+                      SecureContext::GetCredentialFingerprint);
   env->SetProtoMethod(t, "getCertificate", SecureContext::GetCertificate<true>);
   env->SetProtoMethod(t, "getIssuer", SecureContext::GetCertificate<false>);
 
@@ -426,6 +442,234 @@ static BIO* LoadBIO(Environment* env, Local<Value> v) {
 }
 
 
+#if OPENSSL_VERSION_NUMBER < 0x10100000L && !defined(OPENSSL_IS_BORINGSSL)
+// This section contains OpenSSL 1.1.0 functions reimplemented for OpenSSL
+// 1.0.2 so that the following code can be written without lots of #if lines.
+
+static int X509_STORE_up_ref(X509_STORE* store) {
+  CRYPTO_add(&store->references, 1, CRYPTO_LOCK_X509_STORE);
+  return 1;
+}
+
+static int X509_up_ref(X509* cert) {
+  CRYPTO_add(&cert->references, 1, CRYPTO_LOCK_X509);
+  return 1;
+}
+#endif  // OPENSSL_VERSION_NUMBER < 0x10100000L && !OPENSSL_IS_BORINGSSL
+
+
+// Parsed credentials, shared by all the SecureContexts of the process.
+//
+// Servers that create a context per SNI name pass the same CA bundles and
+// intermediates over and over again, and parsing PEM dominates the cost of
+// setting a context up.  Keys, certificate chains and CA stores are cached
+// by a digest of their PEM input; certificates are additionally interned by
+// fingerprint, so that an intermediate which appears in many chains is only
+// kept in memory once.
+//
+// Entries count the contexts that use them.  A private key is freed along
+// with the last context that uses it.  Certificate chains and CA stores that
+// no context uses anymore are kept for contexts that are created again later,
+// on a least recently used list of at most kMaxIdleCredentials entries.
+
+static const size_t kMaxIdleCredentials = 256;
+
+template <typename T>
+class CredentialCache {
+ public:
+  typedef void (*FreeCallback)(T* value);
+
+  CredentialCache(size_t max_idle, FreeCallback free_callback)
+      : max_idle_(max_idle),
+        free_callback_(free_callback) {}
+
+  // Returns the entry for |digest| without counting a user, nullptr if there
+  // is none.
+  T* Find(const std::string& digest) {
+    auto it = entries_.find(digest);
+    return it == entries_.end() ? nullptr : &it->second.value;
+  }
+
+  // Returns the entry for |digest| and counts another user, nullptr if there
+  // is none.
+  T* Acquire(const std::string& digest) {
+    auto it = entries_.find(digest);
+    if (it == entries_.end())
+      return nullptr;
+    Entry& entry = it->second;
+    if (entry.users++ == 0)
+      idle_.erase(entry.idle);
+    return &entry.value;
+  }
+
+  // Adds an entry for |digest| with a single user.
+  T* Insert(const std::string& digest, const T& value) {
+    Entry entry;
+    entry.value = value;
+    entry.users = 1;
+    auto result = entries_.emplace(digest, entry);
+    CHECK(result.second);
+    return &result.first->second.value;
+  }
+
+  void Release(const std::string& digest) {
+    auto it = entries_.find(digest);
+    CHECK(it != entries_.end());
+    Entry& entry = it->second;
+    CHECK_GT(entry.users, 0);
+    if (--entry.users > 0)
+      return;
+
+    if (max_idle_ == 0) {
+      free_callback_(&entry.value);
+      entries_.erase(it);
+      return;
+    }
+
+    entry.idle = idle_.insert(idle_.end(), digest);
+    if (idle_.size() > max_idle_) {
+      auto oldest = entries_.find(idle_.front());
+      idle_.pop_front();
+      free_callback_(&oldest->second.value);
+      entries_.erase(oldest);
+    }
+  }
+
+ private:
+  struct Entry {
+    T value;
+    size_t users;
+    std::list<std::string>::iterator idle;  // Valid while users == 0.
+  };
+
+  std::unordered_map<std::string, Entry> entries_;
+  std::list<std::string> idle_;  // Least recently used first.
+  const size_t max_idle_;
+  const FreeCallback free_callback_;
+};
+
+struct CachedCertChain {
+  X509* cert;
+  STACK_OF(X509)* extra_certs;
+};
+
+struct CachedCertStore {
+  X509_STORE* store;
+  std::vector<X509*> certs;
+};
+
+static CredentialCache<EVP_PKEY*>* key_cache;
+static CredentialCache<CachedCertChain>* cert_chain_cache;
+static CredentialCache<X509*>* cert_cache;
+static CredentialCache<CachedCertStore>* cert_store_cache;
+
+
+static std::string CredentialDigest(const char* data,
+                                    size_t length,
+                                    const char* extra = nullptr,
+                                    size_t extra_length = 0) {
+  EVP_MD_CTX mdctx;
+  EVP_MD_CTX_init(&mdctx);
+  EVP_DigestInit_ex(&mdctx, EVP_sha256(), nullptr);
+  EVP_DigestUpdate(&mdctx, data, length);
+  if (extra != nullptr) {
+    EVP_DigestUpdate(&mdctx, "", 1);
+    EVP_DigestUpdate(&mdctx, extra, extra_length);
+  }
+  unsigned char md[EVP_MAX_MD_SIZE];
+  unsigned int md_len;
+  EVP_DigestFinal_ex(&mdctx, md, &md_len);
+  EVP_MD_CTX_cleanup(&mdctx);
+  return std::string(reinterpret_cast<char*>(md), md_len);
+}
+
+
+// The PEM input the way LoadBIO() reads it.
+static std::string CredentialData(Environment* env, Local<Value> v) {
+  if (v->IsString()) {
+    const node::Utf8Value s(env->isolate(), v);
+    return std::string(*s, s.length());
+  }
+  CHECK(Buffer::HasInstance(v));
+  return std::string(Buffer::Data(v), Buffer::Length(v));
+}
+
+
+// Digests the PEM input the way LoadBIO() reads it.
+static std::string CredentialDigest(Environment* env,
+                                    Local<Value> v,
+                                    const char* extra = nullptr,
+                                    size_t extra_length = 0) {
+  const std::string data = CredentialData(env, v);
+  return CredentialDigest(data.data(), data.size(), extra, extra_length);
+}
+
+
+static std::string CertificateFingerprint(X509* x) {
+  unsigned char md[EVP_MAX_MD_SIZE];
+  unsigned int md_len;
+  CHECK(X509_digest(x, EVP_sha256(), md, &md_len));
+  return std::string(reinterpret_cast<char*>(md), md_len);
+}
+
+
+// Returns the interned copy of |x|, taking over the caller's reference.  The
+// caller owns a reference to the result and gives it back with
+// ReleaseCertificate().
+static X509* InternCertificate(X509* x) {
+  if (cert_cache == nullptr) {
+    cert_cache = new CredentialCache<X509*>(0, [](X509** cert) {
+      X509_free(*cert);
+    });
+  }
+
+  const std::string fingerprint = CertificateFingerprint(x);
+  if (X509** interned = cert_cache->Acquire(fingerprint)) {
+    X509_free(x);
+    X509_up_ref(*interned);
+    return *interned;
+  }
+
+  X509_up_ref(x);
+  cert_cache->Insert(fingerprint, x);
+  return x;
+}
+
+
+static void ReleaseCertificate(X509* x) {
+  cert_cache->Release(CertificateFingerprint(x));
+  X509_free(x);
+}
+
+
+static void FreeCertChain(CachedCertChain* chain) {
+  X509_free(chain->cert);
+  while (X509* x = sk_X509_pop(chain->extra_certs))
+    ReleaseCertificate(x);
+  sk_X509_free(chain->extra_certs);
+}
+
+
+static void FreeCertStore(CachedCertStore* entry) {
+  X509_STORE_free(entry->store);
+  for (X509* cert : entry->certs)
+    ReleaseCertificate(cert);
+}
+
+
+void SecureContext::ReleaseCredentials() {
+  if (!key_digest_.empty())
+    key_cache->Release(key_digest_);
+  if (!cert_chain_digest_.empty())
+    cert_chain_cache->Release(cert_chain_digest_);
+  if (!cert_store_digest_.empty())
+    cert_store_cache->Release(cert_store_digest_);
+  key_digest_.clear();
+  cert_chain_digest_.clear();
+  cert_store_digest_.clear();
+}
+
+
 void SecureContext::SetKey(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
 
@@ -454,30 +698,55 @@ void SecureContext::SetKey(const FunctionCallbackInfo<Value>& args) {
 
   node::Utf8Value passphrase(env->isolate(), args[1]);
 
-  EVP_PKEY* key = PEM_read_bio_PrivateKey(bio,
-                                          nullptr,
-                                          CryptoPemCallback,
-                                          len == 1 ? nullptr : *passphrase);
+  if (key_cache == nullptr) {
+    key_cache = new CredentialCache<EVP_PKEY*>(0, [](EVP_PKEY** key) {
+      EVP_PKEY_free(*key);
+    });
+  }
 
-  if (!key) {
-    BIO_free_all(bio);
-    unsigned long err = ERR_get_error();  // NOLINT(runtime/int)
-    if (!err) {
-      return env->ThrowError("PEM_read_bio_PrivateKey");
+  // The pass phrase is part of the digest, a key is only found again with
+  // the pass phrase that decrypted it.
+  const std::string digest =
+      CredentialDigest(env,
+                       args[0],
+                       len == 1 ? nullptr : *passphrase,
+                       len == 1 ? 0 : passphrase.length());
+
+  EVP_PKEY* key;
+  if (EVP_PKEY** cached = key_cache->Acquire(digest)) {
+    key = *cached;
+  } else {
+    key = PEM_read_bio_PrivateKey(bio,
+                                  nullptr,
+                                  CryptoPemCallback,
+                                  len == 1 ? nullptr : *passphrase);
+
+    if (!key) {
+      BIO_free_all(bio);
+      unsigned long err = ERR_get_error();  // NOLINT(runtime/int)
+      if (!err) {
+        return env->ThrowError("PEM_read_bio_PrivateKey");
+      }
+      return ThrowCryptoError(env, err);
     }
-    return ThrowCryptoError(env, err);
+
+    key_cache->Insert(digest, key);
   }
 
   int rv = SSL_CTX_use_PrivateKey(sc->ctx_, key);
-  EVP_PKEY_free(key);
   BIO_free_all(bio);
 
   if (!rv) {
+    key_cache->Release(digest);
     unsigned long err = ERR_get_error();  // NOLINT(runtime/int)
     if (!err)
       return env->ThrowError("SSL_CTX_use_PrivateKey");
     return ThrowCryptoError(env, err);
   }
+
+  if (!sc->key_digest_.empty())
+    key_cache->Release(sc->key_digest_);
+  sc->key_digest_ = digest;
 }
 
 
@@ -549,19 +818,14 @@ int SSL_CTX_use_certificate_chain(SSL_CTX* ctx,
       // no need to free `store`
     } else {
       // Increment issuer reference count
-      *issuer = X509_dup(*issuer);
-      if (*issuer == nullptr) {
-        ret = 0;
-        goto end;
-      }
+      X509_up_ref(*issuer);
     }
   }
 
  end:
   if (ret && x != nullptr) {
-    *cert = X509_dup(x);
-    if (*cert == nullptr)
-      ret = 0;
+    X509_up_ref(x);
+    *cert = x;
   }
   return ret;
 }
@@ -572,10 +836,9 @@ int SSL_CTX_use_certificate_chain(SSL_CTX* ctx,
 // sent to the peer in the Certificate message.
 //
 // Taken from OpenSSL - edited for style.
-int SSL_CTX_use_certificate_chain(SSL_CTX* ctx,
-                                  BIO* in,
-                                  X509** cert,
-                                  X509** issuer) {
+static int ReadCertificateChain(BIO* in,
+                                X509** cert,
+                                STACK_OF(X509)** chain) {
   X509* x = nullptr;
 
   // Just to ensure that `ERR_peek_last_error` below will return only errors
@@ -601,6 +864,8 @@ int SSL_CTX_use_certificate_chain(SSL_CTX* ctx,
   }
 
   while ((extra = PEM_read_bio_X509(in, nullptr, CryptoPemCallback, nullptr))) {
+    // Intermediates tend to be the same for many certificates.
+    extra = InternCertificate(extra);
     if (sk_X509_push(extra_certs, extra))
       continue;
 
@@ -619,15 +884,20 @@ int SSL_CTX_use_certificate_chain(SSL_CTX* ctx,
     goto done;
   }
 
-  ret = SSL_CTX_use_certificate_chain(ctx, x, extra_certs, cert, issuer);
-  if (!ret)
-    goto done;
+  *cert = x;
+  *chain = extra_certs;
+  x = nullptr;
+  extra_certs = nullptr;
+  ret = 1;
 
  done:
-  if (extra_certs != nullptr)
-    sk_X509_pop_free(extra_certs, X509_free);
+  if (extra_certs != nullptr) {
+    while (X509* ca = sk_X509_pop(extra_certs))
+      ReleaseCertificate(ca);
+    sk_X509_free(extra_certs);
+  }
   if (extra != nullptr)
-    X509_free(extra);
+    ReleaseCertificate(extra);
   if (x != nullptr)
     X509_free(x);
 
@@ -659,37 +929,51 @@ void SecureContext::SetCert(const FunctionCallbackInfo<Value>& args) {
     sc->cert_ = nullptr;
   }
 
+  if (cert_chain_cache == nullptr) {
+    cert_chain_cache =
+        new CredentialCache<CachedCertChain>(kMaxIdleCredentials,
+                                             FreeCertChain);
+  }
+
+  const std::string digest = CredentialDigest(env, args[0]);
+  CachedCertChain* chain = cert_chain_cache->Acquire(digest);
+  if (chain == nullptr) {
+    CachedCertChain entry;
+    if (!ReadCertificateChain(bio, &entry.cert, &entry.extra_certs)) {
+      BIO_free_all(bio);
+      unsigned long err = ERR_get_error();  // NOLINT(runtime/int)
+      if (!err) {
+        return env->ThrowError("SSL_CTX_use_certificate_chain");
+      }
+      return ThrowCryptoError(env, err);
+    }
+    chain = cert_chain_cache->Insert(digest, entry);
+  }
+
+  // The issuer is looked up in the store.
+  sc->BuildCertStore();
+
   int rv = SSL_CTX_use_certificate_chain(sc->ctx_,
-                                         bio,
+                                         chain->cert,
+                                         chain->extra_certs,
                                          &sc->cert_,
                                          &sc->issuer_);
 
   BIO_free_all(bio);
 
   if (!rv) {
+    cert_chain_cache->Release(digest);
     unsigned long err = ERR_get_error();  // NOLINT(runtime/int)
     if (!err) {
       return env->ThrowError("SSL_CTX_use_certificate_chain");
     }
     return ThrowCryptoError(env, err);
   }
-}
-
-
-#if OPENSSL_VERSION_NUMBER < 0x10100000L && !defined(OPENSSL_IS_BORINGSSL)
-// This section contains OpenSSL 1.1.0 functions reimplemented for OpenSSL
-// 1.0.2 so that the following code can be written without lots of #if lines.
-
-static int X509_STORE_up_ref(X509_STORE* store) {
-  CRYPTO_add(&store->references, 1, CRYPTO_LOCK_X509_STORE);
-  return 1;
-}
 
-static int X509_up_ref(X509* cert) {
-  CRYPTO_add(&cert->references, 1, CRYPTO_LOCK_X509);
-  return 1;
+  if (!sc->cert_chain_digest_.empty())
+    cert_chain_cache->Release(sc->cert_chain_digest_);
+  sc->cert_chain_digest_ = digest;
 }
-#endif  // OPENSSL_VERSION_NUMBER < 0x10100000L && !OPENSSL_IS_BORINGSSL
 
 
 static X509_STORE* NewRootCertStore() {
@@ -718,6 +1002,32 @@ static X509_STORE* NewRootCertStore() {
 }
 
 
+// Returns the certificate store of |sc| in a state in which it can be
+// modified without affecting other contexts.
+static X509_STORE* WritableCertStore(SecureContext* sc) {
+  sc->BuildCertStore();
+
+  X509_STORE* cert_store = SSL_CTX_get_cert_store(sc->ctx_);
+
+  if (cert_store == root_cert_store) {
+    cert_store = NewRootCertStore();
+    SSL_CTX_set_cert_store(sc->ctx_, cert_store);
+  } else if (!sc->cert_store_digest_.empty()) {
+    // Shared through cert_store_cache, make a copy.
+    const CachedCertStore* shared =
+        cert_store_cache->Find(sc->cert_store_digest_);
+    cert_store = X509_STORE_new();
+    for (X509* cert : shared->certs)
+      X509_STORE_add_cert(cert_store, cert);
+    SSL_CTX_set_cert_store(sc->ctx_, cert_store);
+    cert_store_cache->Release(sc->cert_store_digest_);
+    sc->cert_store_digest_.clear();
+  }
+
+  return cert_store;
+}
+
+
 void SecureContext::AddCACert(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
 
@@ -730,27 +1040,92 @@ void SecureContext::AddCACert(const FunctionCallbackInfo<Value>& args) {
     return env->ThrowTypeError("CA certificate argument is mandatory");
   }
 
+  // Contexts that are given the same CAs, in the same order, share a store.
+  // That only works while the store holds nothing but CAs from addCACert(),
+  // so they are collected and parsed by BuildCertStore() once the context is
+  // used.
+  X509_STORE* cert_store = SSL_CTX_get_cert_store(sc->ctx_);
+  if (!sc->pending_ca_certs_.empty() ||
+      (sc->cert_store_digest_.empty() &&
+       cert_store != root_cert_store &&
+       sk_X509_OBJECT_num(cert_store->objs) == 0)) {
+    if (!args[0]->IsString() && !Buffer::HasInstance(args[0])) {
+      return env->ThrowTypeError("Not a string or buffer");
+    }
+    sc->pending_ca_certs_.push_back(CredentialData(env, args[0]));
+    const std::string& pem = sc->pending_ca_certs_.back();
+    const std::string pem_digest = CredentialDigest(pem.data(), pem.size());
+    sc->pending_ca_digest_ = CredentialDigest(sc->pending_ca_digest_.data(),
+                                              sc->pending_ca_digest_.size(),
+                                              pem_digest.data(),
+                                              pem_digest.size());
+    return;
+  }
+
   BIO* bio = LoadBIO(env, args[0]);
   if (!bio) {
     return;
   }
 
-  X509_STORE* cert_store = SSL_CTX_get_cert_store(sc->ctx_);
   while (X509* x509 =
              PEM_read_bio_X509(bio, nullptr, CryptoPemCallback, nullptr)) {
-    if (cert_store == root_cert_store) {
-      cert_store = NewRootCertStore();
-      SSL_CTX_set_cert_store(sc->ctx_, cert_store);
-    }
-    X509_STORE_add_cert(cert_store, x509);
+    X509_STORE_add_cert(WritableCertStore(sc), x509);
     SSL_CTX_add_client_CA(sc->ctx_, x509);
     X509_free(x509);
   }
-
   BIO_free_all(bio);
 }
 
 
+// Turns the CAs collected by AddCACert() into the store of the context,
+// shared with the contexts that were given the same CAs.
+void SecureContext::BuildCertStore() {
+  if (pending_ca_certs_.empty())
+    return;
+
+  ClearErrorOnReturn clear_error_on_return;
+  (void) &clear_error_on_return;  // Silence compiler warning.
+
+  if (cert_store_cache == nullptr) {
+    cert_store_cache =
+        new CredentialCache<CachedCertStore>(kMaxIdleCredentials,
+                                             FreeCertStore);
+  }
+
+  const std::string digest = pending_ca_digest_;
+  CachedCertStore* entry = cert_store_cache->Acquire(digest);
+  if (entry == nullptr) {
+    CachedCertStore parsed;
+    for (const std::string& pem : pending_ca_certs_) {
+      BIO* bio = NodeBIO::NewFixed(pem.data(), pem.size());
+      while (X509* x509 =
+                 PEM_read_bio_X509(bio, nullptr, CryptoPemCallback, nullptr)) {
+        parsed.certs.push_back(InternCertificate(x509));
+      }
+      BIO_free_all(bio);
+    }
+    pending_ca_certs_.clear();
+    pending_ca_digest_.clear();
+    if (parsed.certs.empty())
+      return;
+
+    parsed.store = X509_STORE_new();
+    for (X509* cert : parsed.certs)
+      X509_STORE_add_cert(parsed.store, cert);
+    entry = cert_store_cache->Insert(digest, parsed);
+  } else {
+    pending_ca_certs_.clear();
+    pending_ca_digest_.clear();
+  }
+
+  for (X509* cert : entry->certs)
+    SSL_CTX_add_client_CA(ctx_, cert);
+  X509_STORE_up_ref(entry->store);
+  SSL_CTX_set_cert_store(ctx_, entry->store);
+  cert_store_digest_ = digest;
+}
+
+
 void SecureContext::AddCRL(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
 
@@ -776,12 +1151,7 @@ void SecureContext::AddCRL(const FunctionCallbackInfo<Value>& args) {
     return env->ThrowError("Failed to parse CRL");
   }
 
-  X509_STORE* cert_store = SSL_CTX_get_cert_store(sc->ctx_);
-  if (cert_store == root_cert_store) {
-    cert_store = NewRootCertStore();
-    SSL_CTX_set_cert_store(sc->ctx_, cert_store);
-  }
-
+  X509_STORE* cert_store = WritableCertStore(sc);
   X509_STORE_add_crl(cert_store, crl);
   X509_STORE_set_flags(cert_store,
                        X509_V_FLAG_CRL_CHECK | X509_V_FLAG_CRL_CHECK_ALL);
@@ -849,6 +1219,10 @@ void SecureContext::AddRootCerts(const FunctionCallbackInfo<Value>& args) {
   // Increment reference count so global store is not deleted along with CTX.
   X509_STORE_up_ref(root_cert_store);
   SSL_CTX_set_cert_store(sc->ctx_, root_cert_store);
+  if (!sc->cert_store_digest_.empty()) {
+    cert_store_cache->Release(sc->cert_store_digest_);
+    sc->cert_store_digest_.clear();
+  }
 }
 
 
@@ -1058,7 +1432,8 @@ void SecureContext::LoadPKCS12(const FunctionCallbackInfo<Value>& args) {
     sc->cert_ = nullptr;
   }
 
-  X509_STORE* cert_store = SSL_CTX_get_cert_store(sc->ctx_);
+  // The issuer is looked up in the store.
+  sc->BuildCertStore();
 
   if (d2i_PKCS12_bio(in, &p12) &&
       PKCS12_parse(p12, pass, &pkey, &cert, &extra_certs) &&
@@ -1072,13 +1447,18 @@ void SecureContext::LoadPKCS12(const FunctionCallbackInfo<Value>& args) {
     for (int i = 0; i < sk_X509_num(extra_certs); i++) {
       X509* ca = sk_X509_value(extra_certs, i);
 
-      if (cert_store == root_cert_store) {
-        cert_store = NewRootCertStore();
-        SSL_CTX_set_cert_store(sc->ctx_, cert_store);
-      }
-      X509_STORE_add_cert(cert_store, ca);
+      X509_STORE_add_cert(WritableCertStore(sc), ca);
       SSL_CTX_add_client_CA(sc->ctx_, ca);
     }
+    // The key and certificate are no longer the cached ones.
+    if (!sc->key_digest_.empty()) {
+      key_cache->Release(sc->key_digest_);
+      sc->key_digest_.clear();
+    }
+    if (!sc->cert_chain_digest_.empty()) {
+      cert_chain_cache->Release(sc->cert_chain_digest_);
+      sc->cert_chain_digest_.clear();
+    }
     ret = true;
   }
 
@@ -1141,6 +1521,11 @@ void SecureContext::SetTicketKeys(const FunctionCallbackInfo<Value>& args) {
     return env->ThrowError("Failed to fetch tls ticket keys");
   }
 
+  // Keep a rotating key ring in step with the keys that it is derived from.
+  memcpy(wrap->ticket_key_secret_, Buffer::Data(args[0]),
+         sizeof(wrap->ticket_key_secret_));
+  wrap->ticket_keys_derived_ = false;
+
   args.GetReturnValue().Set(true);
 #endif  // !def(OPENSSL_NO_TLSEXT) && def(SSL_CTX_get_tlsext_ticket_keys)
 }
@@ -1163,6 +1548,104 @@ void SecureContext::EnableTicketKeyCallback(
 }
 
 
+void SecureContext::EnableTicketKeyRotation(
+    const FunctionCallbackInfo<Value>& args) {
+#if !defined(OPENSSL_NO_TLSEXT) && defined(SSL_CTX_get_tlsext_ticket_keys)
+  SecureContext* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+
+  CHECK(args[0]->IsUint32());
+  CHECK(args[1]->IsUint32());
+  const uint32_t interval = args[0]->Uint32Value();
+  const uint32_t previous = args[1]->Uint32Value();
+  CHECK_GT(interval, 0);
+  CHECK_LT(previous, kMaxTicketKeys);
+
+  // The current ticket keys, random unless setTicketKeys() was called, seed
+  // the ring.  Cluster workers share them, see Server#_getServerData().
+  if (SSL_CTX_get_tlsext_ticket_keys(wrap->ctx_,
+                                     wrap->ticket_key_secret_,
+                                     sizeof(wrap->ticket_key_secret_)) != 1) {
+    return wrap->env()->ThrowError("Failed to fetch tls ticket keys");
+  }
+  wrap->ticket_key_interval_ = interval;
+  wrap->ticket_key_count_ = previous + 1;
+  wrap->ticket_keys_derived_ = false;
+
+  SSL_CTX_set_tlsext_ticket_key_cb(wrap->ctx_, TicketKeyRingCallback);
+#endif  // !def(OPENSSL_NO_TLSEXT) && def(SSL_CTX_get_tlsext_ticket_keys)
+}
+
+
+void SecureContext::EnableSharedSessionCache(
+    const FunctionCallbackInfo<Value>& args) {
+  SecureContext* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+
+  static_assert(sizeof(wrap->shared_session_cache_scope_) ==
+                    session_cache::kSessionCacheScopeLength,
+                "session cache scope length mismatch");
+  CHECK(session_cache::IsOpen());
+  CHECK(Buffer::HasInstance(args[0]));
+  CHECK_EQ(Buffer::Length(args[0]), session_cache::kSessionCacheScopeLength);
+  memcpy(wrap->shared_session_cache_scope_,
+         Buffer::Data(args[0]),
+         session_cache::kSessionCacheScopeLength);
+  wrap->shared_session_cache_ = true;
+}
+
+
+// Digest of the certificate, chain and key that the context serves, for
+// telling apart servers that share a session cache.  The key is represented
+// by its public half, the private key itself never leaves OpenSSL.
+void SecureContext::GetCredentialFingerprint(
+    const FunctionCallbackInfo<Value>& args) {
+  SecureContext* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+  Environment* env = wrap->env();
+
+  EVP_MD_CTX mdctx;
+  EVP_MD_CTX_init(&mdctx);
+  EVP_DigestInit_ex(&mdctx, EVP_sha256(), nullptr);
+
+  unsigned char md[EVP_MAX_MD_SIZE];
+  unsigned int md_len;
+  if (X509* cert = SSL_CTX_get0_certificate(wrap->ctx_)) {
+    if (X509_digest(cert, EVP_sha256(), md, &md_len)) {
+      EVP_DigestUpdate(&mdctx, "c", 1);
+      EVP_DigestUpdate(&mdctx, md, md_len);
+    }
+  }
+
+  STACK_OF(X509)* chain = nullptr;
+  SSL_CTX_get0_chain_certs(wrap->ctx_, &chain);
+  for (int i = 0; i < sk_X509_num(chain); i++) {
+    if (X509_digest(sk_X509_value(chain, i), EVP_sha256(), md, &md_len)) {
+      EVP_DigestUpdate(&mdctx, "x", 1);
+      EVP_DigestUpdate(&mdctx, md, md_len);
+    }
+  }
+
+  if (EVP_PKEY* pkey = SSL_CTX_get0_privatekey(wrap->ctx_)) {
+    int size = i2d_PUBKEY(pkey, nullptr);
+    if (size > 0) {
+      std::vector<unsigned char> der(size);
+      unsigned char* p = der.data();
+      i2d_PUBKEY(pkey, &p);
+      EVP_DigestUpdate(&mdctx, "k", 1);
+      EVP_DigestUpdate(&mdctx, der.data(), der.size());
+    }
+  }
+
+  EVP_DigestFinal_ex(&mdctx, md, &md_len);
+  EVP_MD_CTX_cleanup(&mdctx);
+
+  Local<Object> buff =
+      Buffer::Copy(env, reinterpret_cast<char*>(md), md_len).ToLocalChecked();
+  args.GetReturnValue().Set(buff);
+}
+
+
 int SecureContext::TicketKeyCallback(SSL* ssl,
                                      unsigned char* name,
                                      unsigned char* iv,
@@ -1242,6 +1725,76 @@ int SecureContext::TicketKeyCallback(SSL* ssl,
 }
 
 
+void SecureContext::DeriveTicketKeys(uint64_t epoch) {
+  static const char kLabel[] = "node tls ticket key";
+  unsigned char message[sizeof(kLabel) + 8];
+  memcpy(message, kLabel, sizeof(kLabel));
+
+  for (uint32_t i = 0; i < ticket_key_count_; i++) {
+    const uint64_t period = epoch - i;
+    for (int j = 0; j < 8; j++)
+      message[sizeof(kLabel) + j] = (period >> (56 - 8 * j)) & 0xff;
+
+    unsigned char key[EVP_MAX_MD_SIZE];
+    unsigned int key_len;
+    HMAC(EVP_sha384(),
+         ticket_key_secret_,
+         sizeof(ticket_key_secret_),
+         message,
+         sizeof(message),
+         key,
+         &key_len);
+    CHECK_EQ(key_len, sizeof(ticket_keys_[i]));
+    memcpy(&ticket_keys_[i], key, sizeof(ticket_keys_[i]));
+  }
+  ticket_key_epoch_ = epoch;
+  ticket_keys_derived_ = true;
+}
+
+
+int SecureContext::TicketKeyRingCallback(SSL* ssl,
+                                         unsigned char* name,
+                                         unsigned char* iv,
+                                         EVP_CIPHER_CTX* ectx,
+                                         HMAC_CTX* hctx,
+                                         int enc) {
+  static const int kTicketPartSize = 16;
+
+  // Tickets are always handled by the context that the connection started
+  // out with, even when SNI switched it over to another one.
+  SecureContext* sc = static_cast<SecureContext*>(
+      SSL_CTX_get_app_data(ssl->initial_ctx));
+
+  // Rotate lazily, the keys only matter when there is a ticket to handle.
+  const uint64_t epoch = time(nullptr) / sc->ticket_key_interval_;
+  if (!sc->ticket_keys_derived_ || epoch != sc->ticket_key_epoch_)
+    sc->DeriveTicketKeys(epoch);
+
+  if (enc) {
+    const TicketKey& key = sc->ticket_keys_[0];
+    if (RAND_bytes(iv, kTicketPartSize) != 1)
+      return -1;
+    memcpy(name, key.name, kTicketPartSize);
+    HMAC_Init_ex(hctx, key.hmac_key, kTicketPartSize, EVP_sha256(), nullptr);
+    EVP_EncryptInit_ex(ectx, EVP_aes_128_cbc(), nullptr, key.aes_key, iv);
+    return 1;
+  }
+
+  for (uint32_t i = 0; i < sc->ticket_key_count_; i++) {
+    const TicketKey& key = sc->ticket_keys_[i];
+    if (memcmp(name, key.name, kTicketPartSize) != 0)
+      continue;
+    HMAC_Init_ex(hctx, key.hmac_key, kTicketPartSize, EVP_sha256(), nullptr);
+    EVP_DecryptInit_ex(ectx, EVP_aes_128_cbc(), nullptr, key.aes_key, iv);
+    // Have tickets from a previous period reissued with the current key.
+    return i == 0 ? 1 : 2;
+  }
+
+  // Unknown or expired key, fall back to a full handshake.
+  return 0;
+}
+
+
 
 
 void SecureContext::CtxGetter(Local<String> property,
@@ -1346,6 +1899,17 @@ void SSLWrap<Base>::InitNPN(SecureContext* sc) {
 }
 
 
+// OpenSSL keeps sessions on the context that the connection started out
+// with, even when SNI switched it over to another one.
+static SecureContext* SharedSessionCacheContext(SSL* s) {
+  SecureContext* sc =
+      static_cast<SecureContext*>(SSL_CTX_get_app_data(s->session_ctx));
+  if (sc == nullptr || !sc->shared_session_cache_)
+    return nullptr;
+  return sc;
+}
+
+
 template <class Base>
 SSL_SESSION* SSLWrap<Base>::GetSessionCallback(SSL* s,
                                                unsigned char* key,
@@ -1357,8 +1921,24 @@ SSL_SESSION* SSLWrap<Base>::GetSessionCallback(SSL* s,
   SSL_SESSION* sess = w->next_sess_;
   w->next_sess_ = nullptr;
 
-  return sess;
-}
+  // Nothing came from the 'resumeSession' listener, if any.  Try the session
+  // cache that is shared with the other cluster workers, without going
+  // through JS.
+  SecureContext* sc;
+  if (sess == nullptr && (sc = SharedSessionCacheContext(s)) != nullptr) {
+    sess = session_cache::Get(sc->shared_session_cache_scope_, key, len);
+    // Don't rely on the scope alone, another server may have picked the
+    // same settings with a different session id context.
+    if (sess != nullptr &&
+        (sess->sid_ctx_length != s->sid_ctx_length ||
+         memcmp(sess->sid_ctx, s->sid_ctx, s->sid_ctx_length) != 0)) {
+      SSL_SESSION_free(sess);
+      sess = nullptr;
+    }
+  }
+
+  return sess;
+}
 
 
 template <class Base>
@@ -1368,6 +1948,9 @@ int SSLWrap<Base>::NewSessionCallback(SSL* s, SSL_SESSION* sess) {
   HandleScope handle_scope(env->isolate());
   Context::Scope context_scope(env->context());
 
+  if (SecureContext* sc = SharedSessionCacheContext(s))
+    session_cache::Add(sc->shared_session_cache_scope_, sess);
+
   if (!w->session_callbacks_)
     return 0;
 
@@ -2528,6 +3111,7 @@ void SSLWrap<Base>::SetSNIContext(SecureContext* sc) {
 
 template <class Base>
 int SSLWrap<Base>::SetCACerts(SecureContext* sc) {
+  sc->BuildCertStore();
   int err = SSL_set1_verify_cert_store(ssl_, SSL_CTX_get_cert_store(sc->ctx_));
   if (err != 1)
     return err;
@@ -3237,7 +3821,9 @@ void CipherBase::Initialize(Environment* env, Local<Object> target) {
   env->SetProtoMethod(t, "init", Init);
   env->SetProtoMethod(t, "initiv", InitIv);
   env->SetProtoMethod(t, "update", Update);
+  env->SetProtoMethod(t, "updateInto", UpdateInto);
   env->SetProtoMethod(t, "final", Final);
+  env->SetProtoMethod(t, "finalInto", FinalInto);
   env->SetProtoMethod(t, "setAutoPadding", SetAutoPadding);
   env->SetProtoMethod(t, "getAuthTag", GetAuthTag);
   env->SetProtoMethod(t, "setAuthTag", SetAuthTag);
@@ -3488,6 +4074,28 @@ bool CipherBase::Update(const char* data,
   if (!initialised_)
     return 0;
 
+  *out = node::Malloc<unsigned char>(UpdateSize(len));
+  return UpdateInto(data, len, *out, out_len);
+}
+
+
+// The most that EVP_CipherUpdate() writes for |len| bytes of input.  Block
+// ciphers can write one block more, when decrypting with padding.
+int CipherBase::UpdateSize(int len) const {
+  int block_size = EVP_CIPHER_CTX_block_size(&ctx_);
+  return block_size == 1 ? len : len + block_size;
+}
+
+
+// |out| must have room for UpdateSize(len) bytes.  It may be the same as
+// |data| but must not overlap it otherwise.
+bool CipherBase::UpdateInto(const char* data,
+                            int len,
+                            unsigned char* out,
+                            int* out_len) {
+  if (!initialised_)
+    return 0;
+
   // on first update:
   if (kind_ == kDecipher && IsAuthenticatedMode() && auth_tag_ != nullptr) {
     EVP_CIPHER_CTX_ctrl(&ctx_,
@@ -3498,10 +4106,9 @@ bool CipherBase::Update(const char* data,
     auth_tag_ = nullptr;
   }
 
-  *out_len = len + EVP_CIPHER_CTX_block_size(&ctx_);
-  *out = new unsigned char[*out_len];
+  *out_len = UpdateSize(len);
   return EVP_CipherUpdate(&ctx_,
-                          *out,
+                          out,
                           out_len,
                           reinterpret_cast<const unsigned char*>(data),
                           len);
@@ -3533,22 +4140,85 @@ void CipherBase::Update(const FunctionCallbackInfo<Value>& args) {
   }
 
   if (!r) {
-    delete[] out;
+    free(out);
     return ThrowCryptoError(env,
                             ERR_get_error(),
                             "Trying to add data in unsupported state");
   }
 
-  CHECK(out != nullptr || out_len == 0);
-  Local<Object> buf =
-      Buffer::Copy(env, reinterpret_cast<char*>(out), out_len).ToLocalChecked();
-  if (out)
-    delete[] out;
+  if (out_len == 0) {
+    free(out);
+    out = nullptr;
+  }
 
+  // The buffer takes over the memory, there is no need to copy it.
+  Local<Object> buf =
+      Buffer::New(env, reinterpret_cast<char*>(out), out_len).ToLocalChecked();
   args.GetReturnValue().Set(buf);
 }
 
 
+// updateInto(data, output, offset)
+//
+// Like update() but writes to |output| at |offset| and returns the number of
+// bytes written.  |data| and |output| may be the same memory.
+void CipherBase::UpdateInto(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  CipherBase* cipher;
+  ASSIGN_OR_RETURN_UNWRAP(&cipher, args.Holder());
+
+  THROW_AND_RETURN_IF_NOT_BUFFER(args[0], "Cipher data");
+  THROW_AND_RETURN_IF_NOT_BUFFER(args[1], "Output");
+
+  const char* data = Buffer::Data(args[0]);
+  size_t len = Buffer::Length(args[0]);
+  char* output = Buffer::Data(args[1]);
+  size_t output_len = Buffer::Length(args[1]);
+  CHECK(args[2]->IsUint32());
+  size_t offset = args[2]->Uint32Value();
+  if (offset > output_len)
+    return env->ThrowRangeError("Offset is out of bounds");
+  output += offset;
+  output_len -= offset;
+
+  if (!cipher->initialised_) {
+    return ThrowCryptoError(env,
+                            ERR_get_error(),
+                            "Trying to add data in unsupported state");
+  }
+  if (static_cast<size_t>(cipher->UpdateSize(len)) > output_len)
+    return env->ThrowRangeError("Output buffer is too small");
+
+  // In place is fine when nothing is buffered between calls, that is for
+  // stream ciphers and modes; otherwise the output would run ahead of the
+  // input it overwrites.
+  char* copy = nullptr;
+  bool overlap = output < data + len && data < output + output_len;
+  if (overlap &&
+      (output != data || EVP_CIPHER_CTX_block_size(&cipher->ctx_) != 1)) {
+    copy = node::Malloc(len);
+    memcpy(copy, data, len);
+    data = copy;
+  }
+
+  int out_len = 0;
+  bool r = cipher->UpdateInto(data,
+                              len,
+                              reinterpret_cast<unsigned char*>(output),
+                              &out_len);
+  free(copy);
+
+  if (!r) {
+    return ThrowCryptoError(env,
+                            ERR_get_error(),
+                            "Trying to add data in unsupported state");
+  }
+
+  args.GetReturnValue().Set(out_len);
+}
+
+
 bool CipherBase::SetAutoPadding(bool auto_padding) {
   if (!initialised_)
     return false;
@@ -3568,7 +4238,23 @@ bool CipherBase::Final(unsigned char** out, int *out_len) {
     return false;
 
   *out = new unsigned char[EVP_CIPHER_CTX_block_size(&ctx_)];
-  int r = EVP_CipherFinal_ex(&ctx_, *out, out_len);
+  return FinalInto(*out, out_len);
+}
+
+
+// The most that EVP_CipherFinal_ex() writes, nothing for stream ciphers.
+int CipherBase::FinalSize() const {
+  int block_size = EVP_CIPHER_CTX_block_size(&ctx_);
+  return block_size == 1 ? 0 : block_size;
+}
+
+
+// |out| must have room for FinalSize() bytes.
+bool CipherBase::FinalInto(unsigned char* out, int *out_len) {
+  if (!initialised_)
+    return false;
+
+  int r = EVP_CipherFinal_ex(&ctx_, out, out_len);
 
   if (r && kind_ == kCipher) {
     delete[] auth_tag_;
@@ -3627,6 +4313,45 @@ void CipherBase::Final(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+// finalInto(output, offset)
+void CipherBase::FinalInto(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  CipherBase* cipher;
+  ASSIGN_OR_RETURN_UNWRAP(&cipher, args.Holder());
+
+  THROW_AND_RETURN_IF_NOT_BUFFER(args[0], "Output");
+
+  char* output = Buffer::Data(args[0]);
+  size_t output_len = Buffer::Length(args[0]);
+  CHECK(args[1]->IsUint32());
+  size_t offset = args[1]->Uint32Value();
+  if (offset > output_len)
+    return env->ThrowRangeError("Offset is out of bounds");
+
+  // Check the state first, FinalSize() needs an initialised context.
+  if (cipher->initialised_ &&
+      static_cast<size_t>(cipher->FinalSize()) > output_len - offset) {
+    return env->ThrowRangeError("Output buffer is too small");
+  }
+
+  int out_len = 0;
+  bool r = cipher->FinalInto(reinterpret_cast<unsigned char*>(output + offset),
+                             &out_len);
+  if (!r) {
+    const char* msg = cipher->IsAuthenticatedMode() ?
+        "Unsupported state or unable to authenticate data" :
+        "Unsupported state";
+
+    return ThrowCryptoError(env,
+                            ERR_get_error(),
+                            msg);
+  }
+
+  args.GetReturnValue().Set(out_len);
+}
+
+
 void Hmac::Initialize(Environment* env, v8::Local<v8::Object> target) {
   Local<FunctionTemplate> t = env->NewFunctionTemplate(New);
 
@@ -3634,8 +4359,11 @@ void Hmac::Initialize(Environment* env, v8::Local<v8::Object> target) {
 
   env->SetProtoMethod(t, "init", HmacInit);
   env->SetProtoMethod(t, "update", HmacUpdate);
+  env->SetProtoMethod(t, "updateAsync", HmacUpdateAsync);
   env->SetProtoMethod(t, "digest", HmacDigest);
+  env->SetProtoMethod(t, "copy", HmacCopy);
 
+  env->set_hmac_constructor_template(t);
   target->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "Hmac"), t->GetFunction());
 }
 
@@ -3646,6 +4374,33 @@ void Hmac::New(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+// Returns a new Hmac that continues from the state of this one.
+void Hmac::HmacCopy(const FunctionCallbackInfo<Value>& args) {
+  Hmac* orig;
+  ASSIGN_OR_RETURN_UNWRAP(&orig, args.Holder());
+  Environment* env = orig->env();
+
+  if (!orig->initialised_)
+    return env->ThrowError("Not initialized");
+  if (orig->pending_)
+    return env->ThrowError("Update in progress");
+
+  Local<Object> obj;
+  if (!env->hmac_constructor_template()->InstanceTemplate()
+          ->NewInstance(env->context()).ToLocal(&obj)) {
+    return;
+  }
+  Hmac* hmac = new Hmac(env, obj);
+  HMAC_CTX_init(&hmac->ctx_);
+  if (!HMAC_CTX_copy(&hmac->ctx_, &orig->ctx_)) {
+    HMAC_CTX_cleanup(&hmac->ctx_);
+    return ThrowCryptoError(env, ERR_get_error(), "Hmac copy failed");
+  }
+  hmac->initialised_ = true;
+  args.GetReturnValue().Set(obj);
+}
+
+
 void Hmac::HmacInit(const char* hash_type, const char* key, int key_len) {
   HandleScope scope(env()->isolate());
 
@@ -3700,6 +4455,10 @@ void Hmac::HmacUpdate(const FunctionCallbackInfo<Value>& args) {
 
   THROW_AND_RETURN_IF_NOT_STRING_OR_BUFFER(args[0], "Data");
 
+  if (hmac->pending_) {
+    return env->ThrowError("Update in progress");
+  }
+
   // Only copy the data if we have to, because it's a string
   bool r;
   if (args[0]->IsString()) {
@@ -3719,11 +4478,17 @@ void Hmac::HmacUpdate(const FunctionCallbackInfo<Value>& args) {
 }
 
 
-bool Hmac::HmacDigest(unsigned char** md_value, unsigned int* md_len) {
+bool Hmac::HmacDigest(unsigned char** md_value,
+                      unsigned int* md_len,
+                      bool reset) {
   if (!initialised_)
     return false;
   *md_value = new unsigned char[EVP_MAX_MD_SIZE];
   HMAC_Final(&ctx_, *md_value, md_len);
+  // Without a key and digest, HMAC_Init_ex() starts over from the key
+  // schedule that the first call computed.
+  if (reset && HMAC_Init_ex(&ctx_, nullptr, 0, nullptr, nullptr))
+    return true;
   HMAC_CTX_cleanup(&ctx_);
   initialised_ = false;
   return true;
@@ -3736,6 +4501,10 @@ void Hmac::HmacDigest(const FunctionCallbackInfo<Value>& args) {
   Hmac* hmac;
   ASSIGN_OR_RETURN_UNWRAP(&hmac, args.Holder());
 
+  if (hmac->pending_) {
+    return env->ThrowError("Update in progress");
+  }
+
   enum encoding encoding = BUFFER;
   if (args.Length() >= 1) {
     encoding = ParseEncoding(env->isolate(),
@@ -3746,7 +4515,7 @@ void Hmac::HmacDigest(const FunctionCallbackInfo<Value>& args) {
   unsigned char* md_value = nullptr;
   unsigned int md_len = 0;
 
-  bool r = hmac->HmacDigest(&md_value, &md_len);
+  bool r = hmac->HmacDigest(&md_value, &md_len, args[1]->IsTrue());
   if (!r) {
     md_value = nullptr;
     md_len = 0;
@@ -3767,8 +4536,11 @@ void Hash::Initialize(Environment* env, v8::Local<v8::Object> target) {
   t->InstanceTemplate()->SetInternalFieldCount(1);
 
   env->SetProtoMethod(t, "update", HashUpdate);
+  env->SetProtoMethod(t, "updateAsync", HashUpdateAsync);
   env->SetProtoMethod(t, "digest", HashDigest);
+  env->SetProtoMethod(t, "copy", HashCopy);
 
+  env->set_hash_constructor_template(t);
   target->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "Hash"), t->GetFunction());
 }
 
@@ -3805,6 +4577,44 @@ bool Hash::HashInit(const char* hash_type) {
 }
 
 
+bool Hash::HashCopy(const Hash* orig) {
+  CHECK_EQ(initialised_, false);
+  EVP_MD_CTX_init(&mdctx_);
+  if (EVP_MD_CTX_copy_ex(&mdctx_, &orig->mdctx_) <= 0) {
+    EVP_MD_CTX_cleanup(&mdctx_);
+    return false;
+  }
+  initialised_ = true;
+  finalized_ = false;
+  return true;
+}
+
+
+// Returns a new Hash that continues from the state of this one.
+void Hash::HashCopy(const FunctionCallbackInfo<Value>& args) {
+  Hash* orig;
+  ASSIGN_OR_RETURN_UNWRAP(&orig, args.Holder());
+  Environment* env = orig->env();
+
+  if (!orig->initialised_)
+    return env->ThrowError("Not initialized");
+  if (orig->finalized_)
+    return env->ThrowError("Digest already called");
+  if (orig->pending_)
+    return env->ThrowError("Update in progress");
+
+  Local<Object> obj;
+  if (!env->hash_constructor_template()->InstanceTemplate()
+          ->NewInstance(env->context()).ToLocal(&obj)) {
+    return;
+  }
+  Hash* hash = new Hash(env, obj);
+  if (!hash->HashCopy(orig))
+    return ThrowCryptoError(env, ERR_get_error(), "Hash copy failed");
+  args.GetReturnValue().Set(obj);
+}
+
+
 bool Hash::HashUpdate(const char* data, int len) {
   if (!initialised_)
     return false;
@@ -3827,6 +4637,9 @@ void Hash::HashUpdate(const FunctionCallbackInfo<Value>& args) {
   if (hash->finalized_) {
     return env->ThrowError("Digest already called");
   }
+  if (hash->pending_) {
+    return env->ThrowError("Update in progress");
+  }
 
   // Only copy the data if we have to, because it's a string
   bool r;
@@ -3859,6 +4672,9 @@ void Hash::HashDigest(const FunctionCallbackInfo<Value>& args) {
   if (hash->finalized_) {
     return env->ThrowError("Digest already called");
   }
+  if (hash->pending_) {
+    return env->ThrowError("Update in progress");
+  }
 
   enum encoding encoding = BUFFER;
   if (args.Length() >= 1) {
@@ -3870,9 +4686,15 @@ void Hash::HashDigest(const FunctionCallbackInfo<Value>& args) {
   unsigned char md_value[EVP_MAX_MD_SIZE];
   unsigned int md_len;
 
+  const EVP_MD* md = EVP_MD_CTX_md(&hash->mdctx_);
   EVP_DigestFinal_ex(&hash->mdctx_, md_value, &md_len);
-  EVP_MD_CTX_cleanup(&hash->mdctx_);
-  hash->finalized_ = true;
+  // With |reset| the hash starts over for the next message, which saves
+  // creating a new one.
+  if (!args[1]->IsTrue() ||
+      EVP_DigestInit_ex(&hash->mdctx_, md, nullptr) <= 0) {
+    EVP_MD_CTX_cleanup(&hash->mdctx_);
+    hash->finalized_ = true;
+  }
 
   Local<Value> rc = StringBytes::Encode(env->isolate(),
                                         reinterpret_cast<const char*>(md_value),
@@ -3882,456 +4704,1333 @@ void Hash::HashDigest(const FunctionCallbackInfo<Value>& args) {
 }
 
 
-void SignBase::CheckThrow(SignBase::Error error) {
-  HandleScope scope(env()->isolate());
-
-  switch (error) {
-    case kSignUnknownDigest:
-      return env()->ThrowError("Unknown message digest");
+// Digests a whole buffer, or feeds it to an existing Hash or Hmac, on the
+// threadpool.  The data is not copied: the buffer and, for updates, the
+// hash object are kept alive through properties of the request object.
+class HashRequest : public AsyncWrap {
+ public:
+  HashRequest(Environment* env,
+              Local<Object> object,
+              const char* data,
+              size_t len,
+              enum encoding encoding)
+      : AsyncWrap(env, object, AsyncWrap::PROVIDER_CRYPTO),
+        md_(nullptr),
+        key_(nullptr),
+        key_len_(0),
+        hash_(nullptr),
+        hmac_(nullptr),
+        data_(data),
+        len_(len),
+        encoding_(encoding),
+        md_len_(0),
+        error_(0) {
+    Wrap(object, this);
+  }
 
-    case kSignNotInitialised:
-      return env()->ThrowError("Not initialised");
+  ~HashRequest() override {
+    if (key_ != nullptr) {
+      OPENSSL_cleanse(key_, key_len_);
+      free(key_);
+    }
+    ClearWrap(object());
+    persistent().Reset();
+  }
 
-    case kSignInit:
-    case kSignUpdate:
-    case kSignPrivateKey:
-    case kSignPublicKey:
-      {
-        unsigned long err = ERR_get_error();  // NOLINT(runtime/int)
-        if (err)
-          return ThrowCryptoError(env(), err);
-        switch (error) {
-          case kSignInit:
-            return env()->ThrowError("EVP_SignInit_ex failed");
-          case kSignUpdate:
-            return env()->ThrowError("EVP_SignUpdate failed");
-          case kSignPrivateKey:
-            return env()->ThrowError("PEM_read_bio_PrivateKey failed");
-          case kSignPublicKey:
-            return env()->ThrowError("PEM_read_bio_PUBKEY failed");
-          default:
-            ABORT();
-        }
-      }
+  uv_work_t* work_req() {
+    return &work_req_;
+  }
 
-    case kSignOk:
-      return;
+  // One-shot digest, or HMAC when a key is given.  Takes ownership of |key|.
+  inline void set_digest(const EVP_MD* md, char* key, int key_len) {
+    md_ = md;
+    key_ = key;
+    key_len_ = key_len;
   }
-}
 
+  inline void set_target(Hash* hash) {
+    hash_ = hash;
+    hash_->pending_ = true;
+  }
 
+  inline void set_target(Hmac* hmac) {
+    hmac_ = hmac;
+    hmac_->pending_ = true;
+  }
 
+  inline bool is_update() const {
+    return hash_ != nullptr || hmac_ != nullptr;
+  }
 
-void Sign::Initialize(Environment* env, v8::Local<v8::Object> target) {
-  Local<FunctionTemplate> t = env->NewFunctionTemplate(New);
+  void DoWork() {
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(data_);
+    bool ok;
+    if (hash_ != nullptr) {
+      ok = hash_->HashUpdate(data_, len_);
+    } else if (hmac_ != nullptr) {
+      ok = hmac_->HmacUpdate(data_, len_);
+    } else if (key_ != nullptr) {
+      ok = HMAC(md_, key_, key_len_, data, len_, md_value_, &md_len_) !=
+           nullptr;
+    } else {
+      ok = EVP_Digest(data, len_, md_value_, &md_len_, md_, nullptr) == 1;
+    }
+    if (!ok)
+      error_ = ERR_get_error();
+  }
+
+  void After(Local<Value> argv[2]) {
+    Isolate* isolate = env()->isolate();
+    // The callback may start the next update right away.
+    if (hash_ != nullptr)
+      hash_->pending_ = false;
+    if (hmac_ != nullptr)
+      hmac_->pending_ = false;
+    if (error_ != 0 || (!is_update() && md_len_ == 0)) {
+      char errmsg[256] = "Digest failed";
+      if (error_ != 0)
+        ERR_error_string_n(error_, errmsg, sizeof errmsg);
+      argv[0] = Exception::Error(OneByteString(isolate, errmsg));
+      argv[1] = Undefined(isolate);
+    } else {
+      argv[0] = Null(isolate);
+      if (is_update()) {
+        argv[1] = Undefined(isolate);
+      } else {
+        argv[1] = StringBytes::Encode(isolate,
+                                      reinterpret_cast<const char*>(md_value_),
+                                      md_len_,
+                                      encoding_);
+      }
+    }
+  }
 
-  t->InstanceTemplate()->SetInternalFieldCount(1);
+  size_t self_size() const override { return sizeof(*this); }
 
-  env->SetProtoMethod(t, "init", SignInit);
-  env->SetProtoMethod(t, "update", SignUpdate);
-  env->SetProtoMethod(t, "sign", SignFinal);
+  uv_work_t work_req_;
 
-  target->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "Sign"), t->GetFunction());
-}
+ private:
+  const EVP_MD* md_;
+  char* key_;
+  int key_len_;
+  Hash* hash_;
+  Hmac* hmac_;
+  const char* data_;
+  size_t len_;
+  enum encoding encoding_;
+  unsigned char md_value_[EVP_MAX_MD_SIZE];
+  unsigned int md_len_;
+  unsigned long error_;  // NOLINT(runtime/int)
+};
 
 
-void Sign::New(const FunctionCallbackInfo<Value>& args) {
-  Environment* env = Environment::GetCurrent(args);
-  new Sign(env, args.This());
+void EIO_Hash(uv_work_t* work_req) {
+  HashRequest* req = ContainerOf(&HashRequest::work_req_, work_req);
+  req->DoWork();
 }
 
 
-SignBase::Error Sign::SignInit(const char* sign_type) {
-  CHECK_EQ(initialised_, false);
-  const EVP_MD* md = EVP_get_digestbyname(sign_type);
-  if (md == nullptr)
-    return kSignUnknownDigest;
-
-  EVP_MD_CTX_init(&mdctx_);
-  if (!EVP_SignInit_ex(&mdctx_, md, nullptr))
-    return kSignInit;
-  initialised_ = true;
-
-  return kSignOk;
+void EIO_HashAfter(uv_work_t* work_req, int status) {
+  CHECK_EQ(status, 0);
+  HashRequest* req = ContainerOf(&HashRequest::work_req_, work_req);
+  Environment* env = req->env();
+  HandleScope handle_scope(env->isolate());
+  Context::Scope context_scope(env->context());
+  Local<Value> argv[2];
+  req->After(argv);
+  req->MakeCallback(env->ondone_string(),
+                    req->is_update() ? 1 : arraysize(argv),
+                    argv);
+  delete req;
 }
 
 
-void Sign::SignInit(const FunctionCallbackInfo<Value>& args) {
-  Sign* sign;
-  ASSIGN_OR_RETURN_UNWRAP(&sign, args.Holder());
-  Environment* env = sign->env();
+static void QueueHashRequest(Environment* env,
+                             HashRequest* req,
+                             Local<Object> obj,
+                             Local<Value> data,
+                             Local<Value> ondone) {
+  obj->Set(env->buffer_string(), data);
+  obj->Set(env->ondone_string(), ondone);
 
-  if (args.Length() == 0) {
-    return env->ThrowError("Sign type argument is mandatory");
-  }
+  if (env->in_domain())
+    obj->Set(env->domain_string(), env->domain_array()->Get(0));
+  uv_queue_work(env->event_loop(),
+                req->work_req(),
+                EIO_Hash,
+                EIO_HashAfter);
+}
 
-  THROW_AND_RETURN_IF_NOT_STRING(args[0], "Sign type");
 
-  const node::Utf8Value sign_type(args.GetIsolate(), args[0]);
-  sign->CheckThrow(sign->SignInit(*sign_type));
-}
+// hash(algorithm, key, data, outputEncoding[, ondone])
+//
+// Digests |data| in one go, without creating a Hash or Hmac object.  |key| is
+// undefined for a plain digest and a buffer for an HMAC.  Without |ondone|
+// the digest is computed right away and returned.
+void OneShotHash(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
 
+  THROW_AND_RETURN_IF_NOT_STRING(args[0], "Hash type");
+  if (!args[1]->IsUndefined())
+    THROW_AND_RETURN_IF_NOT_BUFFER(args[1], "Key");
+  THROW_AND_RETURN_IF_NOT_STRING_OR_BUFFER(args[2], "Data");
 
-SignBase::Error Sign::SignUpdate(const char* data, int len) {
-  if (!initialised_)
-    return kSignNotInitialised;
-  if (!EVP_SignUpdate(&mdctx_, data, len))
-    return kSignUpdate;
-  return kSignOk;
-}
+  const node::Utf8Value hash_type(env->isolate(), args[0]);
+  const EVP_MD* md = EVP_get_digestbyname(*hash_type);
+  if (md == nullptr) {
+    return ThrowCryptoError(env, ERR_get_error(),
+                            "Digest method not supported");
+  }
 
+  enum encoding encoding = ParseEncoding(env->isolate(), args[3], BUFFER);
 
-void Sign::SignUpdate(const FunctionCallbackInfo<Value>& args) {
-  Environment* env = Environment::GetCurrent(args);
+  if (args[4]->IsFunction()) {
+    THROW_AND_RETURN_IF_NOT_BUFFER(args[2], "Data");
 
-  Sign* sign;
-  ASSIGN_OR_RETURN_UNWRAP(&sign, args.Holder());
+    char* key = nullptr;
+    int key_len = 0;
+    if (args[1]->IsObject()) {
+      key_len = Buffer::Length(args[1]);
+      // Never null, so that an empty key still selects HMAC.
+      key = node::Malloc(key_len + 1);
+      memcpy(key, Buffer::Data(args[1]), key_len);
+    }
 
-  THROW_AND_RETURN_IF_NOT_STRING_OR_BUFFER(args[0], "Data");
+    Local<Object> obj = env->NewInternalFieldObject();
+    HashRequest* req = new HashRequest(env,
+                                       obj,
+                                       Buffer::Data(args[2]),
+                                       Buffer::Length(args[2]),
+                                       encoding);
+    req->set_digest(md, key, key_len);
+    QueueHashRequest(env, req, obj, args[2], args[4]);
+    return;
+  }
 
   // Only copy the data if we have to, because it's a string
-  Error err;
-  if (args[0]->IsString()) {
-    StringBytes::InlineDecoder decoder;
-    if (!decoder.Decode(env, args[0].As<String>(), args[1], UTF8))
+  StringBytes::InlineDecoder decoder;
+  const unsigned char* data;
+  size_t len;
+  if (args[2]->IsString()) {
+    if (!decoder.Decode(env, args[2].As<String>(), Undefined(env->isolate()),
+                        UTF8)) {
       return;
-    err = sign->SignUpdate(decoder.out(), decoder.size());
+    }
+    data = reinterpret_cast<const unsigned char*>(decoder.out());
+    len = decoder.size();
   } else {
-    char* buf = Buffer::Data(args[0]);
-    size_t buflen = Buffer::Length(args[0]);
-    err = sign->SignUpdate(buf, buflen);
+    data = reinterpret_cast<const unsigned char*>(Buffer::Data(args[2]));
+    len = Buffer::Length(args[2]);
   }
 
-  sign->CheckThrow(err);
+  unsigned char md_value[EVP_MAX_MD_SIZE];
+  unsigned int md_len = 0;
+  bool ok;
+  if (args[1]->IsObject()) {
+    const char* key = Buffer::Data(args[1]);
+    int key_len = Buffer::Length(args[1]);
+    ok = HMAC(md, key_len == 0 ? "" : key, key_len, data, len,
+              md_value, &md_len) != nullptr;
+  } else {
+    ok = EVP_Digest(data, len, md_value, &md_len, md, nullptr) == 1;
+  }
+  if (!ok)
+    return ThrowCryptoError(env, ERR_get_error(), "Digest failed");
+
+  Local<Value> rc = StringBytes::Encode(env->isolate(),
+                                        reinterpret_cast<const char*>(md_value),
+                                        md_len,
+                                        encoding);
+  args.GetReturnValue().Set(rc);
 }
 
 
-SignBase::Error Sign::SignFinal(const char* key_pem,
-                                int key_pem_len,
-                                const char* passphrase,
-                                unsigned char** sig,
-                                unsigned int *sig_len) {
-  if (!initialised_)
-    return kSignNotInitialised;
+// Digests one message after another with the same algorithm and key, reusing
+// the context between them.  For HMAC that also saves hashing the key pads
+// for every message.
+class BatchDigest {
+ public:
+  BatchDigest(const EVP_MD* md, const char* key, int key_len)
+      : md_(md),
+        hmac_(key != nullptr) {
+    if (hmac_) {
+      HMAC_CTX_init(&hmac_ctx_);
+      ok_ = HMAC_Init_ex(&hmac_ctx_, key_len == 0 ? "" : key, key_len, md,
+                         nullptr) == 1;
+    } else {
+      EVP_MD_CTX_init(&mdctx_);
+      ok_ = true;
+    }
+  }
 
-  BIO* bp = nullptr;
-  EVP_PKEY* pkey = nullptr;
-  bool fatal = true;
+  ~BatchDigest() {
+    if (hmac_)
+      HMAC_CTX_cleanup(&hmac_ctx_);
+    else
+      EVP_MD_CTX_cleanup(&mdctx_);
+  }
+
+  // Writes EVP_MD_size() bytes to |out|.
+  bool Digest(const char* data, size_t len, unsigned char* out) {
+    if (!ok_)
+      return false;
+    const unsigned char* in = reinterpret_cast<const unsigned char*>(data);
+    unsigned int out_len;
+    if (hmac_) {
+      return HMAC_Init_ex(&hmac_ctx_, nullptr, 0, nullptr, nullptr) == 1 &&
+             HMAC_Update(&hmac_ctx_, in, len) == 1 &&
+             HMAC_Final(&hmac_ctx_, out, &out_len) == 1;
+    }
+    return EVP_DigestInit_ex(&mdctx_, md_, nullptr) == 1 &&
+           EVP_DigestUpdate(&mdctx_, in, len) == 1 &&
+           EVP_DigestFinal_ex(&mdctx_, out, &out_len) == 1;
+  }
 
-  bp = BIO_new_mem_buf(const_cast<char*>(key_pem), key_pem_len);
-  if (bp == nullptr)
-    goto exit;
+ private:
+  const EVP_MD* md_;
+  const bool hmac_;
+  bool ok_;
+  EVP_MD_CTX mdctx_;
+  HMAC_CTX hmac_ctx_;
+};
 
-  pkey = PEM_read_bio_PrivateKey(bp,
-                                 nullptr,
-                                 CryptoPemCallback,
-                                 const_cast<char*>(passphrase));
 
-  // Errors might be injected into OpenSSL's error stack
-  // without `pkey` being set to nullptr;
-  // cf. the test of `test_bad_rsa_privkey.pem` for an example.
-  if (pkey == nullptr || 0 != ERR_peek_error())
-    goto exit;
+// Splits a batch into jobs of about this many bytes, so that large batches
+// are spread over the threadpool.  Every message counts for at least
+// kHashManyMessageCost bytes, for the fixed cost of a digest.
+static const size_t kHashManyBytesPerJob = 256 * 1024;
+static const size_t kHashManyMessageCost = 128;
+static const size_t kHashManyMaxJobs = 16;
 
-#ifdef NODE_FIPS_MODE
-  /* Validate DSA2 parameters from FIPS 186-4 */
-  if (FIPS_mode() && EVP_PKEY_DSA == pkey->type) {
-    size_t L = BN_num_bits(pkey->pkey.dsa->p);
-    size_t N = BN_num_bits(pkey->pkey.dsa->q);
-    bool result = false;
+class HashManyRequest : public AsyncWrap {
+ public:
+  struct Message {
+    const char* data;
+    size_t len;
+  };
 
-    if (L == 1024 && N == 160)
-      result = true;
-    else if (L == 2048 && N == 224)
-      result = true;
-    else if (L == 2048 && N == 256)
-      result = true;
-    else if (L == 3072 && N == 256)
-      result = true;
+  struct Job {
+    uv_work_t work_req;
+    HashManyRequest* req;
+    size_t begin;
+    size_t end;
+    bool ok;
+  };
 
-    if (!result) {
-      fatal = true;
-      goto exit;
+  HashManyRequest(Environment* env,
+                  Local<Object> object,
+                  const EVP_MD* md,
+                  char* key,
+                  int key_len,
+                  std::vector<Message>* messages,
+                  enum encoding encoding)
+      : AsyncWrap(env, object, AsyncWrap::PROVIDER_CRYPTO),
+        md_(md),
+        md_size_(EVP_MD_size(md)),
+        key_(key),
+        key_len_(key_len),
+        encoding_(encoding),
+        out_(nullptr),
+        pending_jobs_(0) {
+    messages_.swap(*messages);
+    out_ = node::Malloc<unsigned char>(messages_.size() * md_size_);
+    Wrap(object, this);
+  }
+
+  ~HashManyRequest() override {
+    if (key_ != nullptr) {
+      OPENSSL_cleanse(key_, key_len_);
+      free(key_);
     }
+    free(out_);
+    ClearWrap(object());
+    persistent().Reset();
   }
-#endif  // NODE_FIPS_MODE
 
-  if (EVP_SignFinal(&mdctx_, *sig, sig_len, pkey))
-    fatal = false;
+  void Queue() {
+    size_t cost = 0;
+    for (const Message& message : messages_)
+      cost += message.len + kHashManyMessageCost;
+    size_t jobs = cost / kHashManyBytesPerJob;
+    if (jobs < 1)
+      jobs = 1;
+    if (jobs > kHashManyMaxJobs)
+      jobs = kHashManyMaxJobs;
+    if (jobs > messages_.size() && messages_.size() > 0)
+      jobs = messages_.size();
+
+    // Cut the batch into runs of roughly equal cost.
+    jobs_.resize(jobs);
+    size_t per_job = cost / jobs + 1;
+    size_t begin = 0;
+    for (size_t i = 0; i < jobs; i++) {
+      size_t end = begin;
+      size_t job_cost = 0;
+      while (end < messages_.size() &&
+             (job_cost < per_job || i == jobs - 1)) {
+        job_cost += messages_[end].len + kHashManyMessageCost;
+        end++;
+      }
+      jobs_[i].req = this;
+      jobs_[i].begin = begin;
+      jobs_[i].end = end;
+      jobs_[i].ok = false;
+      begin = end;
+    }
 
-  initialised_ = false;
+    pending_jobs_ = jobs;
+    for (Job& job : jobs_)
+      uv_queue_work(env()->event_loop(), &job.work_req, DoWork, AfterWork);
+  }
+
+  // Turns |count| packed digests into one Buffer, which takes over |*out|,
+  // or into an array of strings.
+  static Local<Value> EncodeDigests(Environment* env,
+                                    unsigned char** out,
+                                    size_t count,
+                                    int md_size,
+                                    enum encoding encoding) {
+    if (encoding == BUFFER) {
+      char* data = reinterpret_cast<char*>(*out);
+      *out = nullptr;
+      return Buffer::New(env, data, count * md_size).ToLocalChecked();
+    }
+    Local<Array> digests = Array::New(env->isolate(), count);
+    for (size_t i = 0; i < count; i++) {
+      const char* digest = reinterpret_cast<const char*>(*out + i * md_size);
+      digests->Set(env->context(),
+                   i,
+                   StringBytes::Encode(env->isolate(),
+                                       digest,
+                                       md_size,
+                                       encoding)).FromJust();
+    }
+    return digests;
+  }
 
- exit:
-  if (pkey != nullptr)
-    EVP_PKEY_free(pkey);
-  if (bp != nullptr)
-    BIO_free_all(bp);
+  size_t self_size() const override { return sizeof(*this); }
 
-  EVP_MD_CTX_cleanup(&mdctx_);
+ private:
+  static void DoWork(uv_work_t* work_req) {
+    Job* job = ContainerOf(&Job::work_req, work_req);
+    HashManyRequest* req = job->req;
+    BatchDigest digest(req->md_, req->key_, req->key_len_);
+    job->ok = true;
+    for (size_t i = job->begin; i < job->end && job->ok; i++) {
+      const Message& message = req->messages_[i];
+      job->ok = digest.Digest(message.data,
+                              message.len,
+                              req->out_ + i * req->md_size_);
+    }
+  }
 
-  if (fatal)
-    return kSignPrivateKey;
+  static void AfterWork(uv_work_t* work_req, int status) {
+    CHECK_EQ(status, 0);
+    Job* job = ContainerOf(&Job::work_req, work_req);
+    HashManyRequest* req = job->req;
+    if (--req->pending_jobs_ > 0)
+      return;
 
-  return kSignOk;
-}
+    Environment* env = req->env();
+    HandleScope handle_scope(env->isolate());
+    Context::Scope context_scope(env->context());
+    Local<Value> argv[2];
+    bool ok = true;
+    for (const Job& job : req->jobs_)
+      ok = ok && job.ok;
+    if (ok) {
+      argv[0] = Null(env->isolate());
+      argv[1] = EncodeDigests(env,
+                              &req->out_,
+                              req->messages_.size(),
+                              req->md_size_,
+                              req->encoding_);
+    } else {
+      argv[0] = Exception::Error(OneByteString(env->isolate(),
+                                               "Digest failed"));
+      argv[1] = Undefined(env->isolate());
+    }
+    req->MakeCallback(env->ondone_string(), arraysize(argv), argv);
+    delete req;
+  }
 
+  const EVP_MD* md_;
+  const int md_size_;
+  char* key_;
+  int key_len_;
+  enum encoding encoding_;
+  std::vector<Message> messages_;
+  unsigned char* out_;
+  std::vector<Job> jobs_;
+  size_t pending_jobs_;
+};
 
-void Sign::SignFinal(const FunctionCallbackInfo<Value>& args) {
-  Environment* env = Environment::GetCurrent(args);
 
-  Sign* sign;
-  ASSIGN_OR_RETURN_UNWRAP(&sign, args.Holder());
+// hashMany(algorithm, key, data, offsets, outputEncoding[, ondone])
+//
+// Digests a batch of messages in one call: the elements of the array |data|,
+// or the slices of the buffer |data| between consecutive |offsets|.  |key| is
+// undefined for plain digests and a buffer for HMACs.  The digests are packed
+// into one buffer, or returned as an array of strings when |outputEncoding|
+// is a string encoding.  With |ondone| the digests are computed on the
+// threadpool; the array elements must be buffers then.
+void HashMany(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
 
-  unsigned char* md_value;
-  unsigned int md_len;
+  THROW_AND_RETURN_IF_NOT_STRING(args[0], "Hash type");
+  if (!args[1]->IsUndefined())
+    THROW_AND_RETURN_IF_NOT_BUFFER(args[1], "Key");
 
-  unsigned int len = args.Length();
-  enum encoding encoding = BUFFER;
-  if (len >= 2 && args[1]->IsString()) {
-    encoding = ParseEncoding(env->isolate(),
-                             args[1]->ToString(env->isolate()),
-                             BUFFER);
+  const node::Utf8Value hash_type(env->isolate(), args[0]);
+  const EVP_MD* md = EVP_get_digestbyname(*hash_type);
+  if (md == nullptr) {
+    return ThrowCryptoError(env, ERR_get_error(),
+                            "Digest method not supported");
+  }
+  const int md_size = EVP_MD_size(md);
+
+  enum encoding encoding = ParseEncoding(env->isolate(), args[4], BUFFER);
+  const bool async = args[5]->IsFunction();
+
+  // Collect the messages, except for strings in synchronous calls, which are
+  // decoded and digested one at a time below.
+  std::vector<HashManyRequest::Message> messages;
+  Local<Array> array;
+  if (args[2]->IsArray()) {
+    array = args[2].As<Array>();
+    messages.resize(array->Length());
+    for (size_t i = 0; i < messages.size(); i++) {
+      Local<Value> element = array->Get(i);
+      if (async)
+        THROW_AND_RETURN_IF_NOT_BUFFER(element, "Data");
+      else
+        THROW_AND_RETURN_IF_NOT_STRING_OR_BUFFER(element, "Data");
+      if (element->IsString()) {
+        messages[i].data = nullptr;
+        messages[i].len = 0;
+      } else {
+        messages[i].data = Buffer::Data(element);
+        messages[i].len = Buffer::Length(element);
+      }
+    }
+  } else {
+    THROW_AND_RETURN_IF_NOT_BUFFER(args[2], "Data");
+    CHECK(args[3]->IsUint32Array());
+    const char* data = Buffer::Data(args[2]);
+    size_t length = Buffer::Length(args[2]);
+    Local<Uint32Array> offsets = args[3].As<Uint32Array>();
+    const uint32_t* bounds = reinterpret_cast<const uint32_t*>(
+        static_cast<char*>(offsets->Buffer()->GetContents().Data()) +
+        offsets->ByteOffset());
+    size_t count = offsets->Length() > 0 ? offsets->Length() - 1 : 0;
+    messages.resize(count);
+    for (size_t i = 0; i < count; i++) {
+      if (bounds[i] > bounds[i + 1] || bounds[i + 1] > length) {
+        return env->ThrowRangeError(
+            "Offsets must be ascending and within the buffer");
+      }
+      messages[i].data = data + bounds[i];
+      messages[i].len = bounds[i + 1] - bounds[i];
+    }
   }
 
-  node::Utf8Value passphrase(env->isolate(), args[2]);
-
-  THROW_AND_RETURN_IF_NOT_BUFFER(args[0], "Data");
-  size_t buf_len = Buffer::Length(args[0]);
-  char* buf = Buffer::Data(args[0]);
+  if (async) {
+    char* key = nullptr;
+    int key_len = 0;
+    if (args[1]->IsObject()) {
+      key_len = Buffer::Length(args[1]);
+      // Never null, so that an empty key still selects HMAC.
+      key = node::Malloc(key_len + 1);
+      memcpy(key, Buffer::Data(args[1]), key_len);
+    }
 
-  md_len = 8192;  // Maximum key size is 8192 bits
-  md_value = new unsigned char[md_len];
+    Local<Object> obj = env->NewInternalFieldObject();
+    HashManyRequest* req = new HashManyRequest(env,
+                                               obj,
+                                               md,
+                                               key,
+                                               key_len,
+                                               &messages,
+                                               encoding);
+    obj->Set(env->buffer_string(), args[2]);
+    obj->Set(env->ondone_string(), args[5]);
 
-  ClearErrorOnReturn clear_error_on_return;
-  (void) &clear_error_on_return;  // Silence compiler warning.
+    if (env->in_domain())
+      obj->Set(env->domain_string(), env->domain_array()->Get(0));
+    req->Queue();
+    return;
+  }
 
-  Error err = sign->SignFinal(
-      buf,
-      buf_len,
-      len >= 3 && !args[2]->IsNull() ? *passphrase : nullptr,
-      &md_value,
-      &md_len);
-  if (err != kSignOk) {
-    delete[] md_value;
-    md_value = nullptr;
-    md_len = 0;
-    return sign->CheckThrow(err);
+  BatchDigest digest(md,
+                     args[1]->IsObject() ? Buffer::Data(args[1]) : nullptr,
+                     args[1]->IsObject() ? Buffer::Length(args[1]) : 0);
+  unsigned char* out = node::Malloc<unsigned char>(messages.size() * md_size);
+  for (size_t i = 0; i < messages.size(); i++) {
+    bool ok;
+    Local<Value> element;
+    if (messages[i].data == nullptr && !array.IsEmpty() &&
+        (element = array->Get(i))->IsString()) {
+      StringBytes::InlineDecoder decoder;
+      if (!decoder.Decode(env, element.As<String>(),
+                          Undefined(env->isolate()), UTF8)) {
+        free(out);
+        return;
+      }
+      ok = digest.Digest(decoder.out(), decoder.size(), out + i * md_size);
+    } else {
+      ok = digest.Digest(messages[i].data, messages[i].len, out + i * md_size);
+    }
+    if (!ok) {
+      free(out);
+      return ThrowCryptoError(env, ERR_get_error(), "Digest failed");
+    }
   }
 
-  Local<Value> rc = StringBytes::Encode(env->isolate(),
-                                        reinterpret_cast<const char*>(md_value),
-                                        md_len,
-                                        encoding);
-  delete[] md_value;
+  Local<Value> rc = HashManyRequest::EncodeDigests(env,
+                                                   &out,
+                                                   messages.size(),
+                                                   md_size,
+                                                   encoding);
+  free(out);
   args.GetReturnValue().Set(rc);
 }
 
 
-void Verify::Initialize(Environment* env, v8::Local<v8::Object> target) {
-  Local<FunctionTemplate> t = env->NewFunctionTemplate(New);
+void Hash::HashUpdateAsync(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
 
-  t->InstanceTemplate()->SetInternalFieldCount(1);
+  Hash* hash;
+  ASSIGN_OR_RETURN_UNWRAP(&hash, args.Holder());
 
-  env->SetProtoMethod(t, "init", VerifyInit);
-  env->SetProtoMethod(t, "update", VerifyUpdate);
-  env->SetProtoMethod(t, "verify", VerifyFinal);
+  THROW_AND_RETURN_IF_NOT_BUFFER(args[0], "Data");
+  CHECK(args[1]->IsFunction());
 
-  target->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "Verify"),
-              t->GetFunction());
+  if (!hash->initialised_) {
+    return env->ThrowError("Not initialized");
+  }
+  if (hash->finalized_) {
+    return env->ThrowError("Digest already called");
+  }
+  if (hash->pending_) {
+    return env->ThrowError("Update in progress");
+  }
+
+  Local<Object> obj = env->NewInternalFieldObject();
+  HashRequest* req = new HashRequest(env,
+                                     obj,
+                                     Buffer::Data(args[0]),
+                                     Buffer::Length(args[0]),
+                                     BUFFER);
+  req->set_target(hash);
+  obj->Set(env->handle_string(), args.Holder());
+  QueueHashRequest(env, req, obj, args[0], args[1]);
 }
 
 
-void Verify::New(const FunctionCallbackInfo<Value>& args) {
+void Hmac::HmacUpdateAsync(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
-  new Verify(env, args.This());
-}
 
+  Hmac* hmac;
+  ASSIGN_OR_RETURN_UNWRAP(&hmac, args.Holder());
 
-SignBase::Error Verify::VerifyInit(const char* verify_type) {
-  CHECK_EQ(initialised_, false);
-  const EVP_MD* md = EVP_get_digestbyname(verify_type);
-  if (md == nullptr)
-    return kSignUnknownDigest;
+  THROW_AND_RETURN_IF_NOT_BUFFER(args[0], "Data");
+  CHECK(args[1]->IsFunction());
 
-  EVP_MD_CTX_init(&mdctx_);
-  if (!EVP_VerifyInit_ex(&mdctx_, md, nullptr))
-    return kSignInit;
-  initialised_ = true;
+  if (!hmac->initialised_) {
+    return env->ThrowTypeError("HmacUpdate fail");
+  }
+  if (hmac->pending_) {
+    return env->ThrowError("Update in progress");
+  }
 
-  return kSignOk;
+  Local<Object> obj = env->NewInternalFieldObject();
+  HashRequest* req = new HashRequest(env,
+                                     obj,
+                                     Buffer::Data(args[0]),
+                                     Buffer::Length(args[0]),
+                                     BUFFER);
+  req->set_target(hmac);
+  obj->Set(env->handle_string(), args.Holder());
+  QueueHashRequest(env, req, obj, args[0], args[1]);
 }
 
 
-void Verify::VerifyInit(const FunctionCallbackInfo<Value>& args) {
-  Verify* verify;
-  ASSIGN_OR_RETURN_UNWRAP(&verify, args.Holder());
-  Environment* env = verify->env();
+void SignBase::CheckThrow(SignBase::Error error) {
+  if (error == kSignOk)
+    return;
 
-  if (args.Length() == 0) {
-    return env->ThrowError("Verify type argument is mandatory");
+  HandleScope scope(env()->isolate());
+
+  unsigned long err = 0;  // NOLINT(runtime/int)
+  if (error != kSignUnknownDigest &&
+      error != kSignNotInitialised &&
+      error != kSignPending) {
+    err = ERR_get_error();
   }
+  env()->isolate()->ThrowException(ErrorValue(error, err));
+}
 
-  THROW_AND_RETURN_IF_NOT_STRING(args[0], "Verify type");
 
-  const node::Utf8Value verify_type(args.GetIsolate(), args[0]);
-  verify->CheckThrow(verify->VerifyInit(*verify_type));
-}
+// |err| is the OpenSSL error that came with |error|, if any.  It is passed in
+// because a sign or verify operation that ran on the threadpool left it in the
+// error queue of another thread.
+Local<Value> SignBase::ErrorValue(SignBase::Error error,
+                                  unsigned long err) {  // NOLINT(runtime/int)
+  char errmsg[128] = { 0 };
+  const char* message = nullptr;
+
+  switch (error) {
+    case kSignUnknownDigest:
+      message = "Unknown message digest";
+      break;
 
+    case kSignNotInitialised:
+      message = "Not initialised";
+      break;
 
-SignBase::Error Verify::VerifyUpdate(const char* data, int len) {
-  if (!initialised_)
-    return kSignNotInitialised;
+    case kSignPending:
+      message = "Operation in progress";
+      break;
 
-  if (!EVP_VerifyUpdate(&mdctx_, data, len))
-    return kSignUpdate;
+    case kSignInit:
+    case kSignUpdate:
+    case kSignPrivateKey:
+    case kSignPublicKey:
+      if (err) {
+        ERR_error_string_n(err, errmsg, sizeof(errmsg));
+        message = errmsg;
+        break;
+      }
+      switch (error) {
+        case kSignInit:
+          message = "EVP_SignInit_ex failed";
+          break;
+        case kSignUpdate:
+          message = "EVP_SignUpdate failed";
+          break;
+        case kSignPrivateKey:
+          message = "PEM_read_bio_PrivateKey failed";
+          break;
+        case kSignPublicKey:
+          message = "PEM_read_bio_PUBKEY failed";
+          break;
+        default:
+          ABORT();
+      }
+      break;
 
-  return kSignOk;
+    case kSignOk:
+      ABORT();
+  }
+
+  return Exception::Error(OneByteString(env()->isolate(), message));
 }
 
 
-void Verify::VerifyUpdate(const FunctionCallbackInfo<Value>& args) {
-  Environment* env = Environment::GetCurrent(args);
 
-  Verify* verify;
-  ASSIGN_OR_RETURN_UNWRAP(&verify, args.Holder());
 
-  THROW_AND_RETURN_IF_NOT_STRING_OR_BUFFER(args[0], "Data");
+// Runs the final step of a Sign or Verify object on the threadpool.  The key,
+// pass phrase and signature are copied; the Sign or Verify object is kept
+// alive through the request object and can not be used until it is done.
+class SignRequest : public AsyncWrap {
+ public:
+  SignRequest(Environment* env,
+              Local<Object> object,
+              const char* key,
+              int key_len,
+              enum encoding encoding)
+      : AsyncWrap(env, object, AsyncWrap::PROVIDER_CRYPTO),
+        sign_(nullptr),
+        verify_(nullptr),
+        key_(node::Malloc(key_len)),
+        key_len_(key_len),
+        passphrase_(nullptr),
+        sig_(nullptr),
+        sig_len_(0),
+        encoding_(encoding),
+        error_(SignBase::kSignOk),
+        openssl_error_(0),
+        verify_result_(false) {
+    memcpy(key_, key, key_len);
+    Wrap(object, this);
+  }
 
-  // Only copy the data if we have to, because it's a string
-  Error err;
-  if (args[0]->IsString()) {
-    StringBytes::InlineDecoder decoder;
-    if (!decoder.Decode(env, args[0].As<String>(), args[1], UTF8))
-      return;
-    err = verify->VerifyUpdate(decoder.out(), decoder.size());
-  } else {
-    char* buf = Buffer::Data(args[0]);
-    size_t buflen = Buffer::Length(args[0]);
-    err = verify->VerifyUpdate(buf, buflen);
+  ~SignRequest() override {
+    OPENSSL_cleanse(key_, key_len_);
+    free(key_);
+    if (passphrase_ != nullptr) {
+      OPENSSL_cleanse(passphrase_, strlen(passphrase_));
+      free(passphrase_);
+    }
+    free(sig_);
+    ClearWrap(object());
+    persistent().Reset();
   }
 
-  verify->CheckThrow(err);
-}
+  uv_work_t* work_req() {
+    return &work_req_;
+  }
 
+  inline void set_passphrase(const char* passphrase, size_t len) {
+    passphrase_ = node::Malloc(len + 1);
+    memcpy(passphrase_, passphrase, len);
+    passphrase_[len] = '\0';
+  }
 
-SignBase::Error Verify::VerifyFinal(const char* key_pem,
-                                    int key_pem_len,
-                                    const char* sig,
-                                    int siglen,
-                                    bool* verify_result) {
-  if (!initialised_)
-    return kSignNotInitialised;
+  // The signature to verify.
+  inline void set_signature(const char* sig, int len) {
+    sig_ = node::Malloc(len);
+    sig_len_ = len;
+    memcpy(sig_, sig, len);
+  }
 
-  ClearErrorOnReturn clear_error_on_return;
-  (void) &clear_error_on_return;  // Silence compiler warning.
+  inline void set_target(Sign* sign) {
+    sign_ = sign;
+    sign_->pending_ = true;
+  }
+
+  inline void set_target(Verify* verify) {
+    verify_ = verify;
+    verify_->pending_ = true;
+  }
+
+  void DoWork() {
+    // Don't let errors that other work left on this thread fail the key check.
+    ERR_clear_error();
+    if (sign_ != nullptr) {
+      unsigned int sig_len = 8192;  // Maximum key size is 8192 bits
+      unsigned char* sig = node::Malloc<unsigned char>(sig_len);
+      error_ = sign_->SignFinal(key_, key_len_, passphrase_, &sig, &sig_len);
+      sig_ = reinterpret_cast<char*>(sig);
+      sig_len_ = sig_len;
+    } else {
+      error_ = verify_->VerifyFinal(key_,
+                                    key_len_,
+                                    sig_,
+                                    sig_len_,
+                                    &verify_result_);
+    }
+    if (error_ != SignBase::kSignOk)
+      openssl_error_ = ERR_get_error();
+    ERR_clear_error();
+  }
+
+  void After(Local<Value> argv[2]) {
+    Isolate* isolate = env()->isolate();
+    SignBase* target = sign_ != nullptr ? static_cast<SignBase*>(sign_)
+                                        : static_cast<SignBase*>(verify_);
+    // The callback may start the next operation right away.
+    target->pending_ = false;
+    if (error_ != SignBase::kSignOk) {
+      argv[0] = target->ErrorValue(error_, openssl_error_);
+      argv[1] = Undefined(isolate);
+    } else if (sign_ != nullptr) {
+      argv[0] = Null(isolate);
+      argv[1] = StringBytes::Encode(isolate, sig_, sig_len_, encoding_);
+    } else {
+      argv[0] = Null(isolate);
+      argv[1] = Boolean::New(isolate, verify_result_);
+    }
+  }
+
+  size_t self_size() const override { return sizeof(*this); }
+
+  uv_work_t work_req_;
+
+ private:
+  Sign* sign_;
+  Verify* verify_;
+  char* key_;
+  int key_len_;
+  char* passphrase_;
+  char* sig_;
+  int sig_len_;
+  enum encoding encoding_;
+  SignBase::Error error_;
+  unsigned long openssl_error_;  // NOLINT(runtime/int)
+  bool verify_result_;
+};
+
+
+void EIO_Sign(uv_work_t* work_req) {
+  SignRequest* req = ContainerOf(&SignRequest::work_req_, work_req);
+  req->DoWork();
+}
+
+
+void EIO_SignAfter(uv_work_t* work_req, int status) {
+  CHECK_EQ(status, 0);
+  SignRequest* req = ContainerOf(&SignRequest::work_req_, work_req);
+  Environment* env = req->env();
+  HandleScope handle_scope(env->isolate());
+  Context::Scope context_scope(env->context());
+  Local<Value> argv[2];
+  req->After(argv);
+  req->MakeCallback(env->ondone_string(), arraysize(argv), argv);
+  delete req;
+}
+
+
+static void QueueSignRequest(Environment* env,
+                             SignRequest* req,
+                             Local<Object> obj,
+                             Local<Object> handle,
+                             Local<Value> ondone) {
+  obj->Set(env->handle_string(), handle);
+  obj->Set(env->ondone_string(), ondone);
+
+  if (env->in_domain())
+    obj->Set(env->domain_string(), env->domain_array()->Get(0));
+  uv_queue_work(env->event_loop(),
+                req->work_req(),
+                EIO_Sign,
+                EIO_SignAfter);
+}
+
+
+void Sign::Initialize(Environment* env, v8::Local<v8::Object> target) {
+  Local<FunctionTemplate> t = env->NewFunctionTemplate(New);
+
+  t->InstanceTemplate()->SetInternalFieldCount(1);
+
+  env->SetProtoMethod(t, "init", SignInit);
+  env->SetProtoMethod(t, "update", SignUpdate);
+  env->SetProtoMethod(t, "sign", SignFinal);
+
+  target->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "Sign"), t->GetFunction());
+}
+
+
+void Sign::New(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  new Sign(env, args.This());
+}
+
+
+SignBase::Error Sign::SignInit(const char* sign_type) {
+  CHECK_EQ(initialised_, false);
+  const EVP_MD* md = EVP_get_digestbyname(sign_type);
+  if (md == nullptr)
+    return kSignUnknownDigest;
+
+  EVP_MD_CTX_init(&mdctx_);
+  if (!EVP_SignInit_ex(&mdctx_, md, nullptr))
+    return kSignInit;
+  initialised_ = true;
+
+  return kSignOk;
+}
+
+
+void Sign::SignInit(const FunctionCallbackInfo<Value>& args) {
+  Sign* sign;
+  ASSIGN_OR_RETURN_UNWRAP(&sign, args.Holder());
+  Environment* env = sign->env();
+
+  if (args.Length() == 0) {
+    return env->ThrowError("Sign type argument is mandatory");
+  }
+
+  THROW_AND_RETURN_IF_NOT_STRING(args[0], "Sign type");
+
+  const node::Utf8Value sign_type(args.GetIsolate(), args[0]);
+  sign->CheckThrow(sign->SignInit(*sign_type));
+}
+
+
+SignBase::Error Sign::SignUpdate(const char* data, int len) {
+  if (!initialised_)
+    return kSignNotInitialised;
+  if (!EVP_SignUpdate(&mdctx_, data, len))
+    return kSignUpdate;
+  return kSignOk;
+}
+
+
+void Sign::SignUpdate(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  Sign* sign;
+  ASSIGN_OR_RETURN_UNWRAP(&sign, args.Holder());
+
+  THROW_AND_RETURN_IF_NOT_STRING_OR_BUFFER(args[0], "Data");
+
+  if (sign->pending_)
+    return sign->CheckThrow(kSignPending);
+
+  // Only copy the data if we have to, because it's a string
+  Error err;
+  if (args[0]->IsString()) {
+    StringBytes::InlineDecoder decoder;
+    if (!decoder.Decode(env, args[0].As<String>(), args[1], UTF8))
+      return;
+    err = sign->SignUpdate(decoder.out(), decoder.size());
+  } else {
+    char* buf = Buffer::Data(args[0]);
+    size_t buflen = Buffer::Length(args[0]);
+    err = sign->SignUpdate(buf, buflen);
+  }
+
+  sign->CheckThrow(err);
+}
+
+
+SignBase::Error Sign::SignFinal(const char* key_pem,
+                                int key_pem_len,
+                                const char* passphrase,
+                                unsigned char** sig,
+                                unsigned int *sig_len) {
+  if (!initialised_)
+    return kSignNotInitialised;
 
-  EVP_PKEY* pkey = nullptr;
   BIO* bp = nullptr;
-  X509* x509 = nullptr;
+  EVP_PKEY* pkey = nullptr;
   bool fatal = true;
-  int r = 0;
 
   bp = BIO_new_mem_buf(const_cast<char*>(key_pem), key_pem_len);
   if (bp == nullptr)
     goto exit;
 
-  // Check if this is a PKCS#8 or RSA public key before trying as X.509.
-  // Split this out into a separate function once we have more than one
-  // consumer of public keys.
-  if (strncmp(key_pem, PUBLIC_KEY_PFX, PUBLIC_KEY_PFX_LEN) == 0) {
-    pkey = PEM_read_bio_PUBKEY(bp, nullptr, CryptoPemCallback, nullptr);
-    if (pkey == nullptr)
-      goto exit;
-  } else if (strncmp(key_pem, PUBRSA_KEY_PFX, PUBRSA_KEY_PFX_LEN) == 0) {
-    RSA* rsa =
-        PEM_read_bio_RSAPublicKey(bp, nullptr, CryptoPemCallback, nullptr);
-    if (rsa) {
-      pkey = EVP_PKEY_new();
-      if (pkey)
-        EVP_PKEY_set1_RSA(pkey, rsa);
-      RSA_free(rsa);
-    }
-    if (pkey == nullptr)
-      goto exit;
-  } else {
-    // X.509 fallback
-    x509 = PEM_read_bio_X509(bp, nullptr, CryptoPemCallback, nullptr);
-    if (x509 == nullptr)
-      goto exit;
+  pkey = PEM_read_bio_PrivateKey(bp,
+                                 nullptr,
+                                 CryptoPemCallback,
+                                 const_cast<char*>(passphrase));
 
-    pkey = X509_get_pubkey(x509);
-    if (pkey == nullptr)
+  // Errors might be injected into OpenSSL's error stack
+  // without `pkey` being set to nullptr;
+  // cf. the test of `test_bad_rsa_privkey.pem` for an example.
+  if (pkey == nullptr || 0 != ERR_peek_error())
+    goto exit;
+
+#ifdef NODE_FIPS_MODE
+  /* Validate DSA2 parameters from FIPS 186-4 */
+  if (FIPS_mode() && EVP_PKEY_DSA == pkey->type) {
+    size_t L = BN_num_bits(pkey->pkey.dsa->p);
+    size_t N = BN_num_bits(pkey->pkey.dsa->q);
+    bool result = false;
+
+    if (L == 1024 && N == 160)
+      result = true;
+    else if (L == 2048 && N == 224)
+      result = true;
+    else if (L == 2048 && N == 256)
+      result = true;
+    else if (L == 3072 && N == 256)
+      result = true;
+
+    if (!result) {
+      fatal = true;
       goto exit;
+    }
   }
+#endif  // NODE_FIPS_MODE
 
-  fatal = false;
-  r = EVP_VerifyFinal(&mdctx_,
-                      reinterpret_cast<const unsigned char*>(sig),
-                      siglen,
-                      pkey);
+  if (EVP_SignFinal(&mdctx_, *sig, sig_len, pkey))
+    fatal = false;
+
+  initialised_ = false;
 
  exit:
   if (pkey != nullptr)
     EVP_PKEY_free(pkey);
   if (bp != nullptr)
     BIO_free_all(bp);
-  if (x509 != nullptr)
-    X509_free(x509);
 
   EVP_MD_CTX_cleanup(&mdctx_);
-  initialised_ = false;
 
   if (fatal)
-    return kSignPublicKey;
+    return kSignPrivateKey;
 
-  *verify_result = r == 1;
   return kSignOk;
 }
 
 
-void Verify::VerifyFinal(const FunctionCallbackInfo<Value>& args) {
+void Sign::SignFinal(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
 
-  Verify* verify;
-  ASSIGN_OR_RETURN_UNWRAP(&verify, args.Holder());
+  Sign* sign;
+  ASSIGN_OR_RETURN_UNWRAP(&sign, args.Holder());
 
-  THROW_AND_RETURN_IF_NOT_BUFFER(args[0], "Key");
-  char* kbuf = Buffer::Data(args[0]);
-  ssize_t klen = Buffer::Length(args[0]);
+  if (sign->pending_)
+    return sign->CheckThrow(kSignPending);
 
-  THROW_AND_RETURN_IF_NOT_STRING_OR_BUFFER(args[1], "Hash");
+  unsigned char* md_value;
+  unsigned int md_len;
 
-  enum encoding encoding = UTF8;
-  if (args.Length() >= 3) {
+  unsigned int len = args.Length();
+  enum encoding encoding = BUFFER;
+  if (len >= 2 && args[1]->IsString()) {
     encoding = ParseEncoding(env->isolate(),
-                             args[2]->ToString(env->isolate()),
-                             UTF8);
+                             args[1]->ToString(env->isolate()),
+                             BUFFER);
   }
 
-  ssize_t hlen = StringBytes::Size(env->isolate(), args[1], encoding);
+  node::Utf8Value passphrase(env->isolate(), args[2]);
 
-  // only copy if we need to, because it's a string.
-  char* hbuf;
-  if (args[1]->IsString()) {
-    hbuf = new char[hlen];
-    ssize_t hwritten = StringBytes::Write(env->isolate(),
-                                          hbuf,
-                                          hlen,
-                                          args[1],
-                                          encoding);
-    CHECK_EQ(hwritten, hlen);
-  } else {
-    hbuf = Buffer::Data(args[1]);
+  THROW_AND_RETURN_IF_NOT_BUFFER(args[0], "Data");
+  size_t buf_len = Buffer::Length(args[0]);
+  char* buf = Buffer::Data(args[0]);
+
+  if (args[3]->IsFunction()) {
+    Local<Object> obj = env->NewInternalFieldObject();
+    SignRequest* req = new SignRequest(env, obj, buf, buf_len, encoding);
+    if (len >= 3 && !args[2]->IsNull())
+      req->set_passphrase(*passphrase, passphrase.length());
+    req->set_target(sign);
+    QueueSignRequest(env, req, obj, args.Holder(), args[3]);
+    return;
   }
 
-  bool verify_result;
-  Error err = verify->VerifyFinal(kbuf, klen, hbuf, hlen, &verify_result);
-  if (args[1]->IsString())
-    delete[] hbuf;
-  if (err != kSignOk)
-    return verify->CheckThrow(err);
-  args.GetReturnValue().Set(verify_result);
-}
+  md_len = 8192;  // Maximum key size is 8192 bits
+  md_value = new unsigned char[md_len];
+
+  ClearErrorOnReturn clear_error_on_return;
+  (void) &clear_error_on_return;  // Silence compiler warning.
+
+  Error err = sign->SignFinal(
+      buf,
+      buf_len,
+      len >= 3 && !args[2]->IsNull() ? *passphrase : nullptr,
+      &md_value,
+      &md_len);
+  if (err != kSignOk) {
+    delete[] md_value;
+    md_value = nullptr;
+    md_len = 0;
+    return sign->CheckThrow(err);
+  }
+
+  Local<Value> rc = StringBytes::Encode(env->isolate(),
+                                        reinterpret_cast<const char*>(md_value),
+                                        md_len,
+                                        encoding);
+  delete[] md_value;
+  args.GetReturnValue().Set(rc);
+}
+
+
+void Verify::Initialize(Environment* env, v8::Local<v8::Object> target) {
+  Local<FunctionTemplate> t = env->NewFunctionTemplate(New);
+
+  t->InstanceTemplate()->SetInternalFieldCount(1);
+
+  env->SetProtoMethod(t, "init", VerifyInit);
+  env->SetProtoMethod(t, "update", VerifyUpdate);
+  env->SetProtoMethod(t, "verify", VerifyFinal);
+
+  target->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "Verify"),
+              t->GetFunction());
+}
+
+
+void Verify::New(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  new Verify(env, args.This());
+}
+
+
+SignBase::Error Verify::VerifyInit(const char* verify_type) {
+  CHECK_EQ(initialised_, false);
+  const EVP_MD* md = EVP_get_digestbyname(verify_type);
+  if (md == nullptr)
+    return kSignUnknownDigest;
+
+  EVP_MD_CTX_init(&mdctx_);
+  if (!EVP_VerifyInit_ex(&mdctx_, md, nullptr))
+    return kSignInit;
+  initialised_ = true;
+
+  return kSignOk;
+}
+
+
+void Verify::VerifyInit(const FunctionCallbackInfo<Value>& args) {
+  Verify* verify;
+  ASSIGN_OR_RETURN_UNWRAP(&verify, args.Holder());
+  Environment* env = verify->env();
+
+  if (args.Length() == 0) {
+    return env->ThrowError("Verify type argument is mandatory");
+  }
+
+  THROW_AND_RETURN_IF_NOT_STRING(args[0], "Verify type");
+
+  const node::Utf8Value verify_type(args.GetIsolate(), args[0]);
+  verify->CheckThrow(verify->VerifyInit(*verify_type));
+}
+
+
+SignBase::Error Verify::VerifyUpdate(const char* data, int len) {
+  if (!initialised_)
+    return kSignNotInitialised;
+
+  if (!EVP_VerifyUpdate(&mdctx_, data, len))
+    return kSignUpdate;
+
+  return kSignOk;
+}
+
+
+void Verify::VerifyUpdate(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  Verify* verify;
+  ASSIGN_OR_RETURN_UNWRAP(&verify, args.Holder());
+
+  THROW_AND_RETURN_IF_NOT_STRING_OR_BUFFER(args[0], "Data");
+
+  if (verify->pending_)
+    return verify->CheckThrow(kSignPending);
+
+  // Only copy the data if we have to, because it's a string
+  Error err;
+  if (args[0]->IsString()) {
+    StringBytes::InlineDecoder decoder;
+    if (!decoder.Decode(env, args[0].As<String>(), args[1], UTF8))
+      return;
+    err = verify->VerifyUpdate(decoder.out(), decoder.size());
+  } else {
+    char* buf = Buffer::Data(args[0]);
+    size_t buflen = Buffer::Length(args[0]);
+    err = verify->VerifyUpdate(buf, buflen);
+  }
+
+  verify->CheckThrow(err);
+}
+
+
+SignBase::Error Verify::VerifyFinal(const char* key_pem,
+                                    int key_pem_len,
+                                    const char* sig,
+                                    int siglen,
+                                    bool* verify_result) {
+  if (!initialised_)
+    return kSignNotInitialised;
+
+  ClearErrorOnReturn clear_error_on_return;
+  (void) &clear_error_on_return;  // Silence compiler warning.
+
+  EVP_PKEY* pkey = nullptr;
+  BIO* bp = nullptr;
+  X509* x509 = nullptr;
+  bool fatal = true;
+  int r = 0;
+
+  bp = BIO_new_mem_buf(const_cast<char*>(key_pem), key_pem_len);
+  if (bp == nullptr)
+    goto exit;
+
+  // Check if this is a PKCS#8 or RSA public key before trying as X.509.
+  // Split this out into a separate function once we have more than one
+  // consumer of public keys.
+  if (strncmp(key_pem, PUBLIC_KEY_PFX, PUBLIC_KEY_PFX_LEN) == 0) {
+    pkey = PEM_read_bio_PUBKEY(bp, nullptr, CryptoPemCallback, nullptr);
+    if (pkey == nullptr)
+      goto exit;
+  } else if (strncmp(key_pem, PUBRSA_KEY_PFX, PUBRSA_KEY_PFX_LEN) == 0) {
+    RSA* rsa =
+        PEM_read_bio_RSAPublicKey(bp, nullptr, CryptoPemCallback, nullptr);
+    if (rsa) {
+      pkey = EVP_PKEY_new();
+      if (pkey)
+        EVP_PKEY_set1_RSA(pkey, rsa);
+      RSA_free(rsa);
+    }
+    if (pkey == nullptr)
+      goto exit;
+  } else {
+    // X.509 fallback
+    x509 = PEM_read_bio_X509(bp, nullptr, CryptoPemCallback, nullptr);
+    if (x509 == nullptr)
+      goto exit;
+
+    pkey = X509_get_pubkey(x509);
+    if (pkey == nullptr)
+      goto exit;
+  }
+
+  fatal = false;
+  r = EVP_VerifyFinal(&mdctx_,
+                      reinterpret_cast<const unsigned char*>(sig),
+                      siglen,
+                      pkey);
+
+ exit:
+  if (pkey != nullptr)
+    EVP_PKEY_free(pkey);
+  if (bp != nullptr)
+    BIO_free_all(bp);
+  if (x509 != nullptr)
+    X509_free(x509);
+
+  EVP_MD_CTX_cleanup(&mdctx_);
+  initialised_ = false;
+
+  if (fatal)
+    return kSignPublicKey;
+
+  *verify_result = r == 1;
+  return kSignOk;
+}
+
+
+void Verify::VerifyFinal(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  Verify* verify;
+  ASSIGN_OR_RETURN_UNWRAP(&verify, args.Holder());
+
+  if (verify->pending_)
+    return verify->CheckThrow(kSignPending);
+
+  THROW_AND_RETURN_IF_NOT_BUFFER(args[0], "Key");
+  char* kbuf = Buffer::Data(args[0]);
+  ssize_t klen = Buffer::Length(args[0]);
+
+  THROW_AND_RETURN_IF_NOT_STRING_OR_BUFFER(args[1], "Hash");
+
+  enum encoding encoding = UTF8;
+  if (args.Length() >= 3) {
+    encoding = ParseEncoding(env->isolate(),
+                             args[2]->ToString(env->isolate()),
+                             UTF8);
+  }
+
+  ssize_t hlen = StringBytes::Size(env->isolate(), args[1], encoding);
+
+  // only copy if we need to, because it's a string.
+  char* hbuf;
+  if (args[1]->IsString()) {
+    hbuf = new char[hlen];
+    ssize_t hwritten = StringBytes::Write(env->isolate(),
+                                          hbuf,
+                                          hlen,
+                                          args[1],
+                                          encoding);
+    CHECK_EQ(hwritten, hlen);
+  } else {
+    hbuf = Buffer::Data(args[1]);
+  }
+
+  if (args[3]->IsFunction()) {
+    Local<Object> obj = env->NewInternalFieldObject();
+    SignRequest* req = new SignRequest(env, obj, kbuf, klen, BUFFER);
+    req->set_signature(hbuf, hlen);
+    if (args[1]->IsString())
+      delete[] hbuf;
+    req->set_target(verify);
+    QueueSignRequest(env, req, obj, args.Holder(), args[3]);
+    return;
+  }
+
+  bool verify_result;
+  Error err = verify->VerifyFinal(kbuf, klen, hbuf, hlen, &verify_result);
+  if (args[1]->IsString())
+    delete[] hbuf;
+  if (err != kSignOk)
+    return verify->CheckThrow(err);
+  args.GetReturnValue().Set(verify_result);
+}
 
 
 template <PublicKeyCipher::Operation operation,
@@ -4351,128 +6050,832 @@ bool PublicKeyCipher::Cipher(const char* key_pem,
   X509* x509 = nullptr;
   bool fatal = true;
 
-  bp = BIO_new_mem_buf(const_cast<char*>(key_pem), key_pem_len);
-  if (bp == nullptr)
-    goto exit;
+  bp = BIO_new_mem_buf(const_cast<char*>(key_pem), key_pem_len);
+  if (bp == nullptr)
+    goto exit;
+
+  // Check if this is a PKCS#8 or RSA public key before trying as X.509 and
+  // private key.
+  if (operation == kPublic &&
+      strncmp(key_pem, PUBLIC_KEY_PFX, PUBLIC_KEY_PFX_LEN) == 0) {
+    pkey = PEM_read_bio_PUBKEY(bp, nullptr, nullptr, nullptr);
+    if (pkey == nullptr)
+      goto exit;
+  } else if (operation == kPublic &&
+             strncmp(key_pem, PUBRSA_KEY_PFX, PUBRSA_KEY_PFX_LEN) == 0) {
+    RSA* rsa = PEM_read_bio_RSAPublicKey(bp, nullptr, nullptr, nullptr);
+    if (rsa) {
+      pkey = EVP_PKEY_new();
+      if (pkey)
+        EVP_PKEY_set1_RSA(pkey, rsa);
+      RSA_free(rsa);
+    }
+    if (pkey == nullptr)
+      goto exit;
+  } else if (operation == kPublic &&
+             strncmp(key_pem, CERTIFICATE_PFX, CERTIFICATE_PFX_LEN) == 0) {
+    x509 = PEM_read_bio_X509(bp, nullptr, CryptoPemCallback, nullptr);
+    if (x509 == nullptr)
+      goto exit;
+
+    pkey = X509_get_pubkey(x509);
+    if (pkey == nullptr)
+      goto exit;
+  } else {
+    pkey = PEM_read_bio_PrivateKey(bp,
+                                   nullptr,
+                                   CryptoPemCallback,
+                                   const_cast<char*>(passphrase));
+    if (pkey == nullptr)
+      goto exit;
+  }
+
+  ctx = EVP_PKEY_CTX_new(pkey, nullptr);
+  if (!ctx)
+    goto exit;
+  if (EVP_PKEY_cipher_init(ctx) <= 0)
+    goto exit;
+  if (EVP_PKEY_CTX_set_rsa_padding(ctx, padding) <= 0)
+    goto exit;
+
+  if (EVP_PKEY_cipher(ctx, nullptr, out_len, data, len) <= 0)
+    goto exit;
+
+  *out = new unsigned char[*out_len];
+
+  if (EVP_PKEY_cipher(ctx, *out, out_len, data, len) <= 0)
+    goto exit;
+
+  fatal = false;
+
+ exit:
+  if (x509 != nullptr)
+    X509_free(x509);
+  if (pkey != nullptr)
+    EVP_PKEY_free(pkey);
+  if (bp != nullptr)
+    BIO_free_all(bp);
+  if (ctx != nullptr)
+    EVP_PKEY_CTX_free(ctx);
+
+  return !fatal;
+}
+
+
+// Runs one of the PublicKeyCipher::Cipher() instantiations on the threadpool.
+// The key, pass phrase and data are copied; they are small compared to the
+// cost of the RSA operation.
+class PublicKeyCipherRequest : public AsyncWrap {
+ public:
+  typedef bool (*Cipher_t)(const char* key_pem,
+                           int key_pem_len,
+                           const char* passphrase,
+                           int padding,
+                           const unsigned char* data,
+                           int len,
+                           unsigned char** out,
+                           size_t* out_len);
+
+  PublicKeyCipherRequest(Environment* env,
+                         Local<Object> object,
+                         Cipher_t cipher,
+                         const char* key,
+                         int key_len,
+                         const char* passphrase,
+                         int padding,
+                         const char* data,
+                         int len)
+      : AsyncWrap(env, object, AsyncWrap::PROVIDER_CRYPTO),
+        cipher_(cipher),
+        key_(node::Malloc(key_len)),
+        key_len_(key_len),
+        passphrase_(nullptr),
+        padding_(padding),
+        data_(node::Malloc<unsigned char>(len)),
+        len_(len),
+        out_(nullptr),
+        out_len_(0),
+        ok_(false),
+        error_(0) {
+    memcpy(key_, key, key_len);
+    memcpy(data_, data, len);
+    if (passphrase != nullptr) {
+      size_t passphrase_len = strlen(passphrase);
+      passphrase_ = node::Malloc(passphrase_len + 1);
+      memcpy(passphrase_, passphrase, passphrase_len + 1);
+    }
+    Wrap(object, this);
+  }
+
+  ~PublicKeyCipherRequest() override {
+    OPENSSL_cleanse(key_, key_len_);
+    free(key_);
+    if (passphrase_ != nullptr) {
+      OPENSSL_cleanse(passphrase_, strlen(passphrase_));
+      free(passphrase_);
+    }
+    OPENSSL_cleanse(data_, len_);
+    free(data_);
+    delete[] out_;
+    ClearWrap(object());
+    persistent().Reset();
+  }
+
+  uv_work_t* work_req() {
+    return &work_req_;
+  }
+
+  void DoWork() {
+    ERR_clear_error();
+    ok_ = cipher_(key_,
+                  key_len_,
+                  passphrase_,
+                  padding_,
+                  data_,
+                  len_,
+                  &out_,
+                  &out_len_);
+    if (!ok_)
+      error_ = ERR_get_error();
+    ERR_clear_error();
+  }
+
+  void After(Local<Value> argv[2]) {
+    Isolate* isolate = env()->isolate();
+    if (!ok_) {
+      char errmsg[128] = { 0 };
+      ERR_error_string_n(error_, errmsg, sizeof(errmsg));
+      argv[0] = Exception::Error(OneByteString(isolate, errmsg));
+      argv[1] = Undefined(isolate);
+    } else {
+      argv[0] = Null(isolate);
+      argv[1] = Buffer::Copy(env(),
+                             reinterpret_cast<char*>(out_),
+                             out_len_).ToLocalChecked();
+    }
+  }
+
+  size_t self_size() const override { return sizeof(*this); }
+
+  uv_work_t work_req_;
+
+ private:
+  Cipher_t cipher_;
+  char* key_;
+  int key_len_;
+  char* passphrase_;
+  int padding_;
+  unsigned char* data_;
+  int len_;
+  unsigned char* out_;
+  size_t out_len_;
+  bool ok_;
+  unsigned long error_;  // NOLINT(runtime/int)
+};
+
+
+void EIO_PublicKeyCipher(uv_work_t* work_req) {
+  PublicKeyCipherRequest* req =
+      ContainerOf(&PublicKeyCipherRequest::work_req_, work_req);
+  req->DoWork();
+}
+
+
+void EIO_PublicKeyCipherAfter(uv_work_t* work_req, int status) {
+  CHECK_EQ(status, 0);
+  PublicKeyCipherRequest* req =
+      ContainerOf(&PublicKeyCipherRequest::work_req_, work_req);
+  Environment* env = req->env();
+  HandleScope handle_scope(env->isolate());
+  Context::Scope context_scope(env->context());
+  Local<Value> argv[2];
+  req->After(argv);
+  req->MakeCallback(env->ondone_string(), arraysize(argv), argv);
+  delete req;
+}
+
+
+template <PublicKeyCipher::Operation operation,
+          PublicKeyCipher::EVP_PKEY_cipher_init_t EVP_PKEY_cipher_init,
+          PublicKeyCipher::EVP_PKEY_cipher_t EVP_PKEY_cipher>
+void PublicKeyCipher::Cipher(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  THROW_AND_RETURN_IF_NOT_BUFFER(args[0], "Key");
+  char* kbuf = Buffer::Data(args[0]);
+  ssize_t klen = Buffer::Length(args[0]);
+
+  THROW_AND_RETURN_IF_NOT_BUFFER(args[1], "Data");
+  char* buf = Buffer::Data(args[1]);
+  ssize_t len = Buffer::Length(args[1]);
+
+  int padding = args[2]->Uint32Value();
+
+  String::Utf8Value passphrase(args[3]);
+
+  unsigned char* out_value = nullptr;
+  size_t out_len = 0;
+
+  if (args[4]->IsFunction()) {
+    Local<Object> obj = env->NewInternalFieldObject();
+    PublicKeyCipherRequest* req = new PublicKeyCipherRequest(
+        env,
+        obj,
+        Cipher<operation, EVP_PKEY_cipher_init, EVP_PKEY_cipher>,
+        kbuf,
+        klen,
+        args.Length() >= 3 && !args[2]->IsNull() ? *passphrase : nullptr,
+        padding,
+        buf,
+        len);
+    obj->Set(env->ondone_string(), args[4]);
+
+    if (env->in_domain())
+      obj->Set(env->domain_string(), env->domain_array()->Get(0));
+    uv_queue_work(env->event_loop(),
+                  req->work_req(),
+                  EIO_PublicKeyCipher,
+                  EIO_PublicKeyCipherAfter);
+    return;
+  }
+
+  ClearErrorOnReturn clear_error_on_return;
+  (void) &clear_error_on_return;  // Silence compiler warning.
+
+  bool r = Cipher<operation, EVP_PKEY_cipher_init, EVP_PKEY_cipher>(
+      kbuf,
+      klen,
+      args.Length() >= 3 && !args[2]->IsNull() ? *passphrase : nullptr,
+      padding,
+      reinterpret_cast<const unsigned char*>(buf),
+      len,
+      &out_value,
+      &out_len);
+
+  if (out_len == 0 || !r) {
+    delete[] out_value;
+    out_value = nullptr;
+    out_len = 0;
+    if (!r) {
+      return ThrowCryptoError(env,
+        ERR_get_error());
+    }
+  }
+
+  Local<Object> vbuf = Buffer::Copy(
+      env,
+      reinterpret_cast<char*>(out_value),
+      out_len).ToLocalChecked();
+  args.GetReturnValue().Set(vbuf);
+  delete[] out_value;
+}
+
+
+// Generates key material on the threadpool.  Generate() runs there, Results()
+// turns what it produced into the values passed to the callback after the
+// error, or returned by the synchronous variants.
+class KeyGenRequest : public AsyncWrap {
+ public:
+  KeyGenRequest(Environment* env, Local<Object> object)
+      : AsyncWrap(env, object, AsyncWrap::PROVIDER_CRYPTO),
+        ok_(false),
+        error_(0) {
+    Wrap(object, this);
+  }
+
+  ~KeyGenRequest() override {
+    ClearWrap(object());
+    persistent().Reset();
+  }
+
+  uv_work_t* work_req() {
+    return &work_req_;
+  }
+
+  void DoWork() {
+    ERR_clear_error();
+    ok_ = Generate();
+    if (!ok_)
+      error_ = ERR_get_error();
+    ERR_clear_error();
+  }
+
+  inline bool ok() const {
+    return ok_;
+  }
+
+  Local<Value> ErrorValue() const {
+    char errmsg[128] = "Key generation failed";
+    if (error_ != 0)
+      ERR_error_string_n(error_, errmsg, sizeof(errmsg));
+    return Exception::Error(OneByteString(env()->isolate(), errmsg));
+  }
+
+  // Stores up to three values in |argv| and returns how many.
+  virtual int Results(Local<Value>* argv) = 0;
+
+  // Called before the callback, which may start the next request on the
+  // same object right away.
+  virtual void ReleaseTarget() {}
+
+  uv_work_t work_req_;
+
+ protected:
+  virtual bool Generate() = 0;
+
+ private:
+  bool ok_;
+  unsigned long error_;  // NOLINT(runtime/int)
+};
+
+
+void EIO_KeyGen(uv_work_t* work_req) {
+  KeyGenRequest* req = ContainerOf(&KeyGenRequest::work_req_, work_req);
+  req->DoWork();
+}
+
+
+void EIO_KeyGenAfter(uv_work_t* work_req, int status) {
+  CHECK_EQ(status, 0);
+  KeyGenRequest* req = ContainerOf(&KeyGenRequest::work_req_, work_req);
+  Environment* env = req->env();
+  HandleScope handle_scope(env->isolate());
+  Context::Scope context_scope(env->context());
+  Local<Value> argv[4];
+  int argc = 1;
+  req->ReleaseTarget();
+  if (req->ok()) {
+    argv[0] = Null(env->isolate());
+    argc += req->Results(argv + 1);
+  } else {
+    argv[0] = req->ErrorValue();
+  }
+  req->MakeCallback(env->ondone_string(), argc, argv);
+  delete req;
+}
+
+
+// |handle| is kept alive until the request is done; pass an empty handle if
+// there is nothing to keep alive.
+static void QueueKeyGenRequest(Environment* env,
+                               KeyGenRequest* req,
+                               Local<Object> obj,
+                               Local<Object> handle,
+                               Local<Value> ondone) {
+  if (!handle.IsEmpty())
+    obj->Set(env->handle_string(), handle);
+  obj->Set(env->ondone_string(), ondone);
+
+  if (env->in_domain())
+    obj->Set(env->domain_string(), env->domain_array()->Get(0));
+  uv_queue_work(env->event_loop(),
+                req->work_req(),
+                EIO_KeyGen,
+                EIO_KeyGenAfter);
+}
+
+
+// Generates a Diffie-Hellman group with a new prime.  The results are the
+// prime, the generator and the verifyError of the group, from which
+// `new DiffieHellman(prime, generator, verifyError)` creates the object.
+class DHParamsRequest : public KeyGenRequest {
+ public:
+  DHParamsRequest(Environment* env,
+                  Local<Object> object,
+                  int prime_length,
+                  int generator)
+      : KeyGenRequest(env, object),
+        prime_length_(prime_length),
+        generator_(generator),
+        verify_error_(0),
+        dh_(DH_new()) {
+  }
+
+  ~DHParamsRequest() override {
+    DH_free(dh_);
+  }
+
+  int Results(Local<Value>* argv) override {
+    Environment* env = this->env();
+    argv[0] = BignumToBuffer(env, dh_->p);
+    argv[1] = BignumToBuffer(env, dh_->g);
+    argv[2] = Integer::New(env->isolate(), verify_error_);
+    return 3;
+  }
+
+  size_t self_size() const override { return sizeof(*this); }
+
+ protected:
+  bool Generate() override {
+    return dh_ != nullptr &&
+           DH_generate_parameters_ex(dh_, prime_length_, generator_, 0) &&
+           DH_check(dh_, &verify_error_);
+  }
+
+ private:
+  static Local<Value> BignumToBuffer(Environment* env, const BIGNUM* bn) {
+    const int size = BN_num_bytes(bn);
+    char* data = node::Malloc(size);
+    BN_bn2bin(bn, reinterpret_cast<unsigned char*>(data));
+    return Buffer::New(env, data, size).ToLocalChecked();
+  }
+
+  const int prime_length_;
+  const int generator_;
+  int verify_error_;
+  DH* dh_;
+};
+
+
+// Generates the keys of a DiffieHellman object on a copy of its group, then
+// replaces the object's DH with the copy.
+class DHKeysRequest : public KeyGenRequest {
+ public:
+  DHKeysRequest(Environment* env,
+                Local<Object> object,
+                DiffieHellman* target,
+                DH* dh)
+      : KeyGenRequest(env, object), target_(target), dh_(dh) {
+    target_->pending_ = true;
+  }
+
+  ~DHKeysRequest() override {
+    if (dh_ != nullptr)
+      DH_free(dh_);
+  }
+
+  void ReleaseTarget() override {
+    target_->pending_ = false;
+  }
+
+  int Results(Local<Value>* argv) override {
+    DH_free(target_->dh);
+    target_->dh = dh_;
+    dh_ = nullptr;
+
+    const BIGNUM* pub_key = target_->dh->pub_key;
+    const int size = BN_num_bytes(pub_key);
+    char* data = node::Malloc(size);
+    BN_bn2bin(pub_key, reinterpret_cast<unsigned char*>(data));
+    argv[0] = Buffer::New(env(), data, size).ToLocalChecked();
+    return 1;
+  }
+
+  size_t self_size() const override { return sizeof(*this); }
+
+ protected:
+  bool Generate() override {
+    return DH_generate_key(dh_);
+  }
+
+ private:
+  DiffieHellman* const target_;
+  DH* dh_;
+};
+
+
+// Like DHKeysRequest, for an ECDH object.
+class ECDHKeysRequest : public KeyGenRequest {
+ public:
+  ECDHKeysRequest(Environment* env,
+                  Local<Object> object,
+                  ECDH* target,
+                  EC_KEY* key)
+      : KeyGenRequest(env, object), target_(target), key_(key) {
+    target_->pending_ = true;
+  }
+
+  ~ECDHKeysRequest() override {
+    if (key_ != nullptr)
+      EC_KEY_free(key_);
+  }
+
+  void ReleaseTarget() override {
+    target_->pending_ = false;
+  }
+
+  int Results(Local<Value>* argv) override {
+    EC_KEY_free(target_->key_);
+    target_->key_ = key_;
+    target_->group_ = EC_KEY_get0_group(key_);
+    key_ = nullptr;
+    return 0;
+  }
+
+  size_t self_size() const override { return sizeof(*this); }
+
+ protected:
+  bool Generate() override {
+    return EC_KEY_generate_key(key_);
+  }
+
+ private:
+  ECDH* const target_;
+  EC_KEY* key_;
+};
+
 
-  // Check if this is a PKCS#8 or RSA public key before trying as X.509 and
-  // private key.
-  if (operation == kPublic &&
-      strncmp(key_pem, PUBLIC_KEY_PFX, PUBLIC_KEY_PFX_LEN) == 0) {
-    pkey = PEM_read_bio_PUBKEY(bp, nullptr, nullptr, nullptr);
-    if (pkey == nullptr)
-      goto exit;
-  } else if (operation == kPublic &&
-             strncmp(key_pem, PUBRSA_KEY_PFX, PUBRSA_KEY_PFX_LEN) == 0) {
-    RSA* rsa = PEM_read_bio_RSAPublicKey(bp, nullptr, nullptr, nullptr);
-    if (rsa) {
-      pkey = EVP_PKEY_new();
-      if (pkey)
-        EVP_PKEY_set1_RSA(pkey, rsa);
-      RSA_free(rsa);
+// Generates an RSA or EC key pair and encodes both keys.  Keys are written
+// as PEM strings or DER buffers.  The public key is encoded as SPKI or, for
+// RSA, PKCS#1; the private key as PKCS#8 or, for RSA, PKCS#1 and, for EC,
+// SEC1, optionally encrypted with |cipher| and |passphrase|.
+class KeyPairRequest : public KeyGenRequest {
+ public:
+  enum KeyType { kKeyTypeRSA, kKeyTypeEC };
+  enum KeyEncoding { kKeyEncodingSPKI, kKeyEncodingPKCS1, kKeyEncodingPKCS8,
+                     kKeyEncodingSEC1 };
+
+  KeyPairRequest(Environment* env, Local<Object> object)
+      : KeyGenRequest(env, object),
+        type_(kKeyTypeRSA),
+        modulus_bits_(0),
+        exponent_(0),
+        curve_nid_(NID_undef),
+        public_encoding_(kKeyEncodingSPKI),
+        public_pem_(true),
+        private_encoding_(kKeyEncodingPKCS8),
+        private_pem_(true),
+        cipher_(nullptr),
+        passphrase_(nullptr),
+        passphrase_len_(0),
+        public_bio_(nullptr),
+        private_bio_(nullptr) {
+  }
+
+  ~KeyPairRequest() override {
+    if (passphrase_ != nullptr) {
+      OPENSSL_cleanse(passphrase_, passphrase_len_);
+      free(passphrase_);
     }
-    if (pkey == nullptr)
-      goto exit;
-  } else if (operation == kPublic &&
-             strncmp(key_pem, CERTIFICATE_PFX, CERTIFICATE_PFX_LEN) == 0) {
-    x509 = PEM_read_bio_X509(bp, nullptr, CryptoPemCallback, nullptr);
-    if (x509 == nullptr)
-      goto exit;
+    if (public_bio_ != nullptr)
+      BIO_free_all(public_bio_);
+    if (private_bio_ != nullptr) {
+      BUF_MEM* mem;
+      BIO_get_mem_ptr(private_bio_, &mem);
+      OPENSSL_cleanse(mem->data, mem->length);
+      BIO_free_all(private_bio_);
+    }
+  }
 
-    pkey = X509_get_pubkey(x509);
-    if (pkey == nullptr)
-      goto exit;
-  } else {
-    pkey = PEM_read_bio_PrivateKey(bp,
-                                   nullptr,
-                                   CryptoPemCallback,
-                                   const_cast<char*>(passphrase));
-    if (pkey == nullptr)
-      goto exit;
+  inline void set_rsa(int modulus_bits, unsigned int exponent) {
+    type_ = kKeyTypeRSA;
+    modulus_bits_ = modulus_bits;
+    exponent_ = exponent;
   }
 
-  ctx = EVP_PKEY_CTX_new(pkey, nullptr);
-  if (!ctx)
-    goto exit;
-  if (EVP_PKEY_cipher_init(ctx) <= 0)
-    goto exit;
-  if (EVP_PKEY_CTX_set_rsa_padding(ctx, padding) <= 0)
-    goto exit;
+  inline void set_ec(int curve_nid) {
+    type_ = kKeyTypeEC;
+    curve_nid_ = curve_nid;
+  }
 
-  if (EVP_PKEY_cipher(ctx, nullptr, out_len, data, len) <= 0)
-    goto exit;
+  inline void set_public_encoding(KeyEncoding encoding, bool pem) {
+    public_encoding_ = encoding;
+    public_pem_ = pem;
+  }
 
-  *out = new unsigned char[*out_len];
+  inline void set_private_encoding(KeyEncoding encoding, bool pem) {
+    private_encoding_ = encoding;
+    private_pem_ = pem;
+  }
 
-  if (EVP_PKEY_cipher(ctx, *out, out_len, data, len) <= 0)
-    goto exit;
+  inline void set_cipher(const EVP_CIPHER* cipher,
+                         const char* passphrase,
+                         size_t len) {
+    cipher_ = cipher;
+    passphrase_ = node::Malloc(len + 1);
+    memcpy(passphrase_, passphrase, len);
+    passphrase_[len] = '\0';
+    passphrase_len_ = len;
+  }
 
-  fatal = false;
+  int Results(Local<Value>* argv) override {
+    argv[0] = KeyValue(public_bio_, public_pem_);
+    argv[1] = KeyValue(private_bio_, private_pem_);
+    return 2;
+  }
 
- exit:
-  if (x509 != nullptr)
-    X509_free(x509);
-  if (pkey != nullptr)
-    EVP_PKEY_free(pkey);
-  if (bp != nullptr)
-    BIO_free_all(bp);
-  if (ctx != nullptr)
-    EVP_PKEY_CTX_free(ctx);
+  size_t self_size() const override { return sizeof(*this); }
 
-  return !fatal;
-}
+ protected:
+  bool Generate() override {
+    EVP_PKEY* pkey = GenerateKey();
+    if (pkey == nullptr)
+      return false;
+    public_bio_ = BIO_new(BIO_s_mem());
+    private_bio_ = BIO_new(BIO_s_mem());
+    bool ok = public_bio_ != nullptr &&
+              private_bio_ != nullptr &&
+              WritePublicKey(pkey) &&
+              WritePrivateKey(pkey);
+    EVP_PKEY_free(pkey);
+    return ok;
+  }
 
+ private:
+  EVP_PKEY* GenerateKey() {
+    EVP_PKEY* pkey = EVP_PKEY_new();
+    if (pkey == nullptr)
+      return nullptr;
+
+    if (type_ == kKeyTypeRSA) {
+      RSA* rsa = RSA_new();
+      BIGNUM* e = BN_new();
+      bool ok = rsa != nullptr &&
+                e != nullptr &&
+                BN_set_word(e, exponent_) &&
+                RSA_generate_key_ex(rsa, modulus_bits_, e, nullptr) &&
+                EVP_PKEY_assign_RSA(pkey, rsa);
+      if (e != nullptr)
+        BN_free(e);
+      if (!ok) {
+        if (rsa != nullptr)
+          RSA_free(rsa);
+        EVP_PKEY_free(pkey);
+        return nullptr;
+      }
+    } else {
+      EC_KEY* ec = EC_KEY_new_by_curve_name(curve_nid_);
+      if (ec != nullptr)
+        EC_KEY_set_asn1_flag(ec, OPENSSL_EC_NAMED_CURVE);
+      if (ec == nullptr ||
+          !EC_KEY_generate_key(ec) ||
+          !EVP_PKEY_assign_EC_KEY(pkey, ec)) {
+        if (ec != nullptr)
+          EC_KEY_free(ec);
+        EVP_PKEY_free(pkey);
+        return nullptr;
+      }
+    }
+    return pkey;
+  }
 
-template <PublicKeyCipher::Operation operation,
-          PublicKeyCipher::EVP_PKEY_cipher_init_t EVP_PKEY_cipher_init,
-          PublicKeyCipher::EVP_PKEY_cipher_t EVP_PKEY_cipher>
-void PublicKeyCipher::Cipher(const FunctionCallbackInfo<Value>& args) {
-  Environment* env = Environment::GetCurrent(args);
+  bool WritePublicKey(EVP_PKEY* pkey) {
+    if (public_encoding_ == kKeyEncodingPKCS1) {
+      RSA* rsa = EVP_PKEY_get1_RSA(pkey);
+      int r = public_pem_ ? PEM_write_bio_RSAPublicKey(public_bio_, rsa)
+                          : i2d_RSAPublicKey_bio(public_bio_, rsa);
+      RSA_free(rsa);
+      return r == 1;
+    }
+    return (public_pem_ ? PEM_write_bio_PUBKEY(public_bio_, pkey)
+                        : i2d_PUBKEY_bio(public_bio_, pkey)) == 1;
+  }
 
-  THROW_AND_RETURN_IF_NOT_BUFFER(args[0], "Key");
-  char* kbuf = Buffer::Data(args[0]);
-  ssize_t klen = Buffer::Length(args[0]);
+  bool WritePrivateKey(EVP_PKEY* pkey) {
+    unsigned char* pass = reinterpret_cast<unsigned char*>(passphrase_);
+    int r;
+    if (private_encoding_ == kKeyEncodingPKCS1) {
+      RSA* rsa = EVP_PKEY_get1_RSA(pkey);
+      r = private_pem_ ?
+          PEM_write_bio_RSAPrivateKey(private_bio_, rsa, cipher_, pass,
+                                      passphrase_len_, nullptr, nullptr) :
+          i2d_RSAPrivateKey_bio(private_bio_, rsa);
+      RSA_free(rsa);
+    } else if (private_encoding_ == kKeyEncodingSEC1) {
+      EC_KEY* ec = EVP_PKEY_get1_EC_KEY(pkey);
+      r = private_pem_ ?
+          PEM_write_bio_ECPrivateKey(private_bio_, ec, cipher_, pass,
+                                     passphrase_len_, nullptr, nullptr) :
+          i2d_ECPrivateKey_bio(private_bio_, ec);
+      EC_KEY_free(ec);
+    } else {
+      r = private_pem_ ?
+          PEM_write_bio_PKCS8PrivateKey(private_bio_, pkey, cipher_,
+                                        passphrase_, passphrase_len_,
+                                        nullptr, nullptr) :
+          i2d_PKCS8PrivateKey_bio(private_bio_, pkey, cipher_,
+                                  passphrase_, passphrase_len_,
+                                  nullptr, nullptr);
+    }
+    return r == 1;
+  }
 
-  THROW_AND_RETURN_IF_NOT_BUFFER(args[1], "Data");
-  char* buf = Buffer::Data(args[1]);
-  ssize_t len = Buffer::Length(args[1]);
+  Local<Value> KeyValue(BIO* bio, bool pem) {
+    BUF_MEM* mem;
+    BIO_get_mem_ptr(bio, &mem);
+    if (pem) {
+      return String::NewFromUtf8(env()->isolate(),
+                                 mem->data,
+                                 String::kNormalString,
+                                 mem->length);
+    }
+    return Buffer::Copy(env(), mem->data, mem->length).ToLocalChecked();
+  }
+
+  KeyType type_;
+  int modulus_bits_;
+  unsigned int exponent_;
+  int curve_nid_;
+  KeyEncoding public_encoding_;
+  bool public_pem_;
+  KeyEncoding private_encoding_;
+  bool private_pem_;
+  const EVP_CIPHER* cipher_;
+  char* passphrase_;
+  int passphrase_len_;
+  BIO* public_bio_;
+  BIO* private_bio_;
+};
 
-  int padding = args[2]->Uint32Value();
 
-  String::Utf8Value passphrase(args[3]);
+static bool ParseKeyEncoding(const node::Utf8Value& name,
+                             KeyPairRequest::KeyEncoding* encoding) {
+  if (strcmp(*name, "spki") == 0)
+    *encoding = KeyPairRequest::kKeyEncodingSPKI;
+  else if (strcmp(*name, "pkcs1") == 0)
+    *encoding = KeyPairRequest::kKeyEncodingPKCS1;
+  else if (strcmp(*name, "pkcs8") == 0)
+    *encoding = KeyPairRequest::kKeyEncodingPKCS8;
+  else if (strcmp(*name, "sec1") == 0)
+    *encoding = KeyPairRequest::kKeyEncodingSEC1;
+  else
+    return false;
+  return true;
+}
 
-  unsigned char* out_value = nullptr;
-  size_t out_len = 0;
 
-  ClearErrorOnReturn clear_error_on_return;
-  (void) &clear_error_on_return;  // Silence compiler warning.
+// generateKeyPair(type, modulusLengthOrCurve, publicExponent, publicType,
+//                 publicPem, privateType, privatePem, cipher, passphrase
+//                 [, ondone])
+//
+// The options have been validated in JS.  Without |ondone| the keys are
+// returned as an array.
+void GenerateKeyPair(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
 
-  bool r = Cipher<operation, EVP_PKEY_cipher_init, EVP_PKEY_cipher>(
-      kbuf,
-      klen,
-      args.Length() >= 3 && !args[2]->IsNull() ? *passphrase : nullptr,
-      padding,
-      reinterpret_cast<const unsigned char*>(buf),
-      len,
-      &out_value,
-      &out_len);
+  Local<Object> obj = env->NewInternalFieldObject();
+  KeyPairRequest* req = new KeyPairRequest(env, obj);
 
-  if (out_len == 0 || !r) {
-    delete[] out_value;
-    out_value = nullptr;
-    out_len = 0;
-    if (!r) {
-      return ThrowCryptoError(env,
-        ERR_get_error());
+  const node::Utf8Value type(env->isolate(), args[0]);
+  if (strcmp(*type, "rsa") == 0) {
+    CHECK(args[1]->IsUint32());
+    CHECK(args[2]->IsUint32());
+    req->set_rsa(args[1]->Uint32Value(), args[2]->Uint32Value());
+  } else {
+    CHECK_EQ(strcmp(*type, "ec"), 0);
+    const node::Utf8Value curve(env->isolate(), args[1]);
+    int nid = OBJ_sn2nid(*curve);
+    if (nid == NID_undef)
+      nid = EC_curve_nist2nid(*curve);
+    if (nid == NID_undef) {
+      delete req;
+      return env->ThrowTypeError("Invalid EC curve name");
     }
+    req->set_ec(nid);
+  }
+
+  KeyPairRequest::KeyEncoding public_encoding;
+  KeyPairRequest::KeyEncoding private_encoding;
+  CHECK(ParseKeyEncoding(node::Utf8Value(env->isolate(), args[3]),
+                         &public_encoding));
+  CHECK(ParseKeyEncoding(node::Utf8Value(env->isolate(), args[5]),
+                         &private_encoding));
+  req->set_public_encoding(public_encoding, args[4]->IsTrue());
+  req->set_private_encoding(private_encoding, args[6]->IsTrue());
+
+  if (args[7]->IsString()) {
+    const node::Utf8Value cipher_name(env->isolate(), args[7]);
+    const EVP_CIPHER* cipher = EVP_get_cipherbyname(*cipher_name);
+    if (cipher == nullptr) {
+      delete req;
+      return env->ThrowTypeError("Unknown cipher");
+    }
+    CHECK(Buffer::HasInstance(args[8]));
+    req->set_cipher(cipher, Buffer::Data(args[8]), Buffer::Length(args[8]));
   }
 
-  Local<Object> vbuf = Buffer::Copy(
-      env,
-      reinterpret_cast<char*>(out_value),
-      out_len).ToLocalChecked();
-  args.GetReturnValue().Set(vbuf);
-  delete[] out_value;
+  if (args[9]->IsFunction())
+    return QueueKeyGenRequest(env, req, obj, Local<Object>(), args[9]);
+
+  env->PrintSyncTrace();
+  req->DoWork();
+  if (!req->ok()) {
+    env->isolate()->ThrowException(req->ErrorValue());
+  } else {
+    Local<Value> keys[2];
+    req->Results(keys);
+    Local<Array> result = Array::New(env->isolate(), 2);
+    result->Set(0, keys[0]);
+    result->Set(1, keys[1]);
+    args.GetReturnValue().Set(result);
+  }
+  delete req;
+}
+
+
+// generateDHParams(primeLength, generator, ondone)
+void GenerateDHParams(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsInt32());
+  CHECK(args[1]->IsInt32());
+  CHECK(args[2]->IsFunction());
+
+  Local<Object> obj = env->NewInternalFieldObject();
+  DHParamsRequest* req = new DHParamsRequest(env,
+                                             obj,
+                                             args[0]->Int32Value(),
+                                             args[1]->Int32Value());
+  QueueKeyGenRequest(env, req, obj, Local<Object>(), args[2]);
 }
 
 
@@ -4567,6 +6970,22 @@ bool DiffieHellman::Init(const char* p, int p_len, const char* g, int g_len) {
 }
 
 
+bool DiffieHellman::Init(const char* p,
+                         int p_len,
+                         const char* g,
+                         int g_len,
+                         int verify_error) {
+  dh = DH_new();
+  dh->p = BN_bin2bn(reinterpret_cast<const unsigned char*>(p), p_len, 0);
+  dh->g = BN_bin2bn(reinterpret_cast<const unsigned char*>(g), g_len, 0);
+  if (dh->p == nullptr || dh->g == nullptr)
+    return false;
+  verifyError_ = verify_error;
+  initialised_ = true;
+  return true;
+}
+
+
 void DiffieHellman::DiffieHellmanGroup(
     const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
@@ -4606,7 +7025,15 @@ void DiffieHellman::New(const FunctionCallbackInfo<Value>& args) {
       new DiffieHellman(env, args.This());
   bool initialized = false;
 
-  if (args.Length() == 2) {
+  if (args.Length() == 3) {
+    // A group from generateDHParams(), which has been checked already.
+    CHECK(args[2]->IsInt32());
+    initialized = diffieHellman->Init(Buffer::Data(args[0]),
+                                      Buffer::Length(args[0]),
+                                      Buffer::Data(args[1]),
+                                      Buffer::Length(args[1]),
+                                      args[2]->Int32Value());
+  } else if (args.Length() == 2) {
     if (args[0]->IsInt32()) {
       if (args[1]->IsInt32()) {
         initialized = diffieHellman->Init(args[0]->Int32Value(),
@@ -4642,6 +7069,22 @@ void DiffieHellman::GenerateKeys(const FunctionCallbackInfo<Value>& args) {
     return ThrowCryptoError(env, ERR_get_error(), "Not initialized");
   }
 
+  if (diffieHellman->pending_)
+    return env->ThrowError("Key generation in progress");
+
+  if (args[0]->IsFunction()) {
+    // Keys are generated for a copy of the group and an existing private
+    // key, and replace the object's when they are done.
+    DH* dh = DHparams_dup(diffieHellman->dh);
+    if (dh == nullptr)
+      return ThrowCryptoError(env, ERR_get_error(), "Key generation failed");
+    if (diffieHellman->dh->priv_key != nullptr)
+      dh->priv_key = BN_dup(diffieHellman->dh->priv_key);
+    Local<Object> obj = env->NewInternalFieldObject();
+    DHKeysRequest* req = new DHKeysRequest(env, obj, diffieHellman, dh);
+    return QueueKeyGenRequest(env, req, obj, args.Holder(), args[0]);
+  }
+
   if (!DH_generate_key(diffieHellman->dh)) {
     return ThrowCryptoError(env, ERR_get_error(), "Key generation failed");
   }
@@ -4823,6 +7266,9 @@ void DiffieHellman::SetPublicKey(const FunctionCallbackInfo<Value>& args) {
     return ThrowCryptoError(env, ERR_get_error(), "Not initialized");
   }
 
+  if (diffieHellman->pending_)
+    return env->ThrowError("Key generation in progress");
+
   if (args.Length() == 0) {
     return env->ThrowError("Public key argument is mandatory");
   } else {
@@ -4843,6 +7289,9 @@ void DiffieHellman::SetPrivateKey(const FunctionCallbackInfo<Value>& args) {
     return ThrowCryptoError(env, ERR_get_error(), "Not initialized");
   }
 
+  if (diffieHellman->pending_)
+    return env->ThrowError("Key generation in progress");
+
   if (args.Length() == 0) {
     return env->ThrowError("Private key argument is mandatory");
   } else {
@@ -4925,6 +7374,19 @@ void ECDH::GenerateKeys(const FunctionCallbackInfo<Value>& args) {
   ECDH* ecdh;
   ASSIGN_OR_RETURN_UNWRAP(&ecdh, args.Holder());
 
+  if (ecdh->pending_)
+    return env->ThrowError("Key generation in progress");
+
+  if (args[0]->IsFunction()) {
+    EC_KEY* key = EC_KEY_new_by_curve_name(
+        EC_GROUP_get_curve_name(ecdh->group_));
+    if (key == nullptr)
+      return env->ThrowError("Failed to create EC_KEY using curve name");
+    Local<Object> obj = env->NewInternalFieldObject();
+    ECDHKeysRequest* req = new ECDHKeysRequest(env, obj, ecdh, key);
+    return QueueKeyGenRequest(env, req, obj, args.Holder(), args[0]);
+  }
+
   if (!EC_KEY_generate_key(ecdh->key_))
     return env->ThrowError("Failed to generate EC_KEY");
 }
@@ -5057,6 +7519,9 @@ void ECDH::SetPrivateKey(const FunctionCallbackInfo<Value>& args) {
   ECDH* ecdh;
   ASSIGN_OR_RETURN_UNWRAP(&ecdh, args.Holder());
 
+  if (ecdh->pending_)
+    return env->ThrowError("Key generation in progress");
+
   THROW_AND_RETURN_IF_NOT_BUFFER(args[0], "Private key");
 
   BIGNUM* priv = BN_bin2bn(
@@ -5111,6 +7576,9 @@ void ECDH::SetPublicKey(const FunctionCallbackInfo<Value>& args) {
   ECDH* ecdh;
   ASSIGN_OR_RETURN_UNWRAP(&ecdh, args.Holder());
 
+  if (ecdh->pending_)
+    return env->ThrowError("Key generation in progress");
+
   THROW_AND_RETURN_IF_NOT_BUFFER(args[0], "Public key");
 
   EC_POINT* pub = ecdh->BufferToPoint(Buffer::Data(args[0].As<Object>()),
@@ -5421,14 +7889,128 @@ void PBKDF2(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+// Random bytes for small requests are copied out of a per-environment pool
+// instead of calling RAND_bytes() each time, or going through the threadpool
+// for asynchronous requests.  The pool is refilled on the threadpool in one
+// large block when it runs low; requests that find it short of bytes take
+// the direct path in the meantime.
+class RandomPool {
+ public:
+  // Requests up to this size are served from the pool.
+  static const size_t kMaxRequest = 256;
+  static const size_t kSize = 32 * 1024;
+
+  explicit RandomPool(Environment* env)
+      : env_(env), data_(nullptr), available_(0), refill_(nullptr) {
+  }
+
+  ~RandomPool() {
+    // A refill that is still in flight cleans up after itself.
+    if (refill_ != nullptr)
+      refill_->pool = nullptr;
+    if (data_ != nullptr) {
+      OPENSSL_cleanse(data_, kSize);
+      free(data_);
+    }
+  }
+
+  static RandomPool* From(Environment* env) {
+    RandomPool* pool = env->random_pool();
+    if (pool == nullptr) {
+      pool = new RandomPool(env);
+      env->set_random_pool(pool);
+    }
+    return pool;
+  }
+
+  // Copies |size| bytes out of the pool and wipes them there.  Returns false
+  // if the pool is short of bytes.
+  bool Take(char* out, size_t size) {
+    if (size > kMaxRequest)
+      return false;
+    if (available_ < kSize / 4)
+      Refill();
+    if (size > available_)
+      return false;
+    available_ -= size;
+    memcpy(out, data_ + available_, size);
+    OPENSSL_cleanse(data_ + available_, size);
+    return true;
+  }
+
+ private:
+  struct RefillRequest {
+    uv_work_t work_req;
+    RandomPool* pool;
+    char data[kSize];
+    bool ok;
+  };
+
+  void Refill() {
+    if (refill_ != nullptr)
+      return;
+    refill_ = new RefillRequest();
+    refill_->pool = this;
+    refill_->ok = false;
+    uv_queue_work(env_->event_loop(),
+                  &refill_->work_req,
+                  RefillWork,
+                  RefillAfter);
+  }
+
+  static void RefillWork(uv_work_t* work_req) {
+    RefillRequest* req = ContainerOf(&RefillRequest::work_req, work_req);
+    CheckEntropy();
+    req->ok = RAND_bytes(reinterpret_cast<unsigned char*>(req->data),
+                         kSize) == 1;
+  }
+
+  static void RefillAfter(uv_work_t* work_req, int status) {
+    CHECK_EQ(status, 0);
+    RefillRequest* req = ContainerOf(&RefillRequest::work_req, work_req);
+    RandomPool* pool = req->pool;
+    // Bytes that RAND_bytes() could not vouch for are not pooled; the
+    // direct path reports the error on the next request.
+    if (pool != nullptr) {
+      pool->refill_ = nullptr;
+      if (req->ok) {
+        if (pool->data_ == nullptr)
+          pool->data_ = node::Malloc(kSize);
+        memcpy(pool->data_, req->data, kSize);
+        pool->available_ = kSize;
+      }
+    }
+    OPENSSL_cleanse(req->data, kSize);
+    delete req;
+  }
+
+  Environment* const env_;
+  char* data_;
+  size_t available_;
+  RefillRequest* refill_;
+};
+
+
+void DeleteRandomPool(RandomPool* pool) {
+  delete pool;
+}
+
+
 // Only instantiate within a valid HandleScope.
 class RandomBytesRequest : public AsyncWrap {
  public:
-  RandomBytesRequest(Environment* env, Local<Object> object, size_t size)
+  enum FreeMode { FREE_DATA, DONT_FREE_DATA };
+
+  RandomBytesRequest(Environment* env,
+                     Local<Object> object,
+                     size_t size,
+                     char* data,
+                     FreeMode free_mode)
       : AsyncWrap(env, object, AsyncWrap::PROVIDER_CRYPTO),
         error_(0),
         size_(size),
-        data_(node::Malloc(size)) {
+        data_(data),
+        free_mode_(free_mode) {
     Wrap(object, this);
   }
 
@@ -5449,8 +8031,14 @@ class RandomBytesRequest : public AsyncWrap {
     return data_;
   }
 
+  inline FreeMode free_mode() const {
+    return free_mode_;
+  }
+
   inline void release() {
-    free(data_);
+    if (free_mode_ == FREE_DATA)
+      free(data_);
+    data_ = nullptr;
     size_ = 0;
   }
 
@@ -5477,6 +8065,7 @@ class RandomBytesRequest : public AsyncWrap {
   unsigned long error_;  // NOLINT(runtime/int)
   size_t size_;
   char* data_;
+  const FreeMode free_mode_;
 };
 
 
@@ -5510,6 +8099,11 @@ void RandomBytesCheck(RandomBytesRequest* req, Local<Value> argv[2]) {
     argv[0] = Exception::Error(OneByteString(req->env()->isolate(), errmsg));
     argv[1] = Null(req->env()->isolate());
     req->release();
+  } else if (req->free_mode() == RandomBytesRequest::DONT_FREE_DATA) {
+    // The caller filled its own buffer and passes that on.
+    argv[0] = Null(req->env()->isolate());
+    argv[1] = Null(req->env()->isolate());
+    req->release();
   } else {
     char* data = nullptr;
     size_t size;
@@ -5534,11 +8128,58 @@ void RandomBytesAfter(uv_work_t* work_req, int status) {
 }
 
 
+static void QueueRandomBytes(Environment* env,
+                             char* data,
+                             size_t size,
+                             RandomBytesRequest::FreeMode free_mode,
+                             Local<Value> buffer,
+                             Local<Value> ondone) {
+  Local<Object> obj = env->NewInternalFieldObject();
+  RandomBytesRequest* req =
+      new RandomBytesRequest(env, obj, size, data, free_mode);
+  obj->Set(env->ondone_string(), ondone);
+  if (!buffer.IsEmpty())
+    obj->Set(env->buffer_string(), buffer);
+
+  if (env->in_domain())
+    obj->Set(env->domain_string(), env->domain_array()->Get(0));
+  uv_queue_work(env->event_loop(),
+                req->work_req(),
+                RandomBytesWork,
+                RandomBytesAfter);
+}
+
+
+static bool FillRandomBytes(Environment* env, char* data, size_t size) {
+  env->PrintSyncTrace();
+  CheckEntropy();
+  const int r = RAND_bytes(reinterpret_cast<unsigned char*>(data), size);
+  if (r == 1)
+    return true;
+  char errmsg[256] = "Operation not supported";
+  if (r == 0)
+    ERR_error_string_n(ERR_get_error(), errmsg, sizeof errmsg);
+  env->isolate()->ThrowException(
+      Exception::Error(OneByteString(env->isolate(), errmsg)));
+  return false;
+}
+
+
+// Requests with a callback can only skip the threadpool when nobody watches
+// them through the async_wrap hooks.
+static bool UseRandomPool(Environment* env, Local<Value> ondone) {
+  return !ondone->IsFunction() || !env->async_wrap_callbacks_enabled();
+}
+
+
+// randomBytes(size[, ondone])
+//
+// Small requests are served from the pool, also when |ondone| is given: the
+// buffer is returned then and the caller is responsible for calling back.
+// Returns undefined if the request has been queued instead.
 void RandomBytes(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
 
-  // maybe allow a buffer to write to? cuts down on object creation
-  // when generating random data in a loop
   if (!args[0]->IsUint32()) {
     return env->ThrowTypeError("size must be a number >= 0");
   }
@@ -5547,31 +8188,49 @@ void RandomBytes(const FunctionCallbackInfo<Value>& args) {
   if (size < 0 || size > Buffer::kMaxLength)
     return env->ThrowRangeError("size is not a valid Smi");
 
-  Local<Object> obj = env->NewInternalFieldObject();
-  RandomBytesRequest* req = new RandomBytesRequest(env, obj, size);
+  char* data = node::Malloc(size);
+  if (!UseRandomPool(env, args[1]) ||
+      !RandomPool::From(env)->Take(data, size)) {
+    if (args[1]->IsFunction()) {
+      return QueueRandomBytes(env, data, size, RandomBytesRequest::FREE_DATA,
+                              Local<Value>(), args[1]);
+    }
+    if (!FillRandomBytes(env, data, size)) {
+      free(data);
+      return;
+    }
+  }
+  args.GetReturnValue().Set(Buffer::New(env, data, size).ToLocalChecked());
+}
 
-  if (args[1]->IsFunction()) {
-    obj->Set(FIXED_ONE_BYTE_STRING(args.GetIsolate(), "ondone"), args[1]);
 
-    if (env->in_domain())
-      obj->Set(env->domain_string(), env->domain_array()->Get(0));
-    uv_queue_work(env->event_loop(),
-                  req->work_req(),
-                  RandomBytesWork,
-                  RandomBytesAfter);
-    args.GetReturnValue().Set(obj);
-  } else {
-    env->PrintSyncTrace();
-    Local<Value> argv[2];
-    RandomBytesWork(req->work_req());
-    RandomBytesCheck(req, argv);
-    delete req;
+// randomFill(buffer, offset, size[, ondone])
+//
+// Like randomBytes(), but writes into |buffer|.  Returns true if the bytes
+// are there when the call returns, false if |ondone| will be called.
+void RandomFill(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
 
-    if (!argv[0]->IsNull())
-      env->isolate()->ThrowException(argv[0]);
-    else
-      args.GetReturnValue().Set(argv[1]);
+  THROW_AND_RETURN_IF_NOT_BUFFER(args[0], "Buffer");
+  CHECK(args[1]->IsUint32());
+  CHECK(args[2]->IsUint32());
+  const size_t offset = args[1]->Uint32Value();
+  const size_t size = args[2]->Uint32Value();
+  CHECK_LE(offset, Buffer::Length(args[0]));
+  CHECK_LE(size, Buffer::Length(args[0]) - offset);
+
+  char* data = Buffer::Data(args[0]) + offset;
+  if (!UseRandomPool(env, args[3]) ||
+      !RandomPool::From(env)->Take(data, size)) {
+    if (args[3]->IsFunction()) {
+      QueueRandomBytes(env, data, size, RandomBytesRequest::DONT_FREE_DATA,
+                       args[0], args[3]);
+      return args.GetReturnValue().Set(false);
+    }
+    if (!FillRandomBytes(env, data, size))
+      return;
   }
+  args.GetReturnValue().Set(true);
 }
 
 
@@ -5843,6 +8502,35 @@ void TimingSafeEqual(const FunctionCallbackInfo<Value>& args) {
   return args.GetReturnValue().Set(CRYPTO_memcmp(buf1, buf2, buf_length) == 0);
 }
 
+void CreateSessionCache(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  CHECK(args[0]->IsString());
+  CHECK(args[1]->IsUint32());
+  node::Utf8Value path(env->isolate(), args[0]);
+  const int fd = session_cache::Create(*path, args[1]->Uint32Value());
+  if (fd < 0)
+    return env->ThrowUVException(fd, "open", nullptr, *path);
+  args.GetReturnValue().Set(fd);
+}
+
+
+void OpenSessionCache(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  CHECK(args[0]->IsInt32());
+  CHECK(!session_cache::IsOpen());
+  const int err = session_cache::Open(args[0]->Int32Value());
+  if (err != 0)
+    return env->ThrowUVException(err, "mmap");
+}
+
+
+void IsSessionCacheOpen(const FunctionCallbackInfo<Value>& args) {
+  args.GetReturnValue().Set(session_cache::IsOpen());
+}
+
+
 void InitCryptoOnce() {
   SSL_load_error_strings();
   OPENSSL_no_config();
@@ -5993,9 +8681,17 @@ void InitCrypto(Local<Object> target,
 #endif  // !OPENSSL_NO_ENGINE
   env->SetMethod(target, "getFipsCrypto", GetFipsCrypto);
   env->SetMethod(target, "setFipsCrypto", SetFipsCrypto);
+  env->SetMethod(target, "hash", OneShotHash);
+  env->SetMethod(target, "hashMany", HashMany);
   env->SetMethod(target, "PBKDF2", PBKDF2);
   env->SetMethod(target, "randomBytes", RandomBytes);
+  env->SetMethod(target, "randomFill", RandomFill);
+  env->SetMethod(target, "generateDHParams", GenerateDHParams);
+  env->SetMethod(target, "generateKeyPair", GenerateKeyPair);
   env->SetMethod(target, "timingSafeEqual", TimingSafeEqual);
+  env->SetMethod(target, "createSessionCache", CreateSessionCache);
+  env->SetMethod(target, "openSessionCache", OpenSessionCache);
+  env->SetMethod(target, "isSessionCacheOpen", IsSessionCacheOpen);
   env->SetMethod(target, "getSSLCiphers", GetSSLCiphers);
   env->SetMethod(target, "getCiphers", GetCiphers);
   env->SetMethod(target, "getHashes", GetHashes);
@@ -81,6 +81,21 @@ class SecureContext : public BaseObject {
   SSL_CTX* ctx_;
   X509* cert_;
   X509* issuer_;
+  // Resume sessions from, and add new ones to, the cluster-wide cache.
+  // Entries only match servers with the same scope, a digest of the
+  // settings that decide whether a session may be resumed.
+  bool shared_session_cache_;
+  unsigned char shared_session_cache_scope_[32];
+  // Identify the credentials this context uses in the credential caches,
+  // empty when they are not shared with other contexts.
+  std::string key_digest_;
+  std::string cert_chain_digest_;
+  std::string cert_store_digest_;
+  // CAs given to addCACert() that BuildCertStore() has yet to parse.
+  std::vector<std::string> pending_ca_certs_;
+  std::string pending_ca_digest_;
+
+  void BuildCertStore();
 
   static const int kMaxSessionSize = 10 * 1024;
 
@@ -91,6 +106,9 @@ class SecureContext : public BaseObject {
   static const int kTicketKeyNameIndex = 3;
   static const int kTicketKeyIVIndex = 4;
 
+  // See EnableTicketKeyRotation
+  static const unsigned int kMaxTicketKeys = 16;
+
  protected:
   static const int64_t kExternalSize = sizeof(SSL_CTX);
 
@@ -117,6 +135,12 @@ class SecureContext : public BaseObject {
       const v8::FunctionCallbackInfo<v8::Value>& args);
   static void EnableTicketKeyCallback(
       const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void EnableSharedSessionCache(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetCredentialFingerprint(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void EnableTicketKeyRotation(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
   static void CtxGetter(v8::Local<v8::String> property,
                         const v8::PropertyCallbackInfo<v8::Value>& info);
 
@@ -129,12 +153,43 @@ class SecureContext : public BaseObject {
                                EVP_CIPHER_CTX* ectx,
                                HMAC_CTX* hctx,
                                int enc);
+  static int TicketKeyRingCallback(SSL* ssl,
+                                   unsigned char* name,
+                                   unsigned char* iv,
+                                   EVP_CIPHER_CTX* ectx,
+                                   HMAC_CTX* hctx,
+                                   int enc);
+
+  struct TicketKey {
+    unsigned char name[16];
+    unsigned char hmac_key[16];
+    unsigned char aes_key[16];
+  };
+
+  void DeriveTicketKeys(uint64_t epoch);
+  void ReleaseCredentials();
+
+  // Ticket keys derived from a secret and the current rotation period, so
+  // that processes which share the secret agree on the keys without talking
+  // to each other.  ticket_keys_[0] encrypts new tickets, the others are only
+  // used to decrypt the tickets of the previous periods.
+  unsigned char ticket_key_secret_[48];
+  uint32_t ticket_key_interval_;
+  uint32_t ticket_key_count_;
+  uint64_t ticket_key_epoch_;
+  bool ticket_keys_derived_;
+  TicketKey ticket_keys_[kMaxTicketKeys];
 
   SecureContext(Environment* env, v8::Local<v8::Object> wrap)
       : BaseObject(env, wrap),
         ctx_(nullptr),
         cert_(nullptr),
-        issuer_(nullptr) {
+        issuer_(nullptr),
+        shared_session_cache_(false),
+        ticket_key_interval_(0),
+        ticket_key_count_(0),
+        ticket_key_epoch_(0),
+        ticket_keys_derived_(false) {
     MakeWeak<SecureContext>(this);
     env->isolate()->AdjustAmountOfExternalAllocatedMemory(kExternalSize);
   }
@@ -145,6 +200,9 @@ class SecureContext : public BaseObject {
     }
 
     env()->isolate()->AdjustAmountOfExternalAllocatedMemory(-kExternalSize);
+    ReleaseCredentials();
+    pending_ca_certs_.clear();
+    pending_ca_digest_.clear();
     SSL_CTX_free(ctx_);
     if (cert_ != nullptr)
       X509_free(cert_);
@@ -175,6 +233,7 @@ class SSLWrap {
         cert_cb_(nullptr),
         cert_cb_arg_(nullptr),
         cert_cb_running_(false) {
+    sc->BuildCertStore();
     ssl_ = SSL_new(sc->ctx_);
     env_->isolate()->AdjustAmountOfExternalAllocatedMemory(kExternalSize);
     CHECK_NE(ssl_, nullptr);
@@ -430,7 +489,14 @@ class CipherBase : public BaseObject {
               const char* iv,
               int iv_len);
   bool Update(const char* data, int len, unsigned char** out, int* out_len);
+  bool UpdateInto(const char* data,
+                  int len,
+                  unsigned char* out,
+                  int* out_len);
+  int UpdateSize(int len) const;
   bool Final(unsigned char** out, int *out_len);
+  bool FinalInto(unsigned char* out, int *out_len);
+  int FinalSize() const;
   bool SetAutoPadding(bool auto_padding);
 
   bool IsAuthenticatedMode() const;
@@ -442,7 +508,9 @@ class CipherBase : public BaseObject {
   static void Init(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void InitIv(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Update(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void UpdateInto(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Final(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void FinalInto(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void SetAutoPadding(const v8::FunctionCallbackInfo<v8::Value>& args);
 
   static void GetAuthTag(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -483,22 +551,30 @@ class Hmac : public BaseObject {
  protected:
   void HmacInit(const char* hash_type, const char* key, int key_len);
   bool HmacUpdate(const char* data, int len);
-  bool HmacDigest(unsigned char** md_value, unsigned int* md_len);
+  bool HmacDigest(unsigned char** md_value, unsigned int* md_len, bool reset);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void HmacInit(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void HmacUpdate(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void HmacUpdateAsync(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
   static void HmacDigest(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void HmacCopy(const v8::FunctionCallbackInfo<v8::Value>& args);
 
   Hmac(Environment* env, v8::Local<v8::Object> wrap)
       : BaseObject(env, wrap),
-        initialised_(false) {
+        initialised_(false),
+        pending_(false) {
     MakeWeak<Hmac>(this);
   }
 
  private:
+  friend class HashRequest;
+
   HMAC_CTX ctx_; /* coverity[member_decl] */
   bool initialised_;
+  // An update is running on the threadpool.
+  bool pending_;
 };
 
 class Hash : public BaseObject {
@@ -512,23 +588,32 @@ class Hash : public BaseObject {
   static void Initialize(Environment* env, v8::Local<v8::Object> target);
 
   bool HashInit(const char* hash_type);
+  bool HashCopy(const Hash* orig);
   bool HashUpdate(const char* data, int len);
 
  protected:
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void HashUpdate(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void HashUpdateAsync(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
   static void HashDigest(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void HashCopy(const v8::FunctionCallbackInfo<v8::Value>& args);
 
   Hash(Environment* env, v8::Local<v8::Object> wrap)
       : BaseObject(env, wrap),
-        initialised_(false) {
+        initialised_(false),
+        pending_(false) {
     MakeWeak<Hash>(this);
   }
 
  private:
+  friend class HashRequest;
+
   EVP_MD_CTX mdctx_; /* coverity[member_decl] */
   bool initialised_;
   bool finalized_;
+  // An update is running on the threadpool.
+  bool pending_;
 };
 
 class SignBase : public BaseObject {
@@ -540,12 +625,14 @@ class SignBase : public BaseObject {
     kSignNotInitialised,
     kSignUpdate,
     kSignPrivateKey,
-    kSignPublicKey
+    kSignPublicKey,
+    kSignPending
   } Error;
 
   SignBase(Environment* env, v8::Local<v8::Object> wrap)
       : BaseObject(env, wrap),
-        initialised_(false) {
+        initialised_(false),
+        pending_(false) {
   }
 
   ~SignBase() override {
@@ -555,10 +642,16 @@ class SignBase : public BaseObject {
   }
 
  protected:
+  friend class SignRequest;
+
   void CheckThrow(Error error);
+  v8::Local<v8::Value> ErrorValue(Error error,
+                                  unsigned long err);  // NOLINT(runtime/int)
 
   EVP_MD_CTX mdctx_; /* coverity[member_decl] */
   bool initialised_;
+  // sign() or verify() is running on the threadpool.
+  bool pending_;
 };
 
 class Sign : public SignBase {
@@ -650,6 +743,8 @@ class DiffieHellman : public BaseObject {
   bool Init(int primeLength, int g);
   bool Init(const char* p, int p_len, int g);
   bool Init(const char* p, int p_len, const char* g, int g_len);
+  bool Init(const char* p, int p_len, const char* g, int g_len,
+            int verify_error);
 
  protected:
   static void DiffieHellmanGroup(
@@ -671,16 +766,21 @@ class DiffieHellman : public BaseObject {
       : BaseObject(env, wrap),
         initialised_(false),
         verifyError_(0),
-        dh(nullptr) {
+        dh(nullptr),
+        pending_(false) {
     MakeWeak<DiffieHellman>(this);
   }
 
  private:
+  friend class DHKeysRequest;
+
   bool VerifyContext();
 
   bool initialised_;
   int verifyError_;
   DH* dh;
+  // Keys are being generated on the threadpool.
+  bool pending_;
 };
 
 class ECDH : public BaseObject {
@@ -698,7 +798,8 @@ class ECDH : public BaseObject {
   ECDH(Environment* env, v8::Local<v8::Object> wrap, EC_KEY* key)
       : BaseObject(env, wrap),
         key_(key),
-        group_(EC_KEY_get0_group(key_)) {
+        group_(EC_KEY_get0_group(key_)),
+        pending_(false) {
     MakeWeak<ECDH>(this);
     ASSERT_NE(group_, nullptr);
   }
@@ -718,6 +819,10 @@ class ECDH : public BaseObject {
 
   EC_KEY* key_;
   const EC_GROUP* group_;
+  // Keys are being generated on the threadpool.
+  bool pending_;
+
+  friend class ECDHKeysRequest;
 };
 
 bool EntropySource(unsigned char* buffer, size_t length);
@@ -1,4 +1,5 @@
 #include "node_crypto_bio.h"
+#include "node_mutex.h"
 #include "openssl/bio.h"
 #include "util.h"
 #include "util-inl.h"
@@ -7,6 +8,77 @@
 
 namespace node {
 
+// Block sizes handed out by the shared pool: the initial buffer of a BIO, the
+// initial buffer of a client's encrypted input and the size of the buffers
+// used once data is flowing.
+static const size_t kBlockSizes[] = { 1024, 4096, 16384 };
+static const size_t kBlockSizeCount = arraysize(kBlockSizes);
+
+// Don't keep more than this many bytes of unused blocks per size class.
+static const size_t kMaxPooledBytes = 2 * 1024 * 1024;
+
+// Free blocks are chained through their first bytes.
+static Mutex block_pool_mutex;
+static char* free_blocks[kBlockSizeCount];
+static size_t free_block_count[kBlockSizeCount];
+
+
+static char* AllocateBlock(size_t* len) {
+  for (size_t i = 0; i < kBlockSizeCount; i++) {
+    if (*len > kBlockSizes[i])
+      continue;
+    *len = kBlockSizes[i];
+    {
+      Mutex::ScopedLock scoped_lock(block_pool_mutex);
+      char* block = free_blocks[i];
+      if (block != nullptr) {
+        free_blocks[i] = *reinterpret_cast<char**>(block);
+        free_block_count[i]--;
+        return block;
+      }
+    }
+    break;
+  }
+  return new char[*len];
+}
+
+
+static void FreeBlock(char* block, size_t len) {
+  for (size_t i = 0; i < kBlockSizeCount; i++) {
+    if (len != kBlockSizes[i])
+      continue;
+    Mutex::ScopedLock scoped_lock(block_pool_mutex);
+    if (free_block_count[i] * len >= kMaxPooledBytes)
+      break;
+    *reinterpret_cast<char**>(block) = free_blocks[i];
+    free_blocks[i] = block;
+    free_block_count[i]++;
+    return;
+  }
+  delete[] block;
+}
+
+
+NodeBIO::Buffer::Buffer(Environment* env, size_t len) : env_(env),
+                                                        read_pos_(0),
+                                                        write_pos_(0),
+                                                        len_(len),
+                                                        next_(nullptr) {
+  data_ = AllocateBlock(&len_);
+  if (env_ != nullptr)
+    env_->isolate()->AdjustAmountOfExternalAllocatedMemory(len_);
+}
+
+
+NodeBIO::Buffer::~Buffer() {
+  FreeBlock(data_, len_);
+  if (env_ != nullptr) {
+    const int64_t len = static_cast<int64_t>(len_);
+    env_->isolate()->AdjustAmountOfExternalAllocatedMemory(-len);
+  }
+}
+
+
 const BIO_METHOD NodeBIO::method = {
   BIO_TYPE_MEM,
   "node.js SSL buffer",
@@ -269,6 +341,11 @@ size_t NodeBIO::Read(char* out, size_t size) {
   // Free all empty buffers, but write_head's child
   FreeEmpty();
 
+  // Hand everything back to the pool once drained, idle connections
+  // shouldn't hold on to their buffers.
+  if (length_ == 0)
+    Release();
+
   return bytes_read;
 }
 
@@ -449,11 +526,12 @@ void NodeBIO::Reset() {
   }
   write_head_ = read_head_;
   CHECK_EQ(length_, 0);
+  Release();
 }
 
 
-NodeBIO::~NodeBIO() {
-  if (read_head_ == nullptr)
+void NodeBIO::Release() {
+  if (read_head_ == nullptr || length_ != 0)
     return;
 
   Buffer* current = read_head_;
@@ -467,4 +545,26 @@ NodeBIO::~NodeBIO() {
   write_head_ = nullptr;
 }
 
+
+size_t NodeBIO::MemoryUsage() const {
+  if (read_head_ == nullptr)
+    return 0;
+
+  size_t total = 0;
+  Buffer* current = read_head_;
+  do {
+    total += current->len_;
+    current = current->next_;
+  } while (current != read_head_);
+
+  return total;
+}
+
+
+NodeBIO::~NodeBIO() {
+  // Drop whatever is still buffered, it can't be read anymore.
+  length_ = 0;
+  Release();
+}
+
 }  // namespace node
@@ -59,6 +59,11 @@ class NodeBIO {
   // Discard all available data
   void Reset();
 
+  // Memory optimization:
+  // Return all buffers to the shared block pool if there's no data left in
+  // them. The next write allocates afresh, starting from `initial_` bytes.
+  void Release();
+
   // Put `len` bytes from `data` into buffer
   void Write(const char* data, size_t size);
 
@@ -79,6 +84,10 @@ class NodeBIO {
     initial_ = initial;
   }
 
+  // Return the number of bytes of buffer memory currently held by this BIO,
+  // regardless of how much of it contains data.
+  size_t MemoryUsage() const;
+
   static inline NodeBIO* FromBIO(BIO* bio) {
     CHECK_NE(bio->ptr, nullptr);
     return static_cast<NodeBIO*>(bio->ptr);
@@ -102,23 +111,11 @@ class NodeBIO {
 
   class Buffer {
    public:
-    Buffer(Environment* env, size_t len) : env_(env),
-                                           read_pos_(0),
-                                           write_pos_(0),
-                                           len_(len),
-                                           next_(nullptr) {
-      data_ = new char[len];
-      if (env_ != nullptr)
-        env_->isolate()->AdjustAmountOfExternalAllocatedMemory(len);
-    }
-
-    ~Buffer() {
-      delete[] data_;
-      if (env_ != nullptr) {
-        const int64_t len = static_cast<int64_t>(len_);
-        env_->isolate()->AdjustAmountOfExternalAllocatedMemory(-len);
-      }
-    }
+    // Buffers of up to kThroughputBufferLength bytes are rounded up to one of
+    // a few fixed block sizes and taken from a process-wide free list, so
+    // that connections going idle and busy again don't churn malloc.
+    Buffer(Environment* env, size_t len);
+    ~Buffer();
 
     Environment* env_;
     size_t read_pos_;
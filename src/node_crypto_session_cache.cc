@@ -0,0 +1,327 @@
+#include "node_crypto_session_cache.h"
+#include "util.h"
+#include "util-inl.h"
+#include "uv.h"
+
+#include <openssl/err.h>
+
+#include <errno.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sched.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace node {
+namespace crypto {
+namespace session_cache {
+
+static_assert(sizeof(SessionCacheHeader) == 64,
+              "SessionCacheHeader layout changed");
+static_assert(sizeof(SessionCacheSlot) == kSessionCacheSlotSize,
+              "SessionCacheSlot layout changed");
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+              "Lock words must be plain 32 bits words in the mapping");
+
+static SessionCacheHeader* header;
+static SessionCacheSet* sets;
+
+static const char kMagic[8] = { 'N', 'O', 'D', 'E', 'T', 'L', 'S', 'C' };
+
+
+#ifdef _WIN32
+
+int Create(const char* path, uint32_t entries) {
+  return UV_ENOSYS;
+}
+
+
+int Open(int fd) {
+  return UV_ENOSYS;
+}
+
+#else  // !_WIN32
+
+static size_t MappingSize(uint32_t set_count) {
+  return sizeof(SessionCacheHeader) + set_count * sizeof(SessionCacheSet);
+}
+
+
+// Only map a regular file that belongs to us and that nobody else can read.
+static int CheckOwnership(int fd) {
+  struct stat s;
+  if (fstat(fd, &s) != 0)
+    return -errno;
+  if (!S_ISREG(s.st_mode) || s.st_uid != geteuid() || (s.st_mode & 077) != 0)
+    return UV_EPERM;
+  return 0;
+}
+
+
+int Create(const char* path, uint32_t entries) {
+  uint32_t set_count = (entries + kSessionCacheWays - 1) / kSessionCacheWays;
+  if (set_count == 0)
+    set_count = 1;
+  const size_t size = MappingSize(set_count);
+
+  // The file holds master secrets, keep it private to the user.  Never
+  // reuse or follow whatever is already there, someone else may own it.
+  int fd = open(path, O_RDWR | O_CREAT | O_EXCL | O_NOFOLLOW | O_CLOEXEC,
+                0600);
+  if (fd == -1)
+    return -errno;
+
+  // Nobody needs to find the file by name, the workers get the descriptor.
+  unlink(path);
+
+  int err = CheckOwnership(fd);
+  if (err == 0 && ftruncate(fd, size) != 0)
+    err = -errno;
+  if (err != 0) {
+    close(fd);
+    return err;
+  }
+
+  void* addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (addr == MAP_FAILED) {
+    err = -errno;
+    close(fd);
+    return err;
+  }
+
+  // The file was truncated to zero and extended, so all slots start out
+  // empty and all locks free.
+  SessionCacheHeader* h = static_cast<SessionCacheHeader*>(addr);
+  h->version = kSessionCacheVersion;
+  h->set_count = set_count;
+  h->ways = kSessionCacheWays;
+  h->slot_size = kSessionCacheSlotSize;
+  // Write the magic last so that a worker never maps a half-initialized file.
+  std::atomic_thread_fence(std::memory_order_release);
+  memcpy(h->magic, kMagic, sizeof(h->magic));
+
+  munmap(addr, size);
+  return fd;
+}
+
+
+int Open(int fd) {
+  CHECK_EQ(header, nullptr);
+
+  int err = CheckOwnership(fd);
+  struct stat s;
+  if (err == 0 && fstat(fd, &s) != 0)
+    err = -errno;
+  if (err != 0) {
+    close(fd);
+    return err;
+  }
+
+  if (static_cast<size_t>(s.st_size) < sizeof(SessionCacheHeader)) {
+    close(fd);
+    return UV_EINVAL;
+  }
+
+  const size_t size = s.st_size;
+  void* addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  err = errno;
+  close(fd);  // The mapping keeps the file alive.
+  if (addr == MAP_FAILED)
+    return -err;
+
+  SessionCacheHeader* h = static_cast<SessionCacheHeader*>(addr);
+  if (memcmp(h->magic, kMagic, sizeof(h->magic)) != 0 ||
+      h->version != kSessionCacheVersion ||
+      h->ways != kSessionCacheWays ||
+      h->slot_size != kSessionCacheSlotSize ||
+      h->set_count == 0 ||
+      MappingSize(h->set_count) != size) {
+    munmap(addr, size);
+    return UV_EINVAL;
+  }
+  std::atomic_thread_fence(std::memory_order_acquire);
+
+  header = h;
+  sets = reinterpret_cast<SessionCacheSet*>(h + 1);
+  return 0;
+}
+
+
+static void Lock(SessionCacheSet* set) {
+  const uint32_t self = getpid();
+  for (unsigned spins = 0;; spins++) {
+    uint32_t owner = 0;
+    if (set->lock.compare_exchange_weak(owner,
+                                        self,
+                                        std::memory_order_acquire,
+                                        std::memory_order_relaxed)) {
+      return;
+    }
+    // Critical sections are a memcpy long, spin a little before yielding.
+    if (spins < 100)
+      continue;
+    // A worker that dies with the lock held would otherwise wedge the set
+    // for everyone.  Its slots may be half written, so drop them.
+    if (owner != 0 && kill(owner, 0) == -1 && errno == ESRCH &&
+        set->lock.compare_exchange_strong(owner,
+                                          self,
+                                          std::memory_order_acquire,
+                                          std::memory_order_relaxed)) {
+      for (SessionCacheSlot& slot : set->slots)
+        slot.last_used = 0;
+      return;
+    }
+    sched_yield();
+  }
+}
+
+
+static void Unlock(SessionCacheSet* set) {
+  set->lock.store(0, std::memory_order_release);
+}
+
+
+// FNV-1a.  Session ids are random when we issue them but a client can send
+// whatever it likes, so don't just take the leading bytes.
+static SessionCacheSet* SetFor(const unsigned char* scope,
+                               const unsigned char* id,
+                               unsigned int length) {
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < kSessionCacheScopeLength; i++) {
+    hash ^= scope[i];
+    hash *= 16777619u;
+  }
+  for (unsigned int i = 0; i < length; i++) {
+    hash ^= id[i];
+    hash *= 16777619u;
+  }
+  return &sets[hash % header->set_count];
+}
+
+#endif  // _WIN32
+
+
+bool IsOpen() {
+  return header != nullptr;
+}
+
+
+static bool Matches(const SessionCacheSlot& slot,
+                    const unsigned char* scope,
+                    const unsigned char* id,
+                    unsigned int id_length) {
+  return slot.last_used != 0 &&
+         slot.id_length == id_length &&
+         memcmp(slot.id, id, id_length) == 0 &&
+         memcmp(slot.scope, scope, kSessionCacheScopeLength) == 0;
+}
+
+
+void Add(const unsigned char* scope, SSL_SESSION* sess) {
+#ifndef _WIN32
+  if (header == nullptr)
+    return;
+
+  unsigned int id_length;
+  const unsigned char* id = SSL_SESSION_get_id(sess, &id_length);
+  if (id_length == 0 || id_length > SSL_MAX_SSL_SESSION_ID_LENGTH)
+    return;
+
+  // Serialize outside of the lock.
+  unsigned char data[sizeof(SessionCacheSlot::data)];
+  const int size = i2d_SSL_SESSION(sess, nullptr);
+  if (size <= 0 || static_cast<size_t>(size) > sizeof(data))
+    return;
+  unsigned char* p = data;
+  i2d_SSL_SESSION(sess, &p);
+
+  const uint64_t now =
+      header->clock.fetch_add(1, std::memory_order_relaxed) + 1;
+  SessionCacheSet* set = SetFor(scope, id, id_length);
+  Lock(set);
+
+  // Replace the same session if it is already there, otherwise take an empty
+  // slot or evict the least recently used one.
+  SessionCacheSlot* victim = nullptr;
+  for (SessionCacheSlot& slot : set->slots) {
+    if (Matches(slot, scope, id, id_length)) {
+      victim = &slot;
+      break;
+    }
+    if (victim == nullptr || slot.last_used < victim->last_used)
+      victim = &slot;
+  }
+  const bool evicted = victim->last_used != 0 &&
+                       !Matches(*victim, scope, id, id_length);
+
+  victim->last_used = now;
+  victim->id_length = id_length;
+  victim->data_length = size;
+  memcpy(victim->scope, scope, kSessionCacheScopeLength);
+  memcpy(victim->id, id, id_length);
+  memcpy(victim->data, data, size);
+  Unlock(set);
+
+  header->stores.fetch_add(1, std::memory_order_relaxed);
+  if (evicted)
+    header->evictions.fetch_add(1, std::memory_order_relaxed);
+#endif  // _WIN32
+}
+
+
+SSL_SESSION* Get(const unsigned char* scope,
+                 const unsigned char* id,
+                 int id_length) {
+#ifdef _WIN32
+  return nullptr;
+#else
+  if (header == nullptr)
+    return nullptr;
+  if (id_length <= 0 || id_length > SSL_MAX_SSL_SESSION_ID_LENGTH)
+    return nullptr;
+
+  unsigned char data[sizeof(SessionCacheSlot::data)];
+  uint32_t size = 0;
+
+  const uint64_t now =
+      header->clock.fetch_add(1, std::memory_order_relaxed) + 1;
+  SessionCacheSet* set = SetFor(scope, id, id_length);
+  Lock(set);
+  for (SessionCacheSlot& slot : set->slots) {
+    if (Matches(slot, scope, id, id_length)) {
+      slot.last_used = now;
+      size = slot.data_length;
+      if (size > sizeof(data))  // Corrupt, don't trust it.
+        size = 0;
+      memcpy(data, slot.data, size);
+      break;
+    }
+  }
+  Unlock(set);
+
+  if (size == 0) {
+    header->misses.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+  }
+
+  // OpenSSL checks the expiry and the session id context of what we return.
+  const unsigned char* p = data;
+  SSL_SESSION* sess = d2i_SSL_SESSION(nullptr, &p, size);
+  if (sess == nullptr) {
+    ERR_clear_error();
+    header->misses.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+  }
+  header->hits.fetch_add(1, std::memory_order_relaxed);
+  return sess;
+#endif  // _WIN32
+}
+
+}  // namespace session_cache
+}  // namespace crypto
+}  // namespace node
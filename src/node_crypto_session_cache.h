@@ -0,0 +1,107 @@
+#ifndef SRC_NODE_CRYPTO_SESSION_CACHE_H_
+#define SRC_NODE_CRYPTO_SESSION_CACHE_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "node.h"
+
+#include <openssl/ssl.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+
+// TLS session cache that is shared between the processes of a cluster.
+//
+// The cluster master creates a file holding a fixed number of session slots,
+// unlinks it right away and hands the open descriptor to the workers, which
+// map it and consult it straight from OpenSSL's get/new session callbacks.
+// A client that resumes its session on a different worker than the one that
+// issued it therefore gets an abbreviated handshake without a round trip
+// through JavaScript or IPC.
+//
+// Entries are keyed by a scope and the session id.  The scope is a digest of
+// the server settings that decide whether a client is authenticated, so a
+// session that was established without a client certificate can't be resumed
+// on a server that asks for one.
+//
+// The slots are grouped into sets of kSessionCacheWays.  A key hashes
+// to exactly one set and a set is guarded by its own spinlock, so processes
+// only contend when they touch the same set.  Within a set the least
+// recently used slot is evicted.  The lock word holds the pid of the owner
+// which lets a waiter break the lock of a worker that died while holding it.
+//
+//   offset  size  field
+//        0    64  SessionCacheHeader
+//       64     *  set_count * SessionCacheSet
+//
+// Sessions are stored in their DER form; sessions that do not fit into a
+// slot, in practice only ones that carry a large client certificate, are
+// not shared.
+
+namespace node {
+namespace crypto {
+namespace session_cache {
+
+static const uint32_t kSessionCacheVersion = 2;
+static const uint32_t kSessionCacheWays = 8;
+static const size_t kSessionCacheSlotSize = 2048;
+static const size_t kSessionCacheScopeLength = 32;
+
+struct SessionCacheHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t set_count;
+  uint32_t ways;
+  uint32_t slot_size;
+  std::atomic<uint64_t> clock;
+  std::atomic<uint64_t> hits;
+  std::atomic<uint64_t> misses;
+  std::atomic<uint64_t> stores;
+  std::atomic<uint64_t> evictions;
+};
+
+struct SessionCacheSlot {
+  uint64_t last_used;  // Zero when the slot is empty.
+  uint32_t id_length;
+  uint32_t data_length;
+  unsigned char scope[kSessionCacheScopeLength];
+  unsigned char id[SSL_MAX_SSL_SESSION_ID_LENGTH];
+  unsigned char data[kSessionCacheSlotSize - 80];
+};
+
+struct SessionCacheSet {
+  std::atomic<uint32_t> lock;
+  uint32_t reserved[15];
+  SessionCacheSlot slots[kSessionCacheWays];
+};
+
+// Creates a new file at |path| with room for at least |entries| sessions
+// and unlinks it again.  |path| must not exist.  Returns the open descriptor
+// of the file, or a negative errno value.  The mapping is not kept, the
+// creator only needs to pass the descriptor on.
+int Create(const char* path, uint32_t entries);
+
+// Maps the cache file created by Create() for the lifetime of the process and
+// closes |fd|.  Returns 0 on success or a negative errno value.
+int Open(int fd);
+
+bool IsOpen();
+
+// Copies |sess| into the cache under |scope|, replacing an entry with the same
+// scope and id.
+void Add(const unsigned char* scope, SSL_SESSION* sess);
+
+// Returns a new session object for |scope| and |id| or nullptr.  The caller
+// owns the reference.
+SSL_SESSION* Get(const unsigned char* scope,
+                 const unsigned char* id,
+                 int id_length);
+
+}  // namespace session_cache
+}  // namespace crypto
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_CRYPTO_SESSION_CACHE_H_
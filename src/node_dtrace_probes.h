@@ -0,0 +1,40 @@
+#ifndef SRC_NODE_DTRACE_PROBES_H_
+#define SRC_NODE_DTRACE_PROBES_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+// Low-level probes that fire from the C++ layer rather than through the
+// DTRACE_* functions that lib/ calls.  With --with-dtrace they are the
+// USDT probes generated from node_provider.d; on Linux that is SystemTap's
+// dtrace(1), which emits <sys/sdt.h> markers usable from perf, bpftrace and
+// stap.  Every NODE_*_ENABLED() check reads the probe's is-enabled semaphore,
+// so a probe that no tracer is attached to costs one load and a branch.
+// In all other builds they compile to nothing.
+
+#ifdef HAVE_DTRACE
+#include "node_dtrace.h"  // Types referenced by node_provider.h.
+#include "node_provider.h"
+#else
+#define NODE_FS_START(arg0, arg1, arg2) do { } while (false)
+#define NODE_FS_START_ENABLED() (0)
+#define NODE_FS_DONE(arg0, arg1, arg2) do { } while (false)
+#define NODE_FS_DONE_ENABLED() (0)
+#define NODE_STREAM_READ(arg0, arg1, arg2) do { } while (false)
+#define NODE_STREAM_READ_ENABLED() (0)
+#define NODE_STREAM_WRITE(arg0, arg1, arg2) do { } while (false)
+#define NODE_STREAM_WRITE_ENABLED() (0)
+#define NODE_DNS_QUERY(arg0, arg1) do { } while (false)
+#define NODE_DNS_QUERY_ENABLED() (0)
+#define NODE_DNS_DONE(arg0, arg1) do { } while (false)
+#define NODE_DNS_DONE_ENABLED() (0)
+#define NODE_TIMER_FIRE(arg0) do { } while (false)
+#define NODE_TIMER_FIRE_ENABLED() (0)
+#define NODE_CALLBACK_START(arg0, arg1) do { } while (false)
+#define NODE_CALLBACK_START_ENABLED() (0)
+#define NODE_CALLBACK_DONE(arg0, arg1) do { } while (false)
+#define NODE_CALLBACK_DONE_ENABLED() (0)
+#endif
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_DTRACE_PROBES_H_
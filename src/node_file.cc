@@ -1,6 +1,7 @@
 #include "node.h"
 #include "node_file.h"
 #include "node_buffer.h"
+#include "node_dtrace_probes.h"
 #include "node_internals.h"
 #include "node_stat_watcher.h"
 
@@ -22,6 +23,7 @@
 # include <io.h>
 #endif
 
+#include <string>
 #include <vector>
 
 namespace node {
@@ -34,6 +36,7 @@ using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::HandleScope;
 using v8::Integer;
+using v8::Isolate;
 using v8::Local;
 using v8::Number;
 using v8::Object;
@@ -72,6 +75,10 @@ class FSReqWrap: public ReqWrap<uv_fs_t> {
   const char* data() const { return data_; }
   const enum encoding encoding_;
 
+  // Set by readdir() to report the type of each entry as well.
+  bool with_file_types() const { return with_file_types_; }
+  void set_with_file_types(bool value) { with_file_types_ = value; }
+
   size_t self_size() const override { return sizeof(*this); }
 
  private:
@@ -83,7 +90,8 @@ class FSReqWrap: public ReqWrap<uv_fs_t> {
       : ReqWrap(env, req, AsyncWrap::PROVIDER_FSREQWRAP),
         encoding_(encoding),
         syscall_(syscall),
-        data_(data) {
+        data_(data),
+        with_file_types_(false) {
     Wrap(object(), this);
   }
 
@@ -95,6 +103,7 @@ class FSReqWrap: public ReqWrap<uv_fs_t> {
 
   const char* syscall_;
   const char* data_;
+  bool with_file_types_;
 
   DISALLOW_COPY_AND_ASSIGN(FSReqWrap);
 };
@@ -135,11 +144,74 @@ static inline bool IsInt64(double x) {
   return x == static_cast<double>(static_cast<int64_t>(x));
 }
 
+// Collects the entries of a completed scandir request.  `result` is the
+// array of names, or [names, types] with `with_types`, where types are the
+// UV_DIRENT_* values libuv got from the directory listing for free.
+// Returns 0, the error from uv_fs_scandir_next() or UV_EINVAL when a name
+// can't be encoded.
+static int ScandirResult(Environment* env,
+                         uv_fs_t* req,
+                         enum encoding encoding,
+                         bool with_types,
+                         Local<Value>* result) {
+  Isolate* isolate = env->isolate();
+  Local<Array> names = Array::New(isolate, 0);
+  Local<Array> types = Array::New(isolate, 0);
+  Local<Function> fn = env->push_values_to_array_function();
+  Local<Value> name_v[NODE_PUSH_VAL_TO_ARRAY_MAX];
+  Local<Value> type_v[NODE_PUSH_VAL_TO_ARRAY_MAX];
+  size_t idx = 0;
+
+  for (;;) {
+    uv_dirent_t ent;
+
+    int r = uv_fs_scandir_next(req, &ent);
+    if (r == UV_EOF)
+      break;
+    if (r != 0)
+      return r;
+
+    Local<Value> filename = StringBytes::Encode(isolate, ent.name, encoding);
+    if (filename.IsEmpty())
+      return UV_EINVAL;
+
+    name_v[idx] = filename;
+    type_v[idx] = Integer::New(isolate, ent.type);
+    idx++;
+
+    if (idx >= arraysize(name_v)) {
+      fn->Call(env->context(), names, idx, name_v).ToLocalChecked();
+      if (with_types)
+        fn->Call(env->context(), types, idx, type_v).ToLocalChecked();
+      idx = 0;
+    }
+  }
+
+  if (idx > 0) {
+    fn->Call(env->context(), names, idx, name_v).ToLocalChecked();
+    if (with_types)
+      fn->Call(env->context(), types, idx, type_v).ToLocalChecked();
+  }
+
+  if (with_types) {
+    Local<Array> pair = Array::New(isolate, 2);
+    pair->Set(0, names);
+    pair->Set(1, types);
+    *result = pair;
+  } else {
+    *result = names;
+  }
+  return 0;
+}
+
 static void After(uv_fs_t *req) {
   FSReqWrap* req_wrap = static_cast<FSReqWrap*>(req->data);
   CHECK_EQ(req_wrap->req(), req);
   req_wrap->ReleaseEarly();  // Free memory that's no longer used now.
 
+  if (NODE_FS_DONE_ENABLED())
+    NODE_FS_DONE(req, req_wrap->syscall(), static_cast<int64_t>(req->result));
+
   Environment* env = req_wrap->env();
   HandleScope handle_scope(env->isolate());
   Context::Scope context_scope(env->context());
@@ -263,53 +335,26 @@ static void After(uv_fs_t *req) {
 
       case UV_FS_SCANDIR:
         {
-          int r;
-          Local<Array> names = Array::New(env->isolate(), 0);
-          Local<Function> fn = env->push_values_to_array_function();
-          Local<Value> name_argv[NODE_PUSH_VAL_TO_ARRAY_MAX];
-          size_t name_idx = 0;
-
-          for (int i = 0; ; i++) {
-            uv_dirent_t ent;
-
-            r = uv_fs_scandir_next(req, &ent);
-            if (r == UV_EOF)
-              break;
-            if (r != 0) {
-              argv[0] = UVException(r,
-                                    nullptr,
-                                    req_wrap->syscall(),
-                                    static_cast<const char*>(req->path));
-              break;
-            }
-
-            Local<Value> filename = StringBytes::Encode(env->isolate(),
-                                                        ent.name,
-                                                        req_wrap->encoding_);
-            if (filename.IsEmpty()) {
-              argv[0] = UVException(env->isolate(),
-                                    UV_EINVAL,
-                                    req_wrap->syscall(),
-                                    "Invalid character encoding for filename",
-                                    req->path,
-                                    req_wrap->data());
-              break;
-            }
-            name_argv[name_idx++] = filename;
-
-            if (name_idx >= arraysize(name_argv)) {
-              fn->Call(env->context(), names, name_idx, name_argv)
-                  .ToLocalChecked();
-              name_idx = 0;
-            }
+          int r = ScandirResult(env,
+                                req,
+                                req_wrap->encoding_,
+                                req_wrap->with_file_types(),
+                                &argv[1]);
+          if (r == UV_EINVAL) {
+            argv[0] = UVException(env->isolate(),
+                                  UV_EINVAL,
+                                  req_wrap->syscall(),
+                                  "Invalid character encoding for filename",
+                                  req->path,
+                                  req_wrap->data());
+            argc = 1;
+          } else if (r != 0) {
+            argv[0] = UVException(r,
+                                  nullptr,
+                                  req_wrap->syscall(),
+                                  static_cast<const char*>(req->path));
+            argc = 1;
           }
-
-          if (name_idx > 0) {
-            fn->Call(env->context(), names, name_idx, name_argv)
-                .ToLocalChecked();
-          }
-
-          argv[1] = names;
         }
         break;
 
@@ -354,6 +399,8 @@ class fs_req_wrap {
     After(uv_req);                                                            \
     req_wrap = nullptr;                                                       \
   } else {                                                                    \
+    if (NODE_FS_START_ENABLED())                                              \
+      NODE_FS_START(req_wrap->req(), #func, req_wrap->req()->path);           \
     args.GetReturnValue().Set(req_wrap->persistent());                        \
   }
 
@@ -932,56 +979,32 @@ static void ReadDir(const FunctionCallbackInfo<Value>& args) {
   ASSERT_PATH(path)
 
   const enum encoding encoding = ParseEncoding(env->isolate(), args[1], UTF8);
+  const bool with_types = args[2]->IsTrue();
 
   Local<Value> callback = Null(env->isolate());
-  if (argc == 3)
-    callback = args[2];
+  if (argc == 4)
+    callback = args[3];
 
   if (callback->IsObject()) {
     ASYNC_CALL(scandir, callback, encoding, *path, 0 /*flags*/)
+    if (req_wrap != nullptr)
+      req_wrap->set_with_file_types(with_types);
   } else {
     SYNC_CALL(scandir, *path, *path, 0 /*flags*/)
 
     CHECK_GE(SYNC_REQ.result, 0);
-    int r;
-    Local<Array> names = Array::New(env->isolate(), 0);
-    Local<Function> fn = env->push_values_to_array_function();
-    Local<Value> name_v[NODE_PUSH_VAL_TO_ARRAY_MAX];
-    size_t name_idx = 0;
-
-    for (int i = 0; ; i++) {
-      uv_dirent_t ent;
-
-      r = uv_fs_scandir_next(&SYNC_REQ, &ent);
-      if (r == UV_EOF)
-        break;
-      if (r != 0)
-        return env->ThrowUVException(r, "readdir", "", *path);
-
-      Local<Value> filename = StringBytes::Encode(env->isolate(),
-                                                  ent.name,
-                                                  encoding);
-      if (filename.IsEmpty()) {
-        return env->ThrowUVException(UV_EINVAL,
-                                     "readdir",
-                                     "Invalid character encoding for filename",
-                                     *path);
-      }
-
-      name_v[name_idx++] = filename;
-
-      if (name_idx >= arraysize(name_v)) {
-        fn->Call(env->context(), names, name_idx, name_v)
-            .ToLocalChecked();
-        name_idx = 0;
-      }
-    }
-
-    if (name_idx > 0) {
-      fn->Call(env->context(), names, name_idx, name_v).ToLocalChecked();
+    Local<Value> result;
+    int r = ScandirResult(env, &SYNC_REQ, encoding, with_types, &result);
+    if (r == UV_EINVAL) {
+      return env->ThrowUVException(UV_EINVAL,
+                                   "readdir",
+                                   "Invalid character encoding for filename",
+                                   *path);
     }
+    if (r != 0)
+      return env->ThrowUVException(r, "readdir", "", *path);
 
-    args.GetReturnValue().Set(names);
+    args.GetReturnValue().Set(result);
   }
 }
 
@@ -1173,6 +1196,8 @@ static void WriteString(const FunctionCallbackInfo<Value>& args) {
     return;
   }
 
+  if (NODE_FS_START_ENABLED())
+    NODE_FS_START(req_wrap->req(), "write", nullptr);
   return args.GetReturnValue().Set(req_wrap->persistent());
 }
 
@@ -1238,6 +1263,376 @@ static void Read(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+// fs.readFile() and fs.writeFile() as a single threadpool request.  Opening,
+// fstat, reading or writing until done and closing all happen in Work(),
+// rather than as separate FSReqWrap requests with a trip back to JS after
+// each step.  Transfers larger than kMaxWorkSize are split over several
+// threadpool jobs, still without going back to JS in between, so that a big
+// file doesn't hold on to a threadpool thread for the whole transfer.  `req`
+// is the FSReqWrap object from JS, its oncomplete is called with (err, data)
+// for reads and (err) for writes.
+class FileWorkReqWrap : public ReqWrap<uv_work_t> {
+ public:
+  enum Op { READ, READ_UTF8, WRITE };
+
+  FileWorkReqWrap(Environment* env, Local<Object> req, Op op)
+      : ReqWrap(env, req, AsyncWrap::PROVIDER_FSREQWRAP),
+        op_(op),
+        is_fd_(false),
+        fd_(-1),
+        flags_(0),
+        mode_(0),
+        position_(-1),
+        data_(nullptr),
+        length_(0),
+        capacity_(0),
+        offset_(0),
+        size_(0),
+        err_(0),
+        syscall_(nullptr),
+        too_large_(false),
+        started_(false),
+        done_(false) {
+    Wrap(object(), this);
+  }
+
+  ~FileWorkReqWrap() {
+    if (op_ != WRITE)
+      free(data_);
+  }
+
+  void SetPath(const char* path) { path_ = path; }
+  void SetFd(int fd) {
+    is_fd_ = true;
+    fd_ = fd;
+  }
+  void SetFlags(int flags, int mode) {
+    flags_ = flags;
+    mode_ = mode;
+  }
+  // The caller keeps `data` alive until the request completes.
+  void SetWriteData(char* data, size_t length, int64_t position) {
+    data_ = data;
+    length_ = length;
+    position_ = position;
+  }
+
+  void Dispatch() {
+    if (NODE_FS_START_ENABLED()) {
+      NODE_FS_START(&req_,
+                    op_ == WRITE ? "writeFile" : "readFile",
+                    is_fd_ ? nullptr : path_.c_str());
+    }
+    CHECK_EQ(0, uv_queue_work(env()->event_loop(), &req_, Work, AfterWork));
+    Dispatched();
+  }
+
+  size_t self_size() const override { return sizeof(*this); }
+
+ private:
+  // Initial buffer size for files that don't report their size, like pipes
+  // and most files in /proc.
+  static const size_t kReadChunkSize = 64 * 1024;
+  // Most bytes that a single threadpool job reads or writes.  Smaller files
+  // take one job; with several big files in flight, the other fs, dns and
+  // crypto requests still get their turn on the threadpool in between.
+  static const size_t kMaxWorkSize = 4 * 1024 * 1024;
+
+  bool finished() const { return err_ != 0 || too_large_ || done_; }
+
+  static void Work(uv_work_t* req) {
+    FileWorkReqWrap* req_wrap = ContainerOf(&FileWorkReqWrap::req_, req);
+    uv_loop_t* loop = req->loop;
+
+    if (!req_wrap->started_) {
+      req_wrap->started_ = true;
+      req_wrap->Start(loop);
+    }
+
+    if (!req_wrap->finished()) {
+      if (req_wrap->op_ == WRITE)
+        req_wrap->WriteSome(loop);
+      else
+        req_wrap->ReadSome(loop);
+    }
+
+    if (req_wrap->finished() && !req_wrap->is_fd_ && req_wrap->fd_ >= 0) {
+      uv_fs_t fs_req;
+      int err = uv_fs_close(loop, &fs_req, req_wrap->fd_, nullptr);
+      uv_fs_req_cleanup(&fs_req);
+      if (err < 0)
+        req_wrap->SetError(err, "close");
+      req_wrap->fd_ = -1;
+    }
+  }
+
+  // Opens the file and, for reads, sizes the buffer.
+  void Start(uv_loop_t* loop) {
+    uv_fs_t fs_req;
+
+    if (!is_fd_) {
+      int fd = uv_fs_open(loop, &fs_req, path_.c_str(), flags_, mode_,
+                          nullptr);
+      uv_fs_req_cleanup(&fs_req);
+      if (fd < 0)
+        return SetError(fd, "open");
+      fd_ = fd;
+    }
+
+    if (op_ == WRITE)
+      return;
+
+    int err = uv_fs_fstat(loop, &fs_req, fd_, nullptr);
+    if (err < 0) {
+      uv_fs_req_cleanup(&fs_req);
+      return SetError(err, "fstat");
+    }
+    const uv_stat_t* s = static_cast<const uv_stat_t*>(fs_req.ptr);
+    // Only trust the size of regular files, read everything else until EOF.
+    size_ = (s->st_mode & S_IFMT) == S_IFREG ? s->st_size : 0;
+    uv_fs_req_cleanup(&fs_req);
+
+    if (size_ > Buffer::kMaxLength) {
+      too_large_ = true;
+      return;
+    }
+
+    capacity_ = size_ != 0 ? size_ : kReadChunkSize;
+    data_ = UncheckedMalloc(capacity_);
+    if (data_ == nullptr)
+      return SetError(UV_ENOMEM, "read");
+  }
+
+  // Reads up to kMaxWorkSize bytes, sets done_ at the end of the file.
+  void ReadSome(uv_loop_t* loop) {
+    size_t budget = kMaxWorkSize;
+    while (budget > 0) {
+      if (length_ == capacity_) {
+        if (size_ != 0) {
+          done_ = true;
+          return;
+        }
+        if (capacity_ >= Buffer::kMaxLength) {
+          too_large_ = true;
+          return;
+        }
+        size_t capacity = MIN(capacity_ * 2, Buffer::kMaxLength);
+        char* data = UncheckedRealloc(data_, capacity);
+        if (data == nullptr)
+          return SetError(UV_ENOMEM, "read");
+        data_ = data;
+        capacity_ = capacity;
+      }
+
+      uv_fs_t fs_req;
+      uv_buf_t buf = uv_buf_init(data_ + length_,
+                                 MIN(capacity_ - length_, budget));
+      int nread = uv_fs_read(loop, &fs_req, fd_, &buf, 1, -1, nullptr);
+      uv_fs_req_cleanup(&fs_req);
+      if (nread < 0)
+        return SetError(nread, "read");
+      if (nread == 0) {
+        done_ = true;
+        return;
+      }
+      length_ += nread;
+      budget -= nread;
+    }
+  }
+
+  // Writes up to kMaxWorkSize bytes, sets done_ once everything is written.
+  void WriteSome(uv_loop_t* loop) {
+    size_t budget = kMaxWorkSize;
+    while (offset_ < length_ && budget > 0) {
+      uv_fs_t fs_req;
+      uv_buf_t buf = uv_buf_init(data_ + offset_,
+                                 MIN(length_ - offset_, budget));
+      int written = uv_fs_write(loop, &fs_req, fd_, &buf, 1, position_,
+                                nullptr);
+      uv_fs_req_cleanup(&fs_req);
+      if (written < 0)
+        return SetError(written, "write");
+      offset_ += written;
+      budget -= written;
+      if (position_ >= 0)
+        position_ += written;
+    }
+    done_ = offset_ == length_;
+  }
+
+  // Keeps the first error, a failed close() doesn't hide why we gave up.
+  void SetError(int err, const char* syscall) {
+    if (err_ != 0)
+      return;
+    err_ = err;
+    syscall_ = syscall;
+  }
+
+  static void AfterWork(uv_work_t* req, int status) {
+    CHECK_EQ(status, 0);
+
+    FileWorkReqWrap* req_wrap = ContainerOf(&FileWorkReqWrap::req_, req);
+    Environment* env = req_wrap->env();
+    Isolate* isolate = env->isolate();
+
+    // Queue the next part of a big file right away, without calling into JS.
+    if (!req_wrap->finished()) {
+      CHECK_EQ(0, uv_queue_work(env->event_loop(), req, Work, AfterWork));
+      return;
+    }
+
+    if (NODE_FS_DONE_ENABLED()) {
+      NODE_FS_DONE(&req_wrap->req_,
+                   req_wrap->op_ == WRITE ? "writeFile" : "readFile",
+                   static_cast<int64_t>(req_wrap->err_));
+    }
+
+    HandleScope handle_scope(isolate);
+    Context::Scope context_scope(env->context());
+
+    Local<Value> argv[2] = { Null(isolate), Undefined(isolate) };
+    int argc = req_wrap->op_ == WRITE ? 1 : 2;
+
+    if (req_wrap->err_ < 0) {
+      // Only open() errors mention the path, like the separate fs calls.
+      const char* path = nullptr;
+      if (strcmp(req_wrap->syscall_, "open") == 0)
+        path = req_wrap->path_.c_str();
+      argv[0] = UVException(isolate,
+                            req_wrap->err_,
+                            req_wrap->syscall_,
+                            nullptr,
+                            path,
+                            nullptr);
+      argc = 1;
+    } else if (req_wrap->too_large_) {
+      char message[96];
+      snprintf(message, sizeof(message),
+               "File size is greater than possible Buffer: 0x%x bytes",
+               Buffer::kMaxLength);
+      argv[0] = v8::Exception::RangeError(OneByteString(isolate, message));
+      argc = 1;
+    } else if (req_wrap->op_ != WRITE) {
+      argv[1] = req_wrap->TakeResult();
+    }
+
+    req_wrap->MakeCallback(env->oncomplete_string(), argc, argv);
+
+    delete req_wrap;
+  }
+
+  // Returns a string for READ_UTF8 unless it would be too long, the JS side
+  // then falls back to buffer.toString() for the error it throws.
+  Local<Value> TakeResult() {
+    Isolate* isolate = env()->isolate();
+
+    if (op_ == READ_UTF8) {
+      Local<String> string;
+      if (String::NewFromUtf8(isolate,
+                              data_,
+                              v8::NewStringType::kNormal,
+                              length_).ToLocal(&string)) {
+        return string;
+      }
+    }
+
+    char* data = data_;
+    data_ = nullptr;
+    if (length_ == 0) {
+      free(data);
+      data = nullptr;
+    } else if (length_ < capacity_) {
+      data = Realloc(data, length_);
+    }
+    return Buffer::New(env(), data, length_).ToLocalChecked();
+  }
+
+  const Op op_;
+  bool is_fd_;  // Use fd_ as is instead of opening path_.
+  std::string path_;
+  int fd_;
+  int flags_;
+  int mode_;
+  int64_t position_;
+  char* data_;
+  size_t length_;
+  size_t capacity_;
+  size_t offset_;  // Bytes written so far.
+  uint64_t size_;  // Size of the file that is read, 0 if unknown.
+  int err_;
+  const char* syscall_;
+  bool too_large_;
+  bool started_;
+  bool done_;
+};
+
+
+/* fs.readFile(path | fd, flags, req) and fs.readFileUtf8(path | fd, flags, req)
+ * Read the whole file in one threadpool request.  The callback gets a Buffer,
+ * or a string for readFileUtf8().
+ */
+template <FileWorkReqWrap::Op op>
+static void ReadFile(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  if (args.Length() < 3)
+    return TYPE_ERROR("path, flags and req are required");
+  if (!args[1]->IsInt32())
+    return TYPE_ERROR("flags must be an int");
+  CHECK(args[2]->IsObject());
+
+  const bool is_fd = args[0]->IsInt32();
+  BufferValue path(env->isolate(), args[0]);
+  if (!is_fd)
+    ASSERT_PATH(path)
+
+  FileWorkReqWrap* req_wrap =
+      new FileWorkReqWrap(env, args[2].As<Object>(), op);
+  if (is_fd)
+    req_wrap->SetFd(args[0]->Int32Value());
+  else
+    req_wrap->SetPath(*path);
+  req_wrap->SetFlags(args[1]->Int32Value(), 0666);
+  req_wrap->Dispatch();
+}
+
+
+/* fs.writeFile(path | fd, buffer, flags, mode, position, req)
+ * Write all of `buffer` in one threadpool request.  `position` is null to
+ * write at the current position, `req.buffer` must keep `buffer` alive.
+ */
+static void WriteFile(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  if (args.Length() < 6)
+    return TYPE_ERROR("path, buffer, flags, mode, position and req required");
+  if (!Buffer::HasInstance(args[1]))
+    return TYPE_ERROR("Second argument needs to be a buffer");
+  if (!args[2]->IsInt32())
+    return TYPE_ERROR("flags must be an int");
+  if (!args[3]->IsInt32())
+    return TYPE_ERROR("mode must be an int");
+  CHECK(args[5]->IsObject());
+
+  const bool is_fd = args[0]->IsInt32();
+  BufferValue path(env->isolate(), args[0]);
+  if (!is_fd)
+    ASSERT_PATH(path)
+
+  FileWorkReqWrap* req_wrap =
+      new FileWorkReqWrap(env, args[5].As<Object>(), FileWorkReqWrap::WRITE);
+  if (is_fd)
+    req_wrap->SetFd(args[0]->Int32Value());
+  else
+    req_wrap->SetPath(*path);
+  req_wrap->SetFlags(args[2]->Int32Value(), args[3]->Int32Value());
+  req_wrap->SetWriteData(Buffer::Data(args[1]),
+                         Buffer::Length(args[1]),
+                         GET_OFFSET(args[4]));
+  req_wrap->Dispatch();
+}
+
+
 /* fs.chmod(path, mode);
  * Wrapper for chmod(1) / EIO_CHMOD
  */
@@ -1455,6 +1850,11 @@ void InitFs(Local<Object> target,
   env->SetMethod(target, "close", Close);
   env->SetMethod(target, "open", Open);
   env->SetMethod(target, "read", Read);
+  env->SetMethod(target, "readFile", ReadFile<FileWorkReqWrap::READ>);
+  env->SetMethod(target,
+                 "readFileUtf8",
+                 ReadFile<FileWorkReqWrap::READ_UTF8>);
+  env->SetMethod(target, "writeFile", WriteFile);
   env->SetMethod(target, "fdatasync", Fdatasync);
   env->SetMethod(target, "fsync", Fsync);
   env->SetMethod(target, "rename", Rename);
@@ -0,0 +1,212 @@
+#include "node_metrics_shm.h"
+#include "env.h"
+#include "env-inl.h"
+#include "uv.h"
+#include "v8.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <string>
+
+namespace node {
+namespace metrics {
+
+using v8::GCCallbackFlags;
+using v8::GCType;
+using v8::HeapStatistics;
+using v8::Isolate;
+
+static_assert(sizeof(MetricsHeader) == kMetricsHeaderSize,
+              "MetricsHeader layout changed");
+static_assert(sizeof(std::atomic<uint64_t>) == sizeof(uint64_t),
+              "Counters must be plain 64 bits words in the mapping");
+
+MetricsRegion* region = nullptr;
+
+static char* region_path;
+static dev_t region_dev;
+static ino_t region_ino;
+static uint64_t gc_start_time;
+static uint64_t loop_poll_start_time;
+static uv_prepare_t loop_prepare_handle;
+static uv_check_t loop_check_handle;
+
+
+int Open(const char* path) {
+  CHECK_EQ(region, nullptr);
+
+  std::string filename(path);
+  const std::string::size_type pos = filename.find("%p");
+  if (pos != std::string::npos)
+    filename.replace(pos, 2, std::to_string(getpid()));
+
+  // The path is easy to guess, so never follow a symlink or reuse a file
+  // that someone else planted there.  A regular file of our own is left over
+  // from an earlier process with the same pid that died from a signal.
+  const int flags = O_RDWR | O_CREAT | O_EXCL | O_NOFOLLOW | O_CLOEXEC;
+  int fd = open(filename.c_str(), flags, 0644);
+  if (fd == -1 && errno == EEXIST) {
+    struct stat st;
+    if (lstat(filename.c_str(), &st) == 0 &&
+        S_ISREG(st.st_mode) &&
+        st.st_uid == geteuid() &&
+        unlink(filename.c_str()) == 0) {
+      fd = open(filename.c_str(), flags, 0644);
+    } else {
+      errno = EEXIST;
+    }
+  }
+  if (fd == -1)
+    return -errno;
+
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    const int err = errno;
+    close(fd);
+    unlink(filename.c_str());
+    return -err;
+  }
+  region_dev = st.st_dev;
+  region_ino = st.st_ino;
+
+  const size_t size = sizeof(MetricsRegion);
+  if (ftruncate(fd, size) != 0) {
+    const int err = errno;
+    close(fd);
+    unlink(filename.c_str());
+    return -err;
+  }
+
+  void* addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  const int err = errno;
+  close(fd);  // The mapping keeps the file alive.
+  if (addr == MAP_FAILED) {
+    unlink(filename.c_str());
+    return -err;
+  }
+
+  // The file was created empty and extended, so everything, including the
+  // counters and reserved fields, starts out zeroed.
+  MetricsRegion* r = static_cast<MetricsRegion*>(addr);
+  r->header.version = kMetricsVersion;
+  r->header.header_size = kMetricsHeaderSize;
+  r->header.counter_count = kCounterCount;
+  r->header.pid = getpid();
+  struct timeval tv;
+  gettimeofday(&tv, nullptr);
+  r->header.start_time = static_cast<uint64_t>(tv.tv_sec) * 1000 +
+                         tv.tv_usec / 1000;
+  // Write the magic last so a reader that polls for the file never sees a
+  // valid magic in front of a half-initialized header.
+  std::atomic_thread_fence(std::memory_order_release);
+  memcpy(r->header.magic, "NODEMTRC", sizeof(r->header.magic));
+
+  region_path = strdup(filename.c_str());
+  region = r;
+  return 0;
+}
+
+
+void Close() {
+  if (region == nullptr)
+    return;
+  MetricsRegion* r = region;
+  region = nullptr;
+  munmap(r, sizeof(*r));
+  // Only remove the file if it is still the one that Open() created.
+  struct stat st;
+  if (lstat(region_path, &st) == 0 &&
+      st.st_dev == region_dev &&
+      st.st_ino == region_ino) {
+    unlink(region_path);
+  }
+  free(region_path);
+  region_path = nullptr;
+}
+
+
+static void OnGCPrologue(Isolate* isolate,
+                         GCType type,
+                         GCCallbackFlags flags) {
+  gc_start_time = uv_hrtime();
+}
+
+
+static void OnGCEpilogue(Isolate* isolate,
+                         GCType type,
+                         GCCallbackFlags flags) {
+  Add(kGcCount, 1);
+  if (type == v8::kGCTypeScavenge)
+    Add(kGcScavengeCount, 1);
+  else if (type == v8::kGCTypeMarkSweepCompact)
+    Add(kGcMarkSweepCount, 1);
+  Add(kGcPauseTime, uv_hrtime() - gc_start_time);
+
+  HeapStatistics stats;
+  isolate->GetHeapStatistics(&stats);
+  Set(kHeapUsed, stats.used_heap_size());
+  Set(kHeapTotal, stats.total_heap_size());
+}
+
+
+// The prepare and check watchers bracket the poll phase, so the time between
+// them is the time the loop spent waiting for I/O.  Everything else counts as
+// busy time and readers derive utilization from two samples of
+// (loop.idle_ns, loop.last_update_ns).
+static void OnLoopPrepare(uv_prepare_t* handle) {
+  loop_poll_start_time = uv_hrtime();
+}
+
+
+static void OnLoopCheck(uv_check_t* handle) {
+  const uint64_t now = uv_hrtime();
+  const uv_loop_t* loop = handle->loop;
+  Add(kLoopIterations, 1);
+  Add(kLoopIdleTime, now - loop_poll_start_time);
+  Set(kLoopUpdateTime, now);
+  Set(kActiveHandles, loop->active_handles);
+}
+
+
+void Attach(Environment* env) {
+  if (region == nullptr)
+    return;
+
+  env->isolate()->AddGCPrologueCallback(OnGCPrologue);
+  env->isolate()->AddGCEpilogueCallback(OnGCEpilogue);
+
+  uv_prepare_init(env->event_loop(), &loop_prepare_handle);
+  uv_check_init(env->event_loop(), &loop_check_handle);
+  uv_unref(reinterpret_cast<uv_handle_t*>(&loop_prepare_handle));
+  uv_unref(reinterpret_cast<uv_handle_t*>(&loop_check_handle));
+  uv_prepare_start(&loop_prepare_handle, OnLoopPrepare);
+  uv_check_start(&loop_check_handle, OnLoopCheck);
+
+  auto close_and_finish = [](Environment* env, uv_handle_t* handle, void* arg) {
+    handle->data = env;
+    uv_close(handle, [](uv_handle_t* handle) {
+      static_cast<Environment*>(handle->data)->FinishHandleCleanup(handle);
+    });
+  };
+  env->RegisterHandleCleanup(
+      reinterpret_cast<uv_handle_t*>(&loop_prepare_handle),
+      close_and_finish,
+      nullptr);
+  env->RegisterHandleCleanup(
+      reinterpret_cast<uv_handle_t*>(&loop_check_handle),
+      close_and_finish,
+      nullptr);
+
+  loop_poll_start_time = uv_hrtime();
+  Set(kLoopUpdateTime, loop_poll_start_time);
+}
+
+}  // namespace metrics
+}  // namespace node
@@ -0,0 +1,115 @@
+#ifndef SRC_NODE_METRICS_SHM_H_
+#define SRC_NODE_METRICS_SHM_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "node.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+
+// Shared-memory metrics exporter, enabled with --metrics-shm=<path>.
+//
+// The file is a fixed-layout, versioned region that external monitoring
+// agents can mmap() or simply read() without interacting with the process.
+// All fields are little-endian on the platforms we support and naturally
+// aligned.  Counters are 64 bits wide and updated with relaxed atomics, so
+// a reader may observe a counter mid-way through a batch of updates but it
+// never observes a torn value.
+//
+//   offset  size  field
+//        0     8  magic, "NODEMTRC"
+//        8     4  layout version (kMetricsVersion)
+//       12     4  header size in bytes, counters start at this offset
+//       16     4  number of counters
+//       20     4  reserved, zero
+//       24     8  pid
+//       32     8  process start time, milliseconds since the epoch
+//       40    24  reserved, zero
+//       64   8*n  counters, in NODE_METRICS_COUNTERS order
+//
+// New counters are only ever appended; readers must use the counter count
+// from the header rather than assume a size.  The version is bumped when
+// the meaning of an existing field changes.
+#define NODE_METRICS_COUNTERS(V)                                              \
+  V(kNetBytesSent)                                                            \
+  V(kNetBytesRecv)                                                            \
+  V(kPipeBytesSent)                                                           \
+  V(kPipeBytesRecv)                                                           \
+  V(kActiveHandles)                                                           \
+  V(kLoopIterations)                                                          \
+  V(kLoopIdleTime)                                                            \
+  V(kLoopUpdateTime)                                                          \
+  V(kGcCount)                                                                 \
+  V(kGcScavengeCount)                                                         \
+  V(kGcMarkSweepCount)                                                        \
+  V(kGcPauseTime)                                                             \
+  V(kHeapUsed)                                                                \
+  V(kHeapTotal)                                                               \
+
+namespace node {
+
+class Environment;
+
+namespace metrics {
+
+enum Counter {
+#define V(id) id,
+  NODE_METRICS_COUNTERS(V)
+#undef V
+  kCounterCount
+};
+
+static const uint32_t kMetricsVersion = 1;
+static const size_t kMetricsHeaderSize = 64;
+
+struct MetricsHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t header_size;
+  uint32_t counter_count;
+  uint32_t reserved0;
+  uint64_t pid;
+  uint64_t start_time;
+  uint64_t reserved1[3];
+};
+
+struct MetricsRegion {
+  MetricsHeader header;
+  std::atomic<uint64_t> counters[kCounterCount];
+};
+
+// Points into the mapping when --metrics-shm is active, nullptr otherwise.
+// Keeps the disabled case down to a single load and branch.
+extern MetricsRegion* region;
+
+inline void Add(Counter counter, uint64_t value) {
+  if (region != nullptr)
+    region->counters[counter].fetch_add(value, std::memory_order_relaxed);
+}
+
+inline void Set(Counter counter, uint64_t value) {
+  if (region != nullptr)
+    region->counters[counter].store(value, std::memory_order_relaxed);
+}
+
+// Creates and maps the file.  A "%p" in |path| is replaced with the pid so
+// that cluster workers which inherit execArgv get a file each.  Returns 0
+// on success or a negative errno value.
+int Open(const char* path);
+// Unmaps and removes the file.
+void Close();
+
+// Installs the GC and event loop hooks for |env|.  The loop hooks are
+// torn down with the environment's other handles.  No-op when the exporter
+// is not enabled.
+void Attach(Environment* env);
+
+}  // namespace metrics
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_METRICS_SHM_H_
@@ -11,6 +11,11 @@
 #include "v8.h"
 #include "zlib.h"
 
+#if HAVE_BROTLI
+#include <brotli/decode.h>
+#include <brotli/encode.h>
+#endif
+
 #include <errno.h>
 #include <stdlib.h>
 #include <string.h>
@@ -24,7 +29,9 @@ using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::HandleScope;
 using v8::Integer;
+using v8::Isolate;
 using v8::Local;
+using v8::Null;
 using v8::Number;
 using v8::Object;
 using v8::Value;
@@ -37,7 +44,9 @@ enum node_zlib_mode {
   GUNZIP,
   DEFLATERAW,
   INFLATERAW,
-  UNZIP
+  UNZIP,
+  BROTLI_ENCODE,
+  BROTLI_DECODE
 };
 
 #define GZIP_HEADER_ID1 0x1f
@@ -46,6 +55,190 @@ enum node_zlib_mode {
 void InitZlib(v8::Local<v8::Object> target);
 
 
+static bool IsDeflateMode(node_zlib_mode mode) {
+  return mode == DEFLATE || mode == GZIP || mode == DEFLATERAW;
+}
+
+
+/**
+ * A z_stream together with the parameters it was initialized with.  zlib's
+ * internal state points back at the z_stream, so contexts are heap allocated
+ * and never move.  All memory zlib allocates for the stream goes through
+ * Alloc() and Free(), which keep track of the total so it can be reported to
+ * V8 exactly.  They may run on the threadpool; the total is reported from the
+ * main thread by ReportMemory().
+ */
+struct ZlibContext {
+  ZlibContext(node_zlib_mode mode, int level, int windowBits, int memLevel,
+              int strategy)
+      : mode(mode),
+        level(level),
+        windowBits(windowBits),
+        memLevel(memLevel),
+        strategy(strategy),
+        initialized(false),
+        allocated(0),
+        reported(0),
+        next(nullptr) {
+    memset(&strm, 0, sizeof(strm));
+    strm.zalloc = Alloc;
+    strm.zfree = Free;
+    strm.opaque = this;
+  }
+
+  bool Matches(node_zlib_mode mode, int level, int windowBits, int memLevel,
+               int strategy) const {
+    if (this->mode != mode || this->windowBits != windowBits)
+      return false;
+    // Only the window size matters for inflate.
+    if (!IsDeflateMode(mode))
+      return true;
+    return this->level == level &&
+           this->memLevel == memLevel &&
+           this->strategy == strategy;
+  }
+
+  // Returns false if the stream can't be reused.
+  bool Reset() {
+    if (!initialized)
+      return false;
+    int err = IsDeflateMode(mode) ? deflateReset(&strm) : inflateReset(&strm);
+    return err == Z_OK;
+  }
+
+  void End() {
+    if (IsDeflateMode(mode))
+      (void)deflateEnd(&strm);
+    else
+      (void)inflateEnd(&strm);
+    initialized = false;
+  }
+
+  void ReportMemory(Isolate* isolate) {
+    int64_t change_in_bytes = static_cast<int64_t>(allocated) -
+                              static_cast<int64_t>(reported);
+    reported = allocated;
+    if (change_in_bytes != 0)
+      isolate->AdjustAmountOfExternalAllocatedMemory(change_in_bytes);
+  }
+
+  static voidpf Alloc(voidpf opaque, uInt items, uInt size) {
+    ZlibContext* ctx = static_cast<ZlibContext*>(opaque);
+    size_t len = static_cast<size_t>(items) * size;
+    // Prefix the block with its size so that Free() can account for it.
+    size_t* block = static_cast<size_t*>(malloc(sizeof(size_t) + len));
+    if (block == nullptr)
+      return Z_NULL;
+    *block = len;
+    ctx->allocated += len;
+    return block + 1;
+  }
+
+  static void Free(voidpf opaque, voidpf address) {
+    if (address == Z_NULL)
+      return;
+    ZlibContext* ctx = static_cast<ZlibContext*>(opaque);
+    size_t* block = static_cast<size_t*>(address) - 1;
+    ctx->allocated -= *block;
+    free(block);
+  }
+
+  z_stream strm;
+  // The mode the stream was initialized for.  UNZIP streams stay UNZIP
+  // here, even after ZCtx has figured out the actual format.
+  const node_zlib_mode mode;
+  int level;
+  const int windowBits;
+  const int memLevel;
+  int strategy;
+  bool initialized;
+  size_t allocated;
+  size_t reported;
+  ZlibContext* next;
+};
+
+
+/**
+ * Per-environment pool of initialized zlib streams.  Setting up a deflate
+ * stream allocates and clears a few hundred KB of window and hash tables,
+ * which easily costs more than compressing a small payload.  Closed streams
+ * are reset and kept here, most recently used first, and handed out again
+ * to new streams with the same parameters.
+ */
+class ZlibContextPool {
+ public:
+  // Don't keep more than this many bytes worth of idle streams around.
+  static const size_t kMaxPooledBytes = 4 * 1024 * 1024;
+
+  explicit ZlibContextPool(Environment* env)
+      : env_(env), head_(nullptr), pooled_bytes_(0) {
+  }
+
+  ~ZlibContextPool() {
+    // Not reported to V8, the isolate is on its way out.
+    while (head_ != nullptr) {
+      ZlibContext* ctx = head_;
+      head_ = ctx->next;
+      ctx->End();
+      delete ctx;
+    }
+  }
+
+  static ZlibContextPool* From(Environment* env) {
+    ZlibContextPool* pool = env->zlib_context_pool();
+    if (pool == nullptr) {
+      pool = new ZlibContextPool(env);
+      env->set_zlib_context_pool(pool);
+    }
+    return pool;
+  }
+
+  // Returns an idle stream initialized with the given parameters, or nullptr.
+  ZlibContext* Take(node_zlib_mode mode, int level, int windowBits,
+                    int memLevel, int strategy) {
+    ZlibContext** link = &head_;
+    while (*link != nullptr) {
+      ZlibContext* ctx = *link;
+      if (ctx->Matches(mode, level, windowBits, memLevel, strategy)) {
+        *link = ctx->next;
+        ctx->next = nullptr;
+        pooled_bytes_ -= ctx->allocated;
+        return ctx;
+      }
+      link = &ctx->next;
+    }
+    return nullptr;
+  }
+
+  // Takes ownership of `ctx`, either keeping it for reuse or freeing it.
+  void Put(ZlibContext* ctx) {
+    if (ctx->Reset() &&
+        pooled_bytes_ + ctx->allocated <= kMaxPooledBytes) {
+      ctx->next = head_;
+      head_ = ctx;
+      pooled_bytes_ += ctx->allocated;
+      // inflateReset() keeps the window, deflateReset() keeps everything,
+      // but be exact about it anyway.
+      ctx->ReportMemory(env_->isolate());
+      return;
+    }
+    ctx->End();
+    ctx->ReportMemory(env_->isolate());
+    delete ctx;
+  }
+
+ private:
+  Environment* const env_;
+  ZlibContext* head_;
+  size_t pooled_bytes_;
+};
+
+
+void DeleteZlibContextPool(ZlibContextPool* pool) {
+  delete pool;
+}
+
+
 /**
  * Deflate/Inflate
  */
@@ -53,6 +246,7 @@ class ZCtx : public AsyncWrap {
  public:
   ZCtx(Environment* env, Local<Object> wrap, node_zlib_mode mode)
       : AsyncWrap(env, wrap, AsyncWrap::PROVIDER_ZLIB),
+        context_(nullptr),
         dictionary_(nullptr),
         dictionary_len_(0),
         err_(0),
@@ -61,7 +255,11 @@ class ZCtx : public AsyncWrap {
         level_(0),
         memLevel_(0),
         mode_(mode),
+        out_(nullptr),
+        out_size_(0),
+        max_out_size_(0),
         strategy_(0),
+        strm_(nullptr),
         windowBits_(0),
         write_in_progress_(false),
         pending_close_(false),
@@ -86,15 +284,13 @@ class ZCtx : public AsyncWrap {
     CHECK(init_done_ && "close before init");
     CHECK_LE(mode_, UNZIP);
 
-    if (mode_ == DEFLATE || mode_ == GZIP || mode_ == DEFLATERAW) {
-      (void)deflateEnd(&strm_);
-      int64_t change_in_bytes = -static_cast<int64_t>(kDeflateContextSize);
-      env()->isolate()->AdjustAmountOfExternalAllocatedMemory(change_in_bytes);
-    } else if (mode_ == INFLATE || mode_ == GUNZIP || mode_ == INFLATERAW ||
-               mode_ == UNZIP) {
-      (void)inflateEnd(&strm_);
-      int64_t change_in_bytes = -static_cast<int64_t>(kInflateContextSize);
-      env()->isolate()->AdjustAmountOfExternalAllocatedMemory(change_in_bytes);
+    free(out_);
+    out_ = nullptr;
+
+    if (context_ != nullptr) {
+      ZlibContextPool::From(env())->Put(context_);
+      context_ = nullptr;
+      strm_ = nullptr;
     }
     mode_ = NONE;
 
@@ -171,16 +367,17 @@ class ZCtx : public AsyncWrap {
     // build up the work request
     uv_work_t* work_req = &(ctx->work_req_);
 
-    ctx->strm_.avail_in = in_len;
-    ctx->strm_.next_in = in;
-    ctx->strm_.avail_out = out_len;
-    ctx->strm_.next_out = out;
+    ctx->strm_->avail_in = in_len;
+    ctx->strm_->next_in = in;
+    ctx->strm_->avail_out = out_len;
+    ctx->strm_->next_out = out;
     ctx->flush_ = flush;
 
     if (!async) {
       // sync version
       ctx->env()->PrintSyncTrace();
       Process(work_req);
+      ctx->context_->ReportMemory(env->isolate());
       if (CheckError(ctx))
         AfterSync(ctx, args);
       return;
@@ -196,12 +393,181 @@ class ZCtx : public AsyncWrap {
   }
 
 
+  // writeAll(flush, in, max_out_len)
+  // Runs all of `in` through the stream in one go and returns the output as
+  // a single buffer, or null if it would reach `max_out_len` bytes.  The
+  // async version does all of the work in one threadpool job and passes the
+  // result to the write() callback.
+  template <bool async>
+  static void WriteAll(const FunctionCallbackInfo<Value>& args) {
+    CHECK_EQ(args.Length(), 3);
+
+    ZCtx* ctx;
+    ASSIGN_OR_RETURN_UNWRAP(&ctx, args.Holder());
+    CHECK(ctx->init_done_ && "write before init");
+    CHECK(ctx->mode_ != NONE && "already finalized");
+
+    CHECK_EQ(false, ctx->write_in_progress_ && "write already in progress");
+    CHECK_EQ(false, ctx->pending_close_ && "close is pending");
+
+    unsigned int flush = args[0]->Uint32Value();
+    CHECK(flush == Z_NO_FLUSH ||
+          flush == Z_PARTIAL_FLUSH ||
+          flush == Z_SYNC_FLUSH ||
+          flush == Z_FULL_FLUSH ||
+          flush == Z_FINISH ||
+          flush == Z_BLOCK);
+
+    CHECK(Buffer::HasInstance(args[1]));
+    Bytef* in = reinterpret_cast<Bytef*>(Buffer::Data(args[1]));
+    size_t in_len = Buffer::Length(args[1]);
+
+    size_t max_out_len = args[2]->Uint32Value();
+    CHECK(max_out_len > 0 && max_out_len <= Buffer::kMaxLength);
+
+    // Compressed output is sized exactly, inflated output starts at a guess
+    // and grows as needed.
+    size_t out_len;
+    switch (ctx->mode_) {
+      case DEFLATE:
+      case GZIP:
+      case DEFLATERAW:
+        out_len = deflateBound(ctx->strm_, in_len);
+        break;
+      default:
+        out_len = in_len * 4;
+        if (out_len < kMinInflateOutput)
+          out_len = kMinInflateOutput;
+        break;
+    }
+    if (out_len > max_out_len)
+      out_len = max_out_len;
+
+    CHECK_EQ(ctx->out_, nullptr);
+    ctx->out_ = node::Malloc(out_len);
+    ctx->out_size_ = out_len;
+    ctx->max_out_size_ = max_out_len;
+
+    ctx->write_in_progress_ = true;
+    ctx->Ref();
+
+    ctx->strm_->avail_in = in_len;
+    ctx->strm_->next_in = in;
+    ctx->strm_->avail_out = out_len;
+    ctx->strm_->next_out = reinterpret_cast<Bytef*>(ctx->out_);
+    ctx->flush_ = flush;
+
+    uv_work_t* work_req = &(ctx->work_req_);
+
+    if (!async) {
+      Environment* env = ctx->env();
+      env->PrintSyncTrace();
+      ProcessAll(work_req);
+      ctx->context_->ReportMemory(env->isolate());
+      if (CheckError(ctx)) {
+        args.GetReturnValue().Set(ctx->TakeOutput());
+        ctx->write_in_progress_ = false;
+        ctx->Unref();
+      }
+      return;
+    }
+
+    uv_queue_work(ctx->env()->event_loop(),
+                  work_req,
+                  ZCtx::ProcessAll,
+                  ZCtx::AfterAll);
+
+    args.GetReturnValue().Set(ctx->object());
+  }
+
+
+  // thread pool!
+  // Calls Process() until it leaves output space unused, the same way the
+  // JS side drives write(), growing the output buffer in between.
+  static void ProcessAll(uv_work_t* work_req) {
+    ZCtx* ctx = ContainerOf(&ZCtx::work_req_, work_req);
+    z_stream* strm = ctx->strm_;
+
+    for (;;) {
+      Process(work_req);
+
+      if (ctx->err_ != Z_OK &&
+          ctx->err_ != Z_BUF_ERROR &&
+          ctx->err_ != Z_STREAM_END) {
+        return;
+      }
+      if (strm->avail_out != 0)
+        return;
+
+      // Out of space.  Stop at the limit, TakeOutput() reports that.
+      size_t used = ctx->out_size_;
+      if (used >= ctx->max_out_size_)
+        return;
+      size_t size = used * 2;
+      if (size > ctx->max_out_size_)
+        size = ctx->max_out_size_;
+      char* out = static_cast<char*>(realloc(ctx->out_, size));
+      if (out == nullptr) {
+        ctx->err_ = Z_MEM_ERROR;
+        return;
+      }
+      ctx->out_ = out;
+      ctx->out_size_ = size;
+      strm->next_out = reinterpret_cast<Bytef*>(out + used);
+      strm->avail_out = size - used;
+    }
+  }
+
+
+  static void AfterAll(uv_work_t* work_req, int status) {
+    CHECK_EQ(status, 0);
+
+    ZCtx* ctx = ContainerOf(&ZCtx::work_req_, work_req);
+    Environment* env = ctx->env();
+
+    HandleScope handle_scope(env->isolate());
+    Context::Scope context_scope(env->context());
+
+    ctx->context_->ReportMemory(env->isolate());
+
+    if (!CheckError(ctx))
+      return;
+
+    Local<Value> result = ctx->TakeOutput();
+
+    ctx->write_in_progress_ = false;
+
+    ctx->MakeCallback(env->callback_string(), 1, &result);
+
+    ctx->Unref();
+    if (ctx->pending_close_)
+      ctx->Close();
+  }
+
+
+  Local<Value> TakeOutput() {
+    char* data = out_;
+    out_ = nullptr;
+
+    // ProcessAll() ran into the size limit.
+    if (strm_->avail_out == 0) {
+      free(data);
+      return Null(env()->isolate());
+    }
+
+    size_t len = out_size_ - strm_->avail_out;
+    if (len < out_size_)
+      data = node::Realloc(data, len);
+    return Buffer::New(env(), data, len).ToLocalChecked();
+  }
+
+
   static void AfterSync(ZCtx* ctx, const FunctionCallbackInfo<Value>& args) {
     Environment* env = ctx->env();
     Local<Integer> avail_out = Integer::New(env->isolate(),
-                                            ctx->strm_.avail_out);
+                                            ctx->strm_->avail_out);
     Local<Integer> avail_in = Integer::New(env->isolate(),
-                                           ctx->strm_.avail_in);
+                                           ctx->strm_->avail_in);
 
     ctx->write_in_progress_ = false;
 
@@ -230,11 +596,11 @@ class ZCtx : public AsyncWrap {
       case DEFLATE:
       case GZIP:
       case DEFLATERAW:
-        ctx->err_ = deflate(&ctx->strm_, ctx->flush_);
+        ctx->err_ = deflate(ctx->strm_, ctx->flush_);
         break;
       case UNZIP:
-        if (ctx->strm_.avail_in > 0) {
-          next_expected_header_byte = ctx->strm_.next_in;
+        if (ctx->strm_->avail_in > 0) {
+          next_expected_header_byte = ctx->strm_->next_in;
         }
 
         switch (ctx->gzip_id_bytes_read_) {
@@ -247,7 +613,7 @@ class ZCtx : public AsyncWrap {
               ctx->gzip_id_bytes_read_ = 1;
               next_expected_header_byte++;
 
-              if (ctx->strm_.avail_in == 1) {
+              if (ctx->strm_->avail_in == 1) {
                 // The only available byte was already read.
                 break;
               }
@@ -280,7 +646,7 @@ class ZCtx : public AsyncWrap {
       case INFLATE:
       case GUNZIP:
       case INFLATERAW:
-        ctx->err_ = inflate(&ctx->strm_, ctx->flush_);
+        ctx->err_ = inflate(ctx->strm_, ctx->flush_);
 
         // If data was encoded with dictionary (INFLATERAW will have it set in
         // SetDictionary, don't repeat that here)
@@ -288,12 +654,12 @@ class ZCtx : public AsyncWrap {
             ctx->err_ == Z_NEED_DICT &&
             ctx->dictionary_ != nullptr) {
           // Load it
-          ctx->err_ = inflateSetDictionary(&ctx->strm_,
+          ctx->err_ = inflateSetDictionary(ctx->strm_,
                                            ctx->dictionary_,
                                            ctx->dictionary_len_);
           if (ctx->err_ == Z_OK) {
             // And try to decode again
-            ctx->err_ = inflate(&ctx->strm_, ctx->flush_);
+            ctx->err_ = inflate(ctx->strm_, ctx->flush_);
           } else if (ctx->err_ == Z_DATA_ERROR) {
             // Both inflateSetDictionary() and inflate() return Z_DATA_ERROR.
             // Make it possible for After() to tell a bad dictionary from bad
@@ -302,17 +668,17 @@ class ZCtx : public AsyncWrap {
           }
         }
 
-        while (ctx->strm_.avail_in > 0 &&
+        while (ctx->strm_->avail_in > 0 &&
                ctx->mode_ == GUNZIP &&
                ctx->err_ == Z_STREAM_END &&
-               ctx->strm_.next_in[0] != 0x00) {
+               ctx->strm_->next_in[0] != 0x00) {
           // Bytes remain in input buffer. Perhaps this is another compressed
           // member in the same archive, or just trailing garbage.
           // Trailing zero bytes are okay, though, since they are frequently
           // used for padding.
 
           Reset(ctx);
-          ctx->err_ = inflate(&ctx->strm_, ctx->flush_);
+          ctx->err_ = inflate(ctx->strm_, ctx->flush_);
         }
         break;
       default:
@@ -332,7 +698,7 @@ class ZCtx : public AsyncWrap {
     switch (ctx->err_) {
     case Z_OK:
     case Z_BUF_ERROR:
-      if (ctx->strm_.avail_out != 0 && ctx->flush_ == Z_FINISH) {
+      if (ctx->strm_->avail_out != 0 && ctx->flush_ == Z_FINISH) {
         ZCtx::Error(ctx, "unexpected end of file");
         return false;
       }
@@ -365,13 +731,16 @@ class ZCtx : public AsyncWrap {
     HandleScope handle_scope(env->isolate());
     Context::Scope context_scope(env->context());
 
+    // inflate() allocates its window on first use.
+    ctx->context_->ReportMemory(env->isolate());
+
     if (!CheckError(ctx))
       return;
 
     Local<Integer> avail_out = Integer::New(env->isolate(),
-                                            ctx->strm_.avail_out);
+                                            ctx->strm_->avail_out);
     Local<Integer> avail_in = Integer::New(env->isolate(),
-                                           ctx->strm_.avail_in);
+                                           ctx->strm_->avail_in);
 
     ctx->write_in_progress_ = false;
 
@@ -390,8 +759,8 @@ class ZCtx : public AsyncWrap {
     // If you hit this assertion, you forgot to enter the v8::Context first.
     CHECK_EQ(env->context(), env->isolate()->GetCurrentContext());
 
-    if (ctx->strm_.msg != nullptr) {
-      message = ctx->strm_.msg;
+    if (ctx->strm_->msg != nullptr) {
+      message = ctx->strm_->msg;
     }
 
     HandleScope scope(env->isolate());
@@ -485,10 +854,6 @@ class ZCtx : public AsyncWrap {
     ctx->memLevel_ = memLevel;
     ctx->strategy_ = strategy;
 
-    ctx->strm_.zalloc = Z_NULL;
-    ctx->strm_.zfree = Z_NULL;
-    ctx->strm_.opaque = Z_NULL;
-
     ctx->flush_ = Z_NO_FLUSH;
 
     ctx->err_ = Z_OK;
@@ -505,29 +870,45 @@ class ZCtx : public AsyncWrap {
       ctx->windowBits_ *= -1;
     }
 
-    switch (ctx->mode_) {
-      case DEFLATE:
-      case GZIP:
-      case DEFLATERAW:
-        ctx->err_ = deflateInit2(&ctx->strm_,
-                                 ctx->level_,
-                                 Z_DEFLATED,
-                                 ctx->windowBits_,
-                                 ctx->memLevel_,
-                                 ctx->strategy_);
-        ctx->env()->isolate()
-            ->AdjustAmountOfExternalAllocatedMemory(kDeflateContextSize);
-        break;
-      case INFLATE:
-      case GUNZIP:
-      case INFLATERAW:
-      case UNZIP:
-        ctx->err_ = inflateInit2(&ctx->strm_, ctx->windowBits_);
-        ctx->env()->isolate()
-            ->AdjustAmountOfExternalAllocatedMemory(kInflateContextSize);
-        break;
-      default:
-        CHECK(0 && "wtf?");
+    ZlibContextPool* pool = ZlibContextPool::From(ctx->env());
+    ctx->context_ = pool->Take(ctx->mode_,
+                               ctx->level_,
+                               ctx->windowBits_,
+                               ctx->memLevel_,
+                               ctx->strategy_);
+    if (ctx->context_ == nullptr) {
+      ctx->context_ = new ZlibContext(ctx->mode_,
+                                      ctx->level_,
+                                      ctx->windowBits_,
+                                      ctx->memLevel_,
+                                      ctx->strategy_);
+      ctx->strm_ = &ctx->context_->strm;
+
+      switch (ctx->mode_) {
+        case DEFLATE:
+        case GZIP:
+        case DEFLATERAW:
+          ctx->err_ = deflateInit2(ctx->strm_,
+                                   ctx->level_,
+                                   Z_DEFLATED,
+                                   ctx->windowBits_,
+                                   ctx->memLevel_,
+                                   ctx->strategy_);
+          break;
+        case INFLATE:
+        case GUNZIP:
+        case INFLATERAW:
+        case UNZIP:
+          ctx->err_ = inflateInit2(ctx->strm_, ctx->windowBits_);
+          break;
+        default:
+          CHECK(0 && "wtf?");
+      }
+
+      ctx->context_->initialized = ctx->err_ == Z_OK;
+      ctx->context_->ReportMemory(ctx->env()->isolate());
+    } else {
+      ctx->strm_ = &ctx->context_->strm;
     }
 
     if (ctx->err_ != Z_OK) {
@@ -551,14 +932,14 @@ class ZCtx : public AsyncWrap {
     switch (ctx->mode_) {
       case DEFLATE:
       case DEFLATERAW:
-        ctx->err_ = deflateSetDictionary(&ctx->strm_,
+        ctx->err_ = deflateSetDictionary(ctx->strm_,
                                          ctx->dictionary_,
                                          ctx->dictionary_len_);
         break;
       case INFLATERAW:
         // The other inflate cases will have the dictionary set when inflate()
         // returns Z_NEED_DICT in Process()
-        ctx->err_ = inflateSetDictionary(&ctx->strm_,
+        ctx->err_ = inflateSetDictionary(ctx->strm_,
                                          ctx->dictionary_,
                                          ctx->dictionary_len_);
         break;
@@ -577,7 +958,12 @@ class ZCtx : public AsyncWrap {
     switch (ctx->mode_) {
       case DEFLATE:
       case DEFLATERAW:
-        ctx->err_ = deflateParams(&ctx->strm_, level, strategy);
+        ctx->err_ = deflateParams(ctx->strm_, level, strategy);
+        // The stream keeps the new parameters across resets.
+        if (ctx->err_ == Z_OK || ctx->err_ == Z_BUF_ERROR) {
+          ctx->context_->level = level;
+          ctx->context_->strategy = strategy;
+        }
         break;
       default:
         break;
@@ -595,12 +981,12 @@ class ZCtx : public AsyncWrap {
       case DEFLATE:
       case DEFLATERAW:
       case GZIP:
-        ctx->err_ = deflateReset(&ctx->strm_);
+        ctx->err_ = deflateReset(ctx->strm_);
         break;
       case INFLATE:
       case INFLATERAW:
       case GUNZIP:
-        ctx->err_ = inflateReset(&ctx->strm_);
+        ctx->err_ = inflateReset(ctx->strm_);
         break;
       default:
         break;
@@ -627,9 +1013,10 @@ class ZCtx : public AsyncWrap {
     }
   }
 
-  static const int kDeflateContextSize = 16384;  // approximate
-  static const int kInflateContextSize = 10240;  // approximate
+  // Initial output buffer size for writeAll() when inflating.
+  static const size_t kMinInflateOutput = 1024;
 
+  ZlibContext* context_;
   Bytef* dictionary_;
   size_t dictionary_len_;
   int err_;
@@ -638,8 +1025,11 @@ class ZCtx : public AsyncWrap {
   int level_;
   int memLevel_;
   node_zlib_mode mode_;
+  char* out_;
+  size_t out_size_;
+  size_t max_out_size_;
   int strategy_;
-  z_stream strm_;
+  z_stream* strm_;
   int windowBits_;
   uv_work_t work_req_;
   bool write_in_progress_;
@@ -649,6 +1039,610 @@ class ZCtx : public AsyncWrap {
 };
 
 
+#if HAVE_BROTLI
+/**
+ * Brotli compression and decompression.  Mirrors ZCtx: the JS side drives
+ * it through the same write()/writeSync()/writeAll()/writeAllSync() calls,
+ * only the flush values are BROTLI_OPERATION_* rather than Z_*_FLUSH.
+ */
+class BrotliCtx : public AsyncWrap {
+ public:
+  BrotliCtx(Environment* env, Local<Object> wrap, node_zlib_mode mode)
+      : AsyncWrap(env, wrap, AsyncWrap::PROVIDER_ZLIB),
+        allocated_(0),
+        avail_in_(0),
+        avail_out_(0),
+        decoder_(nullptr),
+        decoder_result_(BROTLI_DECODER_RESULT_SUCCESS),
+        encoder_(nullptr),
+        flush_(BROTLI_OPERATION_PROCESS),
+        init_done_(false),
+        lgwin_(BROTLI_DEFAULT_WINDOW),
+        mode_(mode),
+        next_in_(nullptr),
+        next_out_(nullptr),
+        ok_(true),
+        out_(nullptr),
+        out_size_(0),
+        max_out_size_(0),
+        quality_(BROTLI_DEFAULT_QUALITY),
+        reported_(0),
+        text_mode_(BROTLI_DEFAULT_MODE),
+        write_in_progress_(false),
+        pending_close_(false),
+        refs_(0) {
+    MakeWeak<BrotliCtx>(this);
+  }
+
+
+  ~BrotliCtx() override {
+    CHECK_EQ(false, write_in_progress_ && "write in progress");
+    Close();
+  }
+
+  void Close() {
+    if (write_in_progress_) {
+      pending_close_ = true;
+      return;
+    }
+
+    pending_close_ = false;
+    CHECK(init_done_ && "close before init");
+
+    free(out_);
+    out_ = nullptr;
+
+    DestroyState();
+    ReportMemory();
+    mode_ = NONE;
+  }
+
+
+  static void Close(const FunctionCallbackInfo<Value>& args) {
+    BrotliCtx* ctx;
+    ASSIGN_OR_RETURN_UNWRAP(&ctx, args.Holder());
+    ctx->Close();
+  }
+
+
+  // write(flush, in, in_off, in_len, out, out_off, out_len)
+  template <bool async>
+  static void Write(const FunctionCallbackInfo<Value>& args) {
+    CHECK_EQ(args.Length(), 7);
+
+    BrotliCtx* ctx;
+    ASSIGN_OR_RETURN_UNWRAP(&ctx, args.Holder());
+    CHECK(ctx->init_done_ && "write before init");
+    CHECK(ctx->mode_ != NONE && "already finalized");
+
+    CHECK_EQ(false, ctx->write_in_progress_ && "write already in progress");
+    CHECK_EQ(false, ctx->pending_close_ && "close is pending");
+    ctx->write_in_progress_ = true;
+    ctx->Ref();
+
+    unsigned int flush = args[0]->Uint32Value();
+    CHECK(IsValidFlush(flush) && "Invalid flush value");
+
+    Environment* env = ctx->env();
+    const uint8_t* in;
+    size_t in_len;
+
+    if (args[1]->IsNull()) {
+      // just a flush
+      in = nullptr;
+      in_len = 0;
+    } else {
+      CHECK(Buffer::HasInstance(args[1]));
+      Local<Object> in_buf = args[1]->ToObject(env->isolate());
+      size_t in_off = args[2]->Uint32Value();
+      in_len = args[3]->Uint32Value();
+
+      CHECK(Buffer::IsWithinBounds(in_off, in_len, Buffer::Length(in_buf)));
+      in = reinterpret_cast<uint8_t*>(Buffer::Data(in_buf) + in_off);
+    }
+
+    CHECK(Buffer::HasInstance(args[4]));
+    Local<Object> out_buf = args[4]->ToObject(env->isolate());
+    size_t out_off = args[5]->Uint32Value();
+    size_t out_len = args[6]->Uint32Value();
+    CHECK(Buffer::IsWithinBounds(out_off, out_len, Buffer::Length(out_buf)));
+
+    ctx->next_in_ = in;
+    ctx->avail_in_ = in_len;
+    ctx->next_out_ =
+        reinterpret_cast<uint8_t*>(Buffer::Data(out_buf) + out_off);
+    ctx->avail_out_ = out_len;
+    ctx->flush_ = static_cast<BrotliEncoderOperation>(flush);
+
+    uv_work_t* work_req = &(ctx->work_req_);
+
+    if (!async) {
+      // sync version
+      env->PrintSyncTrace();
+      Process(work_req);
+      ctx->ReportMemory();
+      if (CheckError(ctx))
+        AfterSync(ctx, args);
+      return;
+    }
+
+    // async version
+    uv_queue_work(env->event_loop(),
+                  work_req,
+                  BrotliCtx::Process,
+                  BrotliCtx::After);
+
+    args.GetReturnValue().Set(ctx->object());
+  }
+
+
+  // writeAll(flush, in, max_out_len), see ZCtx::WriteAll().
+  template <bool async>
+  static void WriteAll(const FunctionCallbackInfo<Value>& args) {
+    CHECK_EQ(args.Length(), 3);
+
+    BrotliCtx* ctx;
+    ASSIGN_OR_RETURN_UNWRAP(&ctx, args.Holder());
+    CHECK(ctx->init_done_ && "write before init");
+    CHECK(ctx->mode_ != NONE && "already finalized");
+
+    CHECK_EQ(false, ctx->write_in_progress_ && "write already in progress");
+    CHECK_EQ(false, ctx->pending_close_ && "close is pending");
+
+    unsigned int flush = args[0]->Uint32Value();
+    CHECK(IsValidFlush(flush) && "Invalid flush value");
+
+    CHECK(Buffer::HasInstance(args[1]));
+    const uint8_t* in = reinterpret_cast<uint8_t*>(Buffer::Data(args[1]));
+    size_t in_len = Buffer::Length(args[1]);
+
+    size_t max_out_len = args[2]->Uint32Value();
+    CHECK(max_out_len > 0 && max_out_len <= Buffer::kMaxLength);
+
+    size_t out_len = 0;
+    if (ctx->mode_ == BROTLI_ENCODE)
+      out_len = BrotliEncoderMaxCompressedSize(in_len);
+    if (out_len == 0) {
+      out_len = in_len * 4;
+      if (out_len < kMinOutput)
+        out_len = kMinOutput;
+    }
+    if (out_len > max_out_len)
+      out_len = max_out_len;
+
+    CHECK_EQ(ctx->out_, nullptr);
+    ctx->out_ = node::Malloc(out_len);
+    ctx->out_size_ = out_len;
+    ctx->max_out_size_ = max_out_len;
+
+    ctx->write_in_progress_ = true;
+    ctx->Ref();
+
+    ctx->next_in_ = in;
+    ctx->avail_in_ = in_len;
+    ctx->next_out_ = reinterpret_cast<uint8_t*>(ctx->out_);
+    ctx->avail_out_ = out_len;
+    ctx->flush_ = static_cast<BrotliEncoderOperation>(flush);
+
+    uv_work_t* work_req = &(ctx->work_req_);
+
+    if (!async) {
+      Environment* env = ctx->env();
+      env->PrintSyncTrace();
+      ProcessAll(work_req);
+      ctx->ReportMemory();
+      if (CheckError(ctx)) {
+        args.GetReturnValue().Set(ctx->TakeOutput());
+        ctx->write_in_progress_ = false;
+        ctx->Unref();
+      }
+      return;
+    }
+
+    uv_queue_work(ctx->env()->event_loop(),
+                  work_req,
+                  BrotliCtx::ProcessAll,
+                  BrotliCtx::AfterAll);
+
+    args.GetReturnValue().Set(ctx->object());
+  }
+
+
+  // thread pool!
+  // Like ZCtx::Process(), leaves avail_out_ at 0 if it ran out of room,
+  // otherwise all of the input has been consumed and, for the flush and
+  // finish operations, all of the pending output has been written.
+  static void Process(uv_work_t* work_req) {
+    BrotliCtx* ctx = ContainerOf(&BrotliCtx::work_req_, work_req);
+
+    if (ctx->mode_ == BROTLI_ENCODE) {
+      BrotliEncoderState* encoder = ctx->encoder_;
+      do {
+        ctx->ok_ = BrotliEncoderCompressStream(encoder,
+                                               ctx->flush_,
+                                               &ctx->avail_in_,
+                                               &ctx->next_in_,
+                                               &ctx->avail_out_,
+                                               &ctx->next_out_,
+                                               nullptr);
+      } while (ctx->ok_ &&
+               ctx->avail_out_ > 0 &&
+               (ctx->avail_in_ > 0 ||
+                BrotliEncoderHasMoreOutput(encoder) ||
+                (ctx->flush_ == BROTLI_OPERATION_FINISH &&
+                 !BrotliEncoderIsFinished(encoder))));
+    } else {
+      ctx->decoder_result_ = BrotliDecoderDecompressStream(ctx->decoder_,
+                                                           &ctx->avail_in_,
+                                                           &ctx->next_in_,
+                                                           &ctx->avail_out_,
+                                                           &ctx->next_out_,
+                                                           nullptr);
+    }
+  }
+
+
+  // thread pool!
+  static void ProcessAll(uv_work_t* work_req) {
+    BrotliCtx* ctx = ContainerOf(&BrotliCtx::work_req_, work_req);
+
+    for (;;) {
+      Process(work_req);
+
+      if (!ctx->ok_ || ctx->decoder_result_ == BROTLI_DECODER_RESULT_ERROR)
+        return;
+      if (ctx->avail_out_ != 0)
+        return;
+
+      // Out of space.  Stop at the limit, TakeOutput() reports that.
+      size_t used = ctx->out_size_;
+      if (used >= ctx->max_out_size_)
+        return;
+      size_t size = used * 2;
+      if (size > ctx->max_out_size_)
+        size = ctx->max_out_size_;
+      char* out = static_cast<char*>(realloc(ctx->out_, size));
+      if (out == nullptr) {
+        ctx->ok_ = false;
+        return;
+      }
+      ctx->out_ = out;
+      ctx->out_size_ = size;
+      ctx->next_out_ = reinterpret_cast<uint8_t*>(out + used);
+      ctx->avail_out_ = size - used;
+    }
+  }
+
+
+  static bool CheckError(BrotliCtx* ctx) {
+    if (ctx->mode_ == BROTLI_ENCODE) {
+      if (!ctx->ok_) {
+        ctx->Error("Compression failed", -1, "ERR_BROTLI_COMPRESSION_FAILED");
+        return false;
+      }
+      return true;
+    }
+
+    switch (ctx->decoder_result_) {
+      case BROTLI_DECODER_RESULT_ERROR: {
+        BrotliDecoderErrorCode err = BrotliDecoderGetErrorCode(ctx->decoder_);
+        char code[64];
+        snprintf(code, sizeof(code), "ERR_BROTLI_%s",
+                 BrotliDecoderErrorString(err));
+        ctx->Error("Decompression failed", err, code);
+        return false;
+      }
+      case BROTLI_DECODER_RESULT_NEEDS_MORE_INPUT:
+        if (ctx->flush_ == BROTLI_OPERATION_FINISH) {
+          ctx->Error("unexpected end of file", Z_BUF_ERROR, "Z_BUF_ERROR");
+          return false;
+        }
+        break;
+      case BROTLI_DECODER_RESULT_SUCCESS:
+        // The stream has ended, anything after it is not brotli data.
+        // Unlike gzip, there are no further members that could follow.
+        if (ctx->avail_in_ > 0) {
+          ctx->Error("Junk found after end of compressed data",
+                     Z_DATA_ERROR,
+                     "Z_DATA_ERROR");
+          return false;
+        }
+        break;
+      default:
+        break;
+    }
+    return true;
+  }
+
+
+  // v8 land!
+  static void After(uv_work_t* work_req, int status) {
+    CHECK_EQ(status, 0);
+
+    BrotliCtx* ctx = ContainerOf(&BrotliCtx::work_req_, work_req);
+    Environment* env = ctx->env();
+
+    HandleScope handle_scope(env->isolate());
+    Context::Scope context_scope(env->context());
+
+    ctx->ReportMemory();
+
+    if (!CheckError(ctx))
+      return;
+
+    Local<Value> args[2] = {
+      Integer::NewFromUnsigned(env->isolate(), ctx->avail_in_),
+      Integer::NewFromUnsigned(env->isolate(), ctx->avail_out_)
+    };
+
+    ctx->write_in_progress_ = false;
+
+    // call the write() cb
+    ctx->MakeCallback(env->callback_string(), arraysize(args), args);
+
+    ctx->Unref();
+    if (ctx->pending_close_)
+      ctx->Close();
+  }
+
+
+  static void AfterAll(uv_work_t* work_req, int status) {
+    CHECK_EQ(status, 0);
+
+    BrotliCtx* ctx = ContainerOf(&BrotliCtx::work_req_, work_req);
+    Environment* env = ctx->env();
+
+    HandleScope handle_scope(env->isolate());
+    Context::Scope context_scope(env->context());
+
+    ctx->ReportMemory();
+
+    if (!CheckError(ctx))
+      return;
+
+    Local<Value> result = ctx->TakeOutput();
+
+    ctx->write_in_progress_ = false;
+
+    ctx->MakeCallback(env->callback_string(), 1, &result);
+
+    ctx->Unref();
+    if (ctx->pending_close_)
+      ctx->Close();
+  }
+
+
+  static void AfterSync(BrotliCtx* ctx,
+                        const FunctionCallbackInfo<Value>& args) {
+    Isolate* isolate = ctx->env()->isolate();
+
+    ctx->write_in_progress_ = false;
+
+    Local<Array> result = Array::New(isolate, 2);
+    result->Set(0, Integer::NewFromUnsigned(isolate, ctx->avail_in_));
+    result->Set(1, Integer::NewFromUnsigned(isolate, ctx->avail_out_));
+    args.GetReturnValue().Set(result);
+
+    ctx->Unref();
+  }
+
+
+  Local<Value> TakeOutput() {
+    char* data = out_;
+    out_ = nullptr;
+
+    // ProcessAll() ran into the size limit.
+    if (avail_out_ == 0) {
+      free(data);
+      return Null(env()->isolate());
+    }
+
+    size_t len = out_size_ - avail_out_;
+    if (len < out_size_)
+      data = node::Realloc(data, len);
+    return Buffer::New(env(), data, len).ToLocalChecked();
+  }
+
+
+  void Error(const char* message, int err, const char* code) {
+    Environment* env = this->env();
+
+    // If you hit this assertion, you forgot to enter the v8::Context first.
+    CHECK_EQ(env->context(), env->isolate()->GetCurrentContext());
+
+    HandleScope scope(env->isolate());
+    Local<Value> args[3] = {
+      OneByteString(env->isolate(), message),
+      Integer::New(env->isolate(), err),
+      OneByteString(env->isolate(), code)
+    };
+    MakeCallback(env->onerror_string(), arraysize(args), args);
+
+    // no hope of rescue.
+    if (write_in_progress_)
+      Unref();
+    write_in_progress_ = false;
+    if (pending_close_)
+      Close();
+  }
+
+
+  static void New(const FunctionCallbackInfo<Value>& args) {
+    Environment* env = Environment::GetCurrent(args);
+
+    if (args.Length() < 1 || !args[0]->IsInt32()) {
+      return env->ThrowTypeError("Bad argument");
+    }
+    node_zlib_mode mode = static_cast<node_zlib_mode>(args[0]->Int32Value());
+
+    if (mode != BROTLI_ENCODE && mode != BROTLI_DECODE) {
+      return env->ThrowTypeError("Bad argument");
+    }
+
+    new BrotliCtx(env, args.This(), mode);
+  }
+
+
+  // init(quality, lgwin, mode), the arguments are ignored when decoding.
+  static void Init(const FunctionCallbackInfo<Value>& args) {
+    CHECK(args.Length() == 3 && "init(quality, lgwin, mode)");
+
+    BrotliCtx* ctx;
+    ASSIGN_OR_RETURN_UNWRAP(&ctx, args.Holder());
+
+    int quality = args[0]->Int32Value();
+    CHECK((quality >= BROTLI_MIN_QUALITY && quality <= BROTLI_MAX_QUALITY) &&
+          "invalid quality");
+
+    int lgwin = args[1]->Int32Value();
+    CHECK((lgwin >= BROTLI_MIN_WINDOW_BITS &&
+           lgwin <= BROTLI_MAX_WINDOW_BITS) && "invalid lgwin");
+
+    int mode = args[2]->Int32Value();
+    CHECK((mode == BROTLI_MODE_GENERIC ||
+           mode == BROTLI_MODE_TEXT ||
+           mode == BROTLI_MODE_FONT) && "invalid mode");
+
+    ctx->quality_ = quality;
+    ctx->lgwin_ = lgwin;
+    ctx->text_mode_ = static_cast<BrotliEncoderMode>(mode);
+    ctx->init_done_ = true;
+
+    if (!ctx->CreateState()) {
+      ctx->Error("Initialization failed",
+                 -1,
+                 "ERR_BROTLI_INITIALIZATION_FAILED");
+    }
+  }
+
+
+  // Brotli has no way to reset a stream, start over with a fresh state.
+  static void Reset(const FunctionCallbackInfo<Value>& args) {
+    BrotliCtx* ctx;
+    ASSIGN_OR_RETURN_UNWRAP(&ctx, args.Holder());
+
+    ctx->DestroyState();
+    if (!ctx->CreateState()) {
+      ctx->Error("Failed to reset stream",
+                 -1,
+                 "ERR_BROTLI_INITIALIZATION_FAILED");
+    }
+    ctx->ReportMemory();
+  }
+
+
+  size_t self_size() const override { return sizeof(*this); }
+
+ private:
+  static bool IsValidFlush(unsigned int flush) {
+    return flush == BROTLI_OPERATION_PROCESS ||
+           flush == BROTLI_OPERATION_FLUSH ||
+           flush == BROTLI_OPERATION_FINISH;
+  }
+
+  bool CreateState() {
+    ok_ = true;
+    decoder_result_ = BROTLI_DECODER_RESULT_SUCCESS;
+
+    if (mode_ == BROTLI_DECODE) {
+      decoder_ = BrotliDecoderCreateInstance(Alloc, Free, this);
+      return decoder_ != nullptr;
+    }
+
+    encoder_ = BrotliEncoderCreateInstance(Alloc, Free, this);
+    if (encoder_ == nullptr)
+      return false;
+    return BrotliEncoderSetParameter(encoder_, BROTLI_PARAM_QUALITY,
+                                     quality_) &&
+           BrotliEncoderSetParameter(encoder_, BROTLI_PARAM_LGWIN,
+                                     lgwin_) &&
+           BrotliEncoderSetParameter(encoder_, BROTLI_PARAM_MODE,
+                                     text_mode_);
+  }
+
+  void DestroyState() {
+    if (encoder_ != nullptr) {
+      BrotliEncoderDestroyInstance(encoder_);
+      encoder_ = nullptr;
+    }
+    if (decoder_ != nullptr) {
+      BrotliDecoderDestroyInstance(decoder_);
+      decoder_ = nullptr;
+    }
+  }
+
+  // Same bookkeeping as ZlibContext, brotli allocates its window and hash
+  // tables lazily on the threadpool.
+  void ReportMemory() {
+    int64_t change_in_bytes = static_cast<int64_t>(allocated_) -
+                              static_cast<int64_t>(reported_);
+    reported_ = allocated_;
+    if (change_in_bytes != 0)
+      env()->isolate()->AdjustAmountOfExternalAllocatedMemory(change_in_bytes);
+  }
+
+  static void* Alloc(void* opaque, size_t len) {
+    BrotliCtx* ctx = static_cast<BrotliCtx*>(opaque);
+    size_t* block = static_cast<size_t*>(malloc(sizeof(size_t) + len));
+    if (block == nullptr)
+      return nullptr;
+    *block = len;
+    ctx->allocated_ += len;
+    return block + 1;
+  }
+
+  static void Free(void* opaque, void* address) {
+    if (address == nullptr)
+      return;
+    BrotliCtx* ctx = static_cast<BrotliCtx*>(opaque);
+    size_t* block = static_cast<size_t*>(address) - 1;
+    ctx->allocated_ -= *block;
+    free(block);
+  }
+
+  void Ref() {
+    if (++refs_ == 1) {
+      ClearWeak();
+    }
+  }
+
+  void Unref() {
+    CHECK_GT(refs_, 0);
+    if (--refs_ == 0) {
+      MakeWeak<BrotliCtx>(this);
+    }
+  }
+
+  // Initial output buffer size for writeAll() when decompressing.
+  static const size_t kMinOutput = 1024;
+
+  size_t allocated_;
+  size_t avail_in_;
+  size_t avail_out_;
+  BrotliDecoderState* decoder_;
+  BrotliDecoderResult decoder_result_;
+  BrotliEncoderState* encoder_;
+  BrotliEncoderOperation flush_;
+  bool init_done_;
+  int lgwin_;
+  node_zlib_mode mode_;
+  const uint8_t* next_in_;
+  uint8_t* next_out_;
+  bool ok_;
+  char* out_;
+  size_t out_size_;
+  size_t max_out_size_;
+  int quality_;
+  size_t reported_;
+  BrotliEncoderMode text_mode_;
+  uv_work_t work_req_;
+  bool write_in_progress_;
+  bool pending_close_;
+  unsigned int refs_;
+};
+#endif  // HAVE_BROTLI
+
+
 void InitZlib(Local<Object> target,
               Local<Value> unused,
               Local<Context> context,
@@ -660,6 +1654,8 @@ void InitZlib(Local<Object> target,
 
   env->SetProtoMethod(z, "write", ZCtx::Write<true>);
   env->SetProtoMethod(z, "writeSync", ZCtx::Write<false>);
+  env->SetProtoMethod(z, "writeAll", ZCtx::WriteAll<true>);
+  env->SetProtoMethod(z, "writeAllSync", ZCtx::WriteAll<false>);
   env->SetProtoMethod(z, "init", ZCtx::Init);
   env->SetProtoMethod(z, "close", ZCtx::Close);
   env->SetProtoMethod(z, "params", ZCtx::Params);
@@ -670,6 +1666,24 @@ void InitZlib(Local<Object> target,
 
   target->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "ZLIB_VERSION"),
               FIXED_ONE_BYTE_STRING(env->isolate(), ZLIB_VERSION));
+
+#if HAVE_BROTLI
+  Local<FunctionTemplate> b = env->NewFunctionTemplate(BrotliCtx::New);
+
+  b->InstanceTemplate()->SetInternalFieldCount(1);
+
+  env->SetProtoMethod(b, "write", BrotliCtx::Write<true>);
+  env->SetProtoMethod(b, "writeSync", BrotliCtx::Write<false>);
+  env->SetProtoMethod(b, "writeAll", BrotliCtx::WriteAll<true>);
+  env->SetProtoMethod(b, "writeAllSync", BrotliCtx::WriteAll<false>);
+  env->SetProtoMethod(b, "init", BrotliCtx::Init);
+  env->SetProtoMethod(b, "close", BrotliCtx::Close);
+  env->SetProtoMethod(b, "reset", BrotliCtx::Reset);
+
+  b->SetClassName(FIXED_ONE_BYTE_STRING(env->isolate(), "Brotli"));
+  target->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "Brotli"),
+              b->GetFunction());
+#endif  // HAVE_BROTLI
 }
 
 }  // namespace node
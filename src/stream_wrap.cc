@@ -7,6 +7,7 @@
 #include "handle_wrap.h"
 #include "node_buffer.h"
 #include "node_counters.h"
+#include "node_dtrace_probes.h"
 #include "pipe_wrap.h"
 #include "req-wrap.h"
 #include "req-wrap-inl.h"
@@ -228,6 +229,9 @@ void StreamWrap::OnReadCommon(uv_stream_t* handle,
   // uv_close() on the handle.
   CHECK_EQ(wrap->persistent().IsEmpty(), false);
 
+  if (NODE_STREAM_READ_ENABLED())
+    NODE_STREAM_READ(handle, handle->type, static_cast<int64_t>(nread));
+
   if (nread > 0) {
     if (wrap->is_tcp()) {
       NODE_COUNT_NET_BYTES_RECV(nread);
@@ -301,6 +305,15 @@ int StreamWrap::DoTryWrite(uv_buf_t** bufs, size_t* count) {
   if (err < 0)
     return err;
 
+  if (NODE_STREAM_WRITE_ENABLED())
+    NODE_STREAM_WRITE(stream(), stream()->type, static_cast<int64_t>(err));
+
+  if (stream()->type == UV_TCP) {
+    NODE_COUNT_NET_BYTES_SENT(err);
+  } else if (stream()->type == UV_NAMED_PIPE) {
+    NODE_COUNT_PIPE_BYTES_SENT(err);
+  }
+
   // Slice off the buffers: skip all written buffers and slice the one that
   // was partially written.
   written = err;
@@ -340,6 +353,8 @@ int StreamWrap::DoWrite(WriteWrap* w,
     size_t bytes = 0;
     for (size_t i = 0; i < count; i++)
       bytes += bufs[i].len;
+    if (NODE_STREAM_WRITE_ENABLED())
+      NODE_STREAM_WRITE(stream(), stream()->type, static_cast<int64_t>(bytes));
     if (stream()->type == UV_TCP) {
       NODE_COUNT_NET_BYTES_SENT(bytes);
     } else if (stream()->type == UV_NAMED_PIPE) {
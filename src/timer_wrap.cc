@@ -3,6 +3,7 @@
 #include "env.h"
 #include "env-inl.h"
 #include "handle_wrap.h"
+#include "node_dtrace_probes.h"
 #include "util.h"
 #include "util-inl.h"
 
@@ -92,6 +93,8 @@ class TimerWrap : public HandleWrap {
     Environment* env = wrap->env();
     HandleScope handle_scope(env->isolate());
     Context::Scope context_scope(env->context());
+    if (NODE_TIMER_FIRE_ENABLED())
+      NODE_TIMER_FIRE(handle);
     wrap->MakeCallback(kOnTimeout, 0, nullptr);
   }
 
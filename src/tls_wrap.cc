@@ -6,7 +6,6 @@
 #include "node_crypto_bio.h"  // NodeBIO
 #include "node_crypto_clienthello.h"  // ClientHelloParser
 #include "node_crypto_clienthello-inl.h"
-#include "node_counters.h"
 #include "node_internals.h"
 #include "stream_base.h"
 #include "stream_base-inl.h"
@@ -23,11 +22,140 @@ using v8::Exception;
 using v8::Function;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
+using v8::HandleScope;
 using v8::Local;
 using v8::Object;
 using v8::String;
 using v8::Value;
 
+// Server handshakes of one Environment that wait for their share of the
+// event loop, see TLSWrap::kHandshakeBudget.
+class TLSHandshakeQueue {
+ public:
+  explicit TLSHandshakeQueue(Environment* env) : time_(0), deferred_(0) {
+    uv_prepare_init(env->event_loop(), &prepare_handle_);
+    uv_check_init(env->event_loop(), &check_handle_);
+    uv_idle_init(env->event_loop(), &idle_handle_);
+    uv_unref(reinterpret_cast<uv_handle_t*>(&prepare_handle_));
+    uv_unref(reinterpret_cast<uv_handle_t*>(&check_handle_));
+    uv_unref(reinterpret_cast<uv_handle_t*>(&idle_handle_));
+
+    auto close_and_finish = [](Environment* env,
+                               uv_handle_t* handle,
+                               void* arg) {
+      handle->data = env;
+      uv_close(handle, [](uv_handle_t* handle) {
+        static_cast<Environment*>(handle->data)->FinishHandleCleanup(handle);
+      });
+    };
+    env->RegisterHandleCleanup(
+        reinterpret_cast<uv_handle_t*>(&prepare_handle_),
+        close_and_finish,
+        nullptr);
+    env->RegisterHandleCleanup(
+        reinterpret_cast<uv_handle_t*>(&check_handle_),
+        close_and_finish,
+        nullptr);
+    env->RegisterHandleCleanup(
+        reinterpret_cast<uv_handle_t*>(&idle_handle_),
+        close_and_finish,
+        nullptr);
+  }
+
+  static TLSHandshakeQueue* From(Environment* env) {
+    TLSHandshakeQueue* queue = env->tls_handshake_queue();
+    if (queue == nullptr) {
+      queue = new TLSHandshakeQueue(env);
+      env->set_tls_handshake_queue(queue);
+    }
+    return queue;
+  }
+
+  // Runs the next handshake step of |wrap| now if the budget of this loop
+  // iteration allows for it, otherwise from the check phase.
+  void Cycle(TLSWrap* wrap) {
+    // Already waiting for its turn, the new input is picked up then.
+    if (!wrap->handshake_queue_member_.IsEmpty())
+      return;
+
+    if (time_ >= TLSWrap::kHandshakeBudget) {
+      if (queue_.IsEmpty()) {
+        uv_check_start(&check_handle_, OnCheck);
+        uv_idle_start(&idle_handle_, OnIdle);
+      }
+      queue_.PushBack(wrap);
+      deferred_++;
+      return;
+    }
+
+    // The budget starts over before the next poll phase.
+    if (time_ == 0)
+      uv_prepare_start(&prepare_handle_, OnPrepare);
+    const uint64_t start = uv_hrtime();
+    wrap->Cycle();
+    time_ += uv_hrtime() - start;
+  }
+
+  double deferred() const { return deferred_; }
+
+ private:
+  static void OnPrepare(uv_prepare_t* handle) {
+    TLSHandshakeQueue* queue =
+        ContainerOf(&TLSHandshakeQueue::prepare_handle_, handle);
+    queue->time_ = 0;
+    uv_prepare_stop(handle);
+  }
+
+  static void OnCheck(uv_check_t* handle) {
+    TLSHandshakeQueue* queue =
+        ContainerOf(&TLSHandshakeQueue::check_handle_, handle);
+
+    // Whatever the poll phase used up, the queue gets a fresh budget.
+    uint64_t time = 0;
+    while (time < TLSWrap::kHandshakeBudget) {
+      TLSWrap* wrap = queue->queue_.PopFront();
+      if (wrap == nullptr)
+        break;
+
+      Environment* env = wrap->env();
+      HandleScope handle_scope(env->isolate());
+      Context::Scope context_scope(env->context());
+      const uint64_t start = uv_hrtime();
+      wrap->Cycle();
+      time += uv_hrtime() - start;
+    }
+
+    if (queue->queue_.IsEmpty()) {
+      uv_check_stop(&queue->check_handle_);
+      uv_idle_stop(&queue->idle_handle_);
+    }
+  }
+
+  static void OnIdle(uv_idle_t* handle) {
+    // Keeps the event loop from blocking in poll while handshakes are queued.
+  }
+
+  uv_prepare_t prepare_handle_;
+  uv_check_t check_handle_;
+  uv_idle_t idle_handle_;
+  uint64_t time_;
+  double deferred_;
+  ListHead<TLSWrap, &TLSWrap::handshake_queue_member_> queue_;
+};
+
+
+void DeleteTLSHandshakeQueue(TLSHandshakeQueue* queue) {
+  delete queue;
+}
+
+
+// Number of handshake steps that had to wait for the check phase.
+static void GetDeferredHandshakeCount(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  args.GetReturnValue().Set(TLSHandshakeQueue::From(env)->deferred());
+}
+
+
 TLSWrap::TLSWrap(Environment* env,
                  Kind kind,
                  StreamBase* stream,
@@ -44,6 +172,8 @@ TLSWrap::TLSWrap(Environment* env,
       enc_out_(nullptr),
       clear_in_(nullptr),
       write_size_(0),
+      record_bytes_(0),
+      record_time_(0),
       started_(false),
       established_(false),
       shutdown_(false),
@@ -304,12 +434,11 @@ void TLSWrap::EncOut() {
     buf[i] = uv_buf_init(data[i], size[i]);
   int err = stream_->DoWrite(write_req, buf, count, nullptr);
 
-  // Ignore errors, this should be already handled in js
+  // Ignore errors, this should be already handled in js.  The underlying
+  // stream counts the bytes that go out.
   if (err) {
     write_req->Dispose();
     InvokeQueued(err);
-  } else {
-    NODE_COUNT_NET_BYTES_SENT(write_size_);
   }
 }
 
@@ -406,28 +535,58 @@ void TLSWrap::ClearOut() {
 
   crypto::MarkPopErrorOnReturn mark_pop_error_on_return;
 
-  char out[kClearOutChunkSize];
   int read;
   for (;;) {
-    read = SSL_read(ssl_, out, sizeof(out));
+    // The ciphertext that is waiting to be decrypted is an upper bound for
+    // the plaintext in it, use it to size the buffer that SSL_read() decrypts
+    // into.  All complete records that fit are emitted as a single chunk.
+    size_t pending = SSL_pending(ssl_) + BIO_pending(enc_in_);
+
+    if (pending == 0) {
+      // Nothing buffered, but SSL_read() still has to run so that it can
+      // advance the handshake.  Anything it returns is copied out.
+      char out[kClearOutChunkSize];
+      read = SSL_read(ssl_, out, sizeof(out));
+
+      if (read <= 0)
+        break;
+
+      char* current = out;
+      while (read > 0) {
+        int avail = read;
+
+        uv_buf_t buf;
+        OnAlloc(avail, &buf);
+        if (static_cast<int>(buf.len) < avail)
+          avail = buf.len;
+        memcpy(buf.base, current, avail);
+        OnRead(avail, &buf);
+
+        read -= avail;
+        current += avail;
+      }
+      continue;
+    }
 
-    if (read <= 0)
-      break;
+    if (pending > kClearOutMaxChunkSize)
+      pending = kClearOutMaxChunkSize;
 
-    char* current = out;
-    while (read > 0) {
-      int avail = read;
+    uv_buf_t buf;
+    OnAlloc(pending, &buf);
+    size_t filled = 0;
+    do {
+      read = SSL_read(ssl_, buf.base + filled, buf.len - filled);
+      if (read > 0)
+        filled += read;
+    } while (read > 0 && filled < buf.len);
 
-      uv_buf_t buf;
-      OnAlloc(avail, &buf);
-      if (static_cast<int>(buf.len) < avail)
-        avail = buf.len;
-      memcpy(buf.base, current, avail);
-      OnRead(avail, &buf);
+    // A zero-length read hands the buffer back to its owner.
+    OnRead(filled, &buf);
 
-      read -= avail;
-      current += avail;
-    }
+    // Only stop right after a failed SSL_read(), the error is checked below
+    // and the 'data' listeners may have used the connection since then.
+    if (read <= 0 && filled == 0)
+      break;
   }
 
   int flags = SSL_get_shutdown(ssl_);
@@ -469,15 +628,19 @@ bool TLSWrap::ClearIn() {
 
   crypto::MarkPopErrorOnReturn mark_pop_error_on_return;
 
+  const size_t record_size = RecordSize();
   int written = 0;
   while (clear_in_->Length() > 0) {
     size_t avail = 0;
     char* data = clear_in_->Peek(&avail);
+    if (avail > record_size)
+      avail = record_size;
     written = SSL_write(ssl_, data, avail);
     CHECK(written == -1 || written == static_cast<int>(avail));
     if (written == -1)
       break;
     clear_in_->Read(nullptr, avail);
+    record_bytes_ += avail;
   }
 
   // All written
@@ -501,6 +664,18 @@ bool TLSWrap::ClearIn() {
 }
 
 
+size_t TLSWrap::RecordSize() {
+  const uint64_t now = uv_now(env()->event_loop());
+  if (now - record_time_ >= kRecordSizeIdleTimeout)
+    record_bytes_ = 0;
+  record_time_ = now;
+
+  if (record_bytes_ < kRecordSizeBoostThreshold)
+    return kSmallRecordSize;
+  return kLargeRecordSize;
+}
+
+
 void* TLSWrap::Cast() {
   return reinterpret_cast<void*>(this);
 }
@@ -606,23 +781,75 @@ int TLSWrap::DoWrite(WriteWrap* w,
 
   crypto::MarkPopErrorOnReturn mark_pop_error_on_return;
 
+  // Every SSL_write() produces at least one record with its own header and
+  // MAC, so small buffers are gathered into record-sized plaintext first.
+  // Otherwise e.g. the headers, chunk size line, body and trailing CRLF of a
+  // chunked HTTP response would end up in four records instead of one.
+  // Buffers that span whole records are encrypted in place.
+  const size_t record_size = RecordSize();
+  char coalesced[kLargeRecordSize];
+  size_t coalesced_len = 0;
+  size_t offset = 0;
   int written = 0;
-  for (i = 0; i < count; i++) {
-    written = SSL_write(ssl_, bufs[i].base, bufs[i].len);
-    CHECK(written == -1 || written == static_cast<int>(bufs[i].len));
-    if (written == -1)
-      break;
+  i = 0;
+  while (i < count) {
+    if (offset == bufs[i].len) {
+      i++;
+      offset = 0;
+      continue;
+    }
+
+    const char* data = bufs[i].base + offset;
+    size_t len = bufs[i].len - offset;
+
+    if (coalesced_len == 0 && len >= record_size) {
+      written = SSL_write(ssl_, data, record_size);
+      CHECK(written == -1 || written == static_cast<int>(record_size));
+      if (written == -1)
+        break;
+      offset += record_size;
+      record_bytes_ += record_size;
+      continue;
+    }
+
+    if (len > record_size - coalesced_len)
+      len = record_size - coalesced_len;
+    memcpy(coalesced + coalesced_len, data, len);
+    coalesced_len += len;
+    offset += len;
+
+    if (coalesced_len == record_size) {
+      written = SSL_write(ssl_, coalesced, coalesced_len);
+      CHECK(written == -1 || written == static_cast<int>(coalesced_len));
+      if (written == -1)
+        break;
+      record_bytes_ += coalesced_len;
+      coalesced_len = 0;
+    }
   }
 
-  if (i != count) {
+  if (written != -1 && coalesced_len > 0) {
+    written = SSL_write(ssl_, coalesced, coalesced_len);
+    CHECK(written == -1 || written == static_cast<int>(coalesced_len));
+    if (written != -1)
+      record_bytes_ += coalesced_len;
+  }
+
+  if (written == -1) {
     int err;
     Local<Value> arg = GetSSLError(written, &err, &error_);
     if (!arg.IsEmpty())
       return UV_EPROTO;
 
-    // No errors, queue rest
-    for (; i < count; i++)
-      clear_in_->Write(bufs[i].base, bufs[i].len);
+    // No errors, queue rest, starting with what was gathered for the record
+    // that could not be written.
+    if (coalesced_len > 0)
+      clear_in_->Write(coalesced, coalesced_len);
+    if (i < count) {
+      clear_in_->Write(bufs[i].base + offset, bufs[i].len - offset);
+      for (i++; i < count; i++)
+        clear_in_->Write(bufs[i].base, bufs[i].len);
+    }
   }
 
   // Try writing data immediately
@@ -671,9 +898,24 @@ void TLSWrap::OnReadSelf(ssize_t nread,
                          uv_handle_type pending,
                          void* ctx) {
   TLSWrap* wrap = static_cast<TLSWrap*>(ctx);
+
+  if (nread == 0) {
+    if (buf != nullptr)
+      free(buf->base);
+    return;
+  }
+
   Local<Object> buf_obj;
-  if (buf != nullptr)
-    buf_obj = Buffer::New(wrap->env(), buf->base, buf->len).ToLocalChecked();
+  if (buf != nullptr) {
+    char* base = buf->base;
+    size_t len = buf->len;
+    // ClearOut() may have allocated more than the records it decrypted.
+    if (nread > 0 && static_cast<size_t>(nread) < len) {
+      base = node::Realloc(base, nread);
+      len = nread;
+    }
+    buf_obj = Buffer::New(wrap->env(), base, len).ToLocalChecked();
+  }
   wrap->EmitData(nread, buf_obj, Local<Object>());
 }
 
@@ -715,7 +957,15 @@ void TLSWrap::DoRead(ssize_t nread,
   }
 
   // Cycle OpenSSL's state
-  Cycle();
+  if (is_server() && !established_)
+    CycleHandshake();
+  else
+    Cycle();
+}
+
+
+void TLSWrap::CycleHandshake() {
+  TLSHandshakeQueue::From(env())->Cycle(this);
 }
 
 
@@ -799,6 +1049,24 @@ void TLSWrap::DestroySSL(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+// Bytes of buffer memory held by the connection's BIOs. Doesn't include
+// OpenSSL's own per-connection state.
+void TLSWrap::GetMemoryUsage(const FunctionCallbackInfo<Value>& args) {
+  TLSWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+
+  size_t total = 0;
+  if (wrap->ssl_ != nullptr) {
+    total += NodeBIO::FromBIO(wrap->enc_in_)->MemoryUsage();
+    total += NodeBIO::FromBIO(wrap->enc_out_)->MemoryUsage();
+  }
+  if (wrap->clear_in_ != nullptr)
+    total += wrap->clear_in_->MemoryUsage();
+
+  args.GetReturnValue().Set(static_cast<double>(total));
+}
+
+
 void TLSWrap::EnableCertCb(const FunctionCallbackInfo<Value>& args) {
   TLSWrap* wrap;
   ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
@@ -898,6 +1166,10 @@ void TLSWrap::Initialize(Local<Object> target,
 
   env->SetMethod(target, "wrap", TLSWrap::Wrap);
 
+  env->SetMethod(target,
+                 "getDeferredHandshakeCount",
+                 GetDeferredHandshakeCount);
+
   auto constructor = [](const FunctionCallbackInfo<Value>& args) {
     args.This()->SetAlignedPointerInInternalField(0, nullptr);
   };
@@ -911,6 +1183,7 @@ void TLSWrap::Initialize(Local<Object> target,
   env->SetProtoMethod(t, "enableSessionCallbacks", EnableSessionCallbacks);
   env->SetProtoMethod(t, "destroySSL", DestroySSL);
   env->SetProtoMethod(t, "enableCertCb", EnableCertCb);
+  env->SetProtoMethod(t, "getMemoryUsage", GetMemoryUsage);
 
   StreamBase::AddMethods<TLSWrap>(env, t, StreamBase::kFlagHasWritev);
   SSLWrap<TLSWrap>::AddMethods(env, t);
@@ -55,8 +55,13 @@ class TLSWrap : public AsyncWrap,
   size_t self_size() const override { return sizeof(*this); }
 
  protected:
+  friend class TLSHandshakeQueue;
+
   static const int kClearOutChunkSize = 16384;
 
+  // Upper bound on the plaintext that ClearOut() emits as a single chunk.
+  static const size_t kClearOutMaxChunkSize = 64 * 1024;
+
   // Maximum number of bytes for hello parser
   static const int kMaxHelloLength = 16384;
 
@@ -66,6 +71,22 @@ class TLSWrap : public AsyncWrap,
   // Maximum number of buffers passed to uv_write()
   static const int kSimultaneousBufferCount = 10;
 
+  // Plaintext bytes per TLS record.  A connection starts out with records
+  // that fit in a single TCP segment, so the peer can decrypt the first bytes
+  // of a response without waiting for more segments, and moves on to full
+  // records once it is streaming.  Going idle drops it back to small records.
+  static const size_t kSmallRecordSize = 1300;
+  static const size_t kLargeRecordSize = 16384;
+  static const size_t kRecordSizeBoostThreshold = 1024 * 1024;
+  static const uint64_t kRecordSizeIdleTimeout = 1000;  // Milliseconds.
+
+  // Time in nanoseconds that server handshakes may take up per iteration of
+  // the event loop.  The private key operations in a handshake take a
+  // millisecond or more each; once the budget is spent, handshakes that have
+  // more input are finished from a check handle so established connections
+  // get to run in between.
+  static const uint64_t kHandshakeBudget = 1000 * 1000;
+
   // Write callback queue's item
   class WriteItem {
    public:
@@ -90,6 +111,8 @@ class TLSWrap : public AsyncWrap,
   static void EncOutCb(WriteWrap* req_wrap, int status);
   bool ClearIn();
   void ClearOut();
+  size_t RecordSize();
+  void CycleHandshake();
   void MakePending();
   bool InvokeQueued(int status, const char* error_str = nullptr);
 
@@ -137,6 +160,7 @@ class TLSWrap : public AsyncWrap,
   static void EnableCertCb(
       const v8::FunctionCallbackInfo<v8::Value>& args);
   static void DestroySSL(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetMemoryUsage(const v8::FunctionCallbackInfo<v8::Value>& args);
 
 #ifdef SSL_CTRL_SET_TLSEXT_SERVERNAME_CB
   static void GetServername(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -150,9 +174,12 @@ class TLSWrap : public AsyncWrap,
   BIO* enc_out_;
   NodeBIO* clear_in_;
   size_t write_size_;
+  size_t record_bytes_;
+  uint64_t record_time_;
   typedef ListHead<WriteItem, &WriteItem::member_> WriteItemList;
   WriteItemList write_item_queue_;
   WriteItemList pending_write_items_;
+  ListNode<TLSWrap> handshake_queue_member_;
   bool started_;
   bool established_;
   bool shutdown_;
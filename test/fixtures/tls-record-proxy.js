@@ -0,0 +1,25 @@
+'use strict';
+const net = require('net');
+
+// Returns a TCP proxy in front of the TLS server on `port`. The records that
+// the server sends are passed on unchanged and reported to
+// `onrecord(type, length)` as they go by, `length` being the length of the
+// record body as it appears on the wire.
+module.exports = function createRecordProxy(port, onrecord) {
+  return net.createServer((client) => {
+    const upstream = net.connect(port);
+    let pending = Buffer.alloc(0);
+    client.pipe(upstream);
+    upstream.on('data', (data) => {
+      pending = Buffer.concat([pending, data]);
+      while (pending.length >= 5 &&
+             pending.length >= 5 + pending.readUInt16BE(3)) {
+        const length = pending.readUInt16BE(3);
+        onrecord(pending[0], length);
+        pending = pending.slice(5 + length);
+      }
+      client.write(data);
+    });
+    upstream.on('end', () => client.end());
+  });
+};
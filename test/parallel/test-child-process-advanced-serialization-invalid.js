@@ -0,0 +1,74 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const spawn = require('child_process').spawn;
+
+// Malformed messages on an 'advanced' channel are rejected with an error
+// and the channel is closed, nothing past the end of a message is read.
+
+if (process.argv[2] === 'child') {
+  process.on('message', common.fail);
+  process.on('error', common.mustCall((err) => {
+    assert(/^Invalid IPC message: /.test(err.message));
+    assert.strictEqual(process.connected, false);
+    console.log(err.message);
+  }));
+  return;
+}
+
+function frame(bytes) {
+  const header = Buffer.alloc(4);
+  header.writeUInt32BE(bytes.length, 0);
+  return Buffer.concat([header, Buffer.from(bytes)]);
+}
+
+function run(mode, data, cb) {
+  const env = Object.assign({}, process.env, {
+    NODE_CHANNEL_FD: '3',
+    NODE_CHANNEL_SERIALIZATION_MODE: mode
+  });
+  const child = spawn(process.execPath, [__filename, 'child'], {
+    env: env,
+    stdio: ['ignore', 'pipe', 'pipe', 'pipe']
+  });
+  let stdout = '';
+  let stderr = '';
+  child.stdout.setEncoding('utf8');
+  child.stdout.on('data', (chunk) => stdout += chunk);
+  child.stderr.setEncoding('utf8');
+  child.stderr.on('data', (chunk) => stderr += chunk);
+  child.on('close', common.mustCall((code) => cb(code, stdout, stderr)));
+  // The child hangs up on us, don't trip over that.
+  child.stdio[3].on('error', () => {});
+  child.stdio[3].write(data);
+}
+
+const cases = [
+  // An array that claims more elements than the message holds.
+  [[7, 0xff, 0xff, 0xff, 0xff], 'unexpected end of message'],
+  // A string that runs past the end of the message.
+  [[6, 0x10, 0, 0, 0, 0x61], 'unexpected end of message'],
+  // A number that is cut short.
+  [[5, 0, 0, 0], 'unexpected end of message'],
+  // A reference to an object that was never sent.
+  [[16, 0, 0, 0, 0], 'unknown reference'],
+  // A Float64Array whose length isn't a multiple of 8.
+  [[15, 8, 3, 0, 0, 0, 1, 2, 3], 'misaligned view'],
+  [[0, 0], 'trailing data'],
+  [[99], 'unknown tag 99']
+];
+
+cases.forEach((c) => {
+  run('advanced', frame(c[0]), (code, stdout, stderr) => {
+    assert.strictEqual(stderr, '');
+    assert.strictEqual(code, 0);
+    assert.strictEqual(stdout, `Invalid IPC message: ${c[1]}\n`);
+  });
+});
+
+// Unknown modes are refused before anything is read from the channel.
+run('xml', '', (code, stdout, stderr) => {
+  const expected = /^TypeError: Invalid NODE_CHANNEL_SERIALIZATION_MODE: xml$/m;
+  assert.strictEqual(code, 1);
+  assert(expected.test(stderr));
+});
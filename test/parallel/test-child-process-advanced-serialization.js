@@ -0,0 +1,88 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const child_process = require('child_process');
+
+if (process.argv[2] === 'child') {
+  // Echo every message back so the parent can compare it with the original.
+  process.on('message', (msg) => process.send(msg));
+  return;
+}
+
+assert.throws(() => {
+  child_process.fork(__filename, ['child'], { serialization: 'xml' });
+}, /^TypeError: "serialization" must be "json" or "advanced"$/);
+
+const circular = { name: 'circular' };
+circular.self = circular;
+
+// An own '__proto__' key must not turn into the prototype of the copy.
+const proto = JSON.parse('{"__proto__":{"isAdmin":true},"a":1}');
+
+const big = Buffer.alloc(1024 * 1024);
+for (let i = 0; i < big.length; i++)
+  big[i] = i % 251;
+
+const messages = [
+  'a string with unicode: é中😀',
+  42,
+  -0.5,
+  NaN,
+  null,
+  true,
+  [1, [2, 3], { four: 4 }],
+  { cmd: 'not internal', nested: { array: [] } },
+  Buffer.from('binary \u0000 data'),
+  new Uint16Array([1, 2, 65535]),
+  new Float64Array([Math.PI, -Infinity]),
+  new Uint8Array([1, 2, 3, 4]).subarray(1, 3),
+  new Map([[1, 'one'], ['two', { n: 2 }]]),
+  new Set(['a', 'b', 3]),
+  new Date(1234567890123),
+  /x+y/gi,
+  circular,
+  proto,
+  big
+];
+
+const child = child_process.fork(__filename, ['child'], {
+  serialization: 'advanced'
+});
+
+assert.throws(() => child.send({ fn: () => {} }),
+              /^TypeError: function could not be cloned$/);
+
+let received = 0;
+child.on('message', common.mustCall((msg) => {
+  const expected = messages[received++];
+  if (expected === circular) {
+    assert.strictEqual(msg.name, 'circular');
+    assert.strictEqual(msg.self, msg);
+  } else if (expected === proto) {
+    assert.strictEqual(Object.getPrototypeOf(msg), Object.prototype);
+    assert.deepStrictEqual(Object.keys(msg), ['__proto__', 'a']);
+    assert.deepStrictEqual(
+        Object.getOwnPropertyDescriptor(msg, '__proto__').value,
+        { isAdmin: true });
+    assert.strictEqual(msg.isAdmin, undefined);
+    assert.strictEqual(msg.a, 1);
+  } else if (typeof expected === 'number' && isNaN(expected)) {
+    assert(Number.isNaN(msg));
+  } else {
+    if (typeof expected === 'object' && expected !== null)
+      assert.strictEqual(msg.constructor, expected.constructor);
+    if (expected instanceof Map || expected instanceof Set)
+      assert.deepStrictEqual(Array.from(msg), Array.from(expected));
+    else
+      assert.deepStrictEqual(msg, expected);
+  }
+  if (received === messages.length)
+    child.disconnect();
+}, messages.length));
+
+for (const msg of messages)
+  child.send(msg);
+
+child.on('exit', common.mustCall((code) => {
+  assert.strictEqual(code, 0);
+}));
@@ -0,0 +1,59 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const spawnSync = require('child_process').spawnSync;
+
+if (common.isWindows) {
+  common.skip('PATH lookup on Windows is handled by libuv differently');
+  return;
+}
+
+// uv_spawn() creates children with posix_spawn() where it can. Make sure
+// the lookup of the executable still behaves like execvp() in the child.
+common.refreshTmpDir();
+
+const bin = path.join(common.tmpDir, 'bin');
+fs.mkdirSync(bin);
+
+// A script without a shebang line is run with /bin/sh by execvp().
+const script = path.join(bin, 'hello-no-shebang');
+fs.writeFileSync(script, 'echo "hello $1"\n');
+fs.chmodSync(script, 0o755);
+
+const noexec = path.join(bin, 'not-executable');
+fs.writeFileSync(noexec, 'echo oops\n');
+fs.chmodSync(noexec, 0o644);
+
+// The PATH of the child's environment is searched, not the parent's.
+let child = spawnSync('hello-no-shebang', ['world'], {
+  env: { PATH: `/nonexistent:${bin}` },
+  encoding: 'utf8'
+});
+assert.ifError(child.error);
+assert.strictEqual(child.status, 0);
+assert.strictEqual(child.stdout, 'hello world\n');
+
+child = spawnSync('hello-no-shebang', [], { encoding: 'utf8' });
+assert.strictEqual(child.error.code, 'ENOENT');
+
+child = spawnSync('not-executable', [], { env: { PATH: bin } });
+assert.strictEqual(child.error.code, 'EACCES');
+
+// A relative path is resolved against the child's working directory.
+child = spawnSync('./bin/hello-no-shebang', ['cwd'], {
+  cwd: common.tmpDir,
+  encoding: 'utf8'
+});
+assert.ifError(child.error);
+assert.strictEqual(child.stdout, 'hello cwd\n');
+
+// An empty PATH element means the current directory.
+child = spawnSync('hello-no-shebang', ['dot'], {
+  cwd: bin,
+  env: { PATH: '/nonexistent:' },
+  encoding: 'utf8'
+});
+assert.ifError(child.error);
+assert.strictEqual(child.stdout, 'hello dot\n');
@@ -0,0 +1,126 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+
+if (!common.hasCrypto) {
+  common.skip('missing crypto');
+  return;
+}
+const crypto = require('crypto');
+
+const fs = require('fs');
+const join = require('path').join;
+
+function load(name) {
+  return fs.readFileSync(join(common.fixturesDir, name), 'ascii');
+}
+
+const rsaPubPem = load('test_rsa_pubkey.pem');
+const rsaKeyPem = load('test_rsa_privkey.pem');
+const rsaKeyPemEncrypted = load('test_rsa_privkey_encrypted.pem');
+const dsaPubPem = load('test_dsa_pubkey.pem');
+const dsaKeyPem = load('test_dsa_privkey.pem');
+const certPem = load('test_cert.pem');
+const keyPem = load('test_key.pem');
+
+const input = 'I AM THE WALRUS';
+
+// Asynchronous signatures are the same as synchronous ones and verify both
+// ways.
+[
+  { key: rsaKeyPem, pub: rsaPubPem, algorithm: 'RSA-SHA256' },
+  { key: { key: rsaKeyPemEncrypted, passphrase: 'password' },
+    pub: rsaPubPem, algorithm: 'RSA-SHA1' },
+  { key: keyPem, pub: certPem, algorithm: 'RSA-SHA512' }
+].forEach((test) => {
+  const expected = crypto.createSign(test.algorithm)
+    .update(input).sign(test.key, 'hex');
+
+  const sign = crypto.createSign(test.algorithm);
+  sign.update(input);
+  assert.strictEqual(sign.sign(test.key, 'hex', common.mustCall((err, sig) => {
+    assert.ifError(err);
+    assert.strictEqual(sig, expected);
+
+    assert.strictEqual(crypto.createVerify(test.algorithm)
+      .update(input).verify(test.pub, sig, 'hex'), true);
+
+    crypto.createVerify(test.algorithm).update(input)
+      .verify(test.pub, sig, 'hex', common.mustCall((err, result) => {
+        assert.ifError(err);
+        assert.strictEqual(result, true);
+      }));
+    crypto.createVerify(test.algorithm).update('something else')
+      .verify(test.pub, sig, 'hex', common.mustCall((err, result) => {
+        assert.ifError(err);
+        assert.strictEqual(result, false);
+      }));
+  })), undefined);
+
+  // The object can not be used until the signature is done.
+  assert.throws(() => sign.update(input), /^Error: Operation in progress$/);
+  assert.throws(() => sign.sign(test.key), /^Error: Operation in progress$/);
+});
+
+// DSA signatures are not deterministic.
+crypto.createSign('DSS1').update(input)
+  .sign(dsaKeyPem, common.mustCall((err, sig) => {
+    assert.ifError(err);
+    assert(Buffer.isBuffer(sig));
+    crypto.createVerify('DSS1').update(input)
+      .verify(dsaPubPem, sig, common.mustCall((err, result) => {
+        assert.ifError(err);
+        assert.strictEqual(result, true);
+      }));
+  }));
+
+// Errors are passed to the callback.
+crypto.createSign('RSA-SHA256').update(input)
+  .sign({ key: rsaKeyPemEncrypted, passphrase: 'wrong' },
+        common.mustCall((err, sig) => {
+          assert(/bad decrypt/.test(err.message));
+          assert.strictEqual(sig, undefined);
+        }));
+crypto.createVerify('RSA-SHA256').update(input)
+  .verify('not a key', Buffer.alloc(128), common.mustCall((err, result) => {
+    assert(err instanceof Error);
+    assert.strictEqual(result, undefined);
+  }));
+
+assert.throws(() => crypto.createSign('RSA-SHA256').sign(rsaKeyPem, 'hex', {}),
+              /^TypeError: "callback" argument must be a function$/);
+
+// Public key encryption.
+{
+  const plaintext = Buffer.from(input);
+
+  crypto.publicEncrypt(rsaPubPem, plaintext, common.mustCall((err, enc) => {
+    assert.ifError(err);
+    assert.deepStrictEqual(crypto.privateDecrypt(rsaKeyPem, enc), plaintext);
+
+    crypto.privateDecrypt({ key: rsaKeyPemEncrypted, passphrase: 'password' },
+                          enc, common.mustCall((err, dec) => {
+                            assert.ifError(err);
+                            assert.deepStrictEqual(dec, plaintext);
+                          }));
+  }));
+
+  crypto.privateEncrypt(rsaKeyPem, plaintext, common.mustCall((err, enc) => {
+    assert.ifError(err);
+    // PKCS#1 v1.5 padding for signatures is deterministic.
+    assert.deepStrictEqual(enc, crypto.privateEncrypt(rsaKeyPem, plaintext));
+
+    crypto.publicDecrypt(rsaPubPem, enc, common.mustCall((err, dec) => {
+      assert.ifError(err);
+      assert.deepStrictEqual(dec, plaintext);
+    }));
+  }));
+
+  crypto.privateDecrypt(rsaKeyPem, plaintext, common.mustCall((err, dec) => {
+    assert(err instanceof Error);
+    assert.strictEqual(dec, undefined);
+  }));
+
+  assert.throws(() => crypto.publicEncrypt(rsaPubPem, plaintext, 'callback'),
+                /^TypeError: "callback" argument must be a function$/);
+}
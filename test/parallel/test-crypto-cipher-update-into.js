@@ -0,0 +1,100 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+
+if (!common.hasCrypto) {
+  common.skip('missing crypto');
+  return;
+}
+const crypto = require('crypto');
+
+const key = Buffer.alloc(32, 'k');
+const iv = Buffer.alloc(16, 'i');
+const plaintext = Buffer.alloc(1000, 'plain text, ');
+
+function encrypt(algorithm, keylen, ivlen, input) {
+  const cipher = crypto.createCipheriv(algorithm, key.slice(0, keylen),
+                                       iv.slice(0, ivlen));
+  return Buffer.concat([cipher.update(input), cipher.final()]);
+}
+
+// Writes |input| through |cipher| in chunks of |chunk| bytes, using
+// |output| at |offset| for the result.
+function updateInto(cipher, input, chunk, output, offset) {
+  let written = 0;
+  for (let i = 0; i < input.length; i += chunk) {
+    written += cipher.updateInto(input.slice(i, i + chunk), output,
+                                 offset + written);
+  }
+  written += cipher.final(output, offset + written);
+  return written;
+}
+
+[
+  ['aes-128-cbc', 16, 16],
+  ['aes-256-ctr', 32, 16],
+  ['aes-256-gcm', 32, 12]
+].forEach(([algorithm, keylen, ivlen]) => {
+  const expected = encrypt(algorithm, keylen, ivlen, plaintext);
+  const output = Buffer.alloc(plaintext.length + 64);
+
+  [1000, 100, 7].forEach((chunk) => {
+    output.fill(0);
+    const cipher = crypto.createCipheriv(algorithm, key.slice(0, keylen),
+                                         iv.slice(0, ivlen));
+    const written = updateInto(cipher, plaintext, chunk, output, 3);
+    assert.strictEqual(written, expected.length);
+    assert.deepStrictEqual(output.slice(3, 3 + written), expected);
+    assert.strictEqual(output[2], 0);
+    assert.strictEqual(output[3 + written], 0);
+
+    const decipher = crypto.createDecipheriv(algorithm,
+                                             key.slice(0, keylen),
+                                             iv.slice(0, ivlen));
+    if (algorithm.endsWith('gcm'))
+      decipher.setAuthTag(cipher.getAuthTag());
+    const decrypted = Buffer.alloc(expected.length + 16);
+    const n = updateInto(decipher, expected, chunk, decrypted, 0);
+    assert.deepStrictEqual(decrypted.slice(0, n), plaintext);
+  });
+
+  // In place, also for block ciphers that buffer between calls.
+  const data = Buffer.alloc(plaintext.length + 16);
+  plaintext.copy(data);
+  const cipher = crypto.createCipheriv(algorithm, key.slice(0, keylen),
+                                       iv.slice(0, ivlen));
+  let written = cipher.updateInto(data.slice(0, 10), data);
+  written += cipher.updateInto(data.slice(10, plaintext.length), data, written);
+  written += cipher.final(data, written);
+  assert.deepStrictEqual(data.slice(0, written), expected);
+});
+
+// Stream modes write exactly as much as they are given.
+{
+  const cipher = crypto.createCipheriv('aes-256-gcm', key, iv.slice(0, 12));
+  const data = Buffer.from(plaintext);
+  assert.strictEqual(cipher.updateInto(data, data), data.length);
+  assert.strictEqual(cipher.final(Buffer.alloc(0)), 0);
+}
+
+// Bounds.
+{
+  const cipher = crypto.createCipheriv('aes-128-cbc', key.slice(0, 16), iv);
+  assert.throws(() => cipher.updateInto(plaintext, Buffer.alloc(1000)),
+                /^RangeError: Output buffer is too small$/);
+  assert.throws(() => cipher.updateInto(plaintext, Buffer.alloc(2000), 1001),
+                /^RangeError: Output buffer is too small$/);
+  assert.throws(() => cipher.updateInto(plaintext, Buffer.alloc(2000), 2001),
+                /^RangeError: "offset" is out of bounds$/);
+  assert.throws(() => cipher.updateInto(plaintext, Buffer.alloc(2000), -1),
+                /^RangeError: "offset" is out of bounds$/);
+  assert.throws(() => cipher.updateInto(plaintext, 'output'),
+                /^TypeError: Output must be a buffer$/);
+  assert.throws(() => cipher.updateInto('data', Buffer.alloc(16)),
+                /^TypeError: Cipher data must be a buffer$/);
+  assert.throws(() => cipher.final(Buffer.alloc(15)),
+                /^RangeError: Output buffer is too small$/);
+  assert.strictEqual(cipher.final(Buffer.alloc(16)), 16);
+  assert.throws(() => cipher.final(Buffer.alloc(16)),
+                /^Error: Unsupported state$/);
+}
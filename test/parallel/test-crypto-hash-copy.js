@@ -0,0 +1,78 @@
+'use strict';
+const common = require('../common');
+
+if (!common.hasCrypto) {
+  common.skip('missing crypto');
+  return;
+}
+const assert = require('assert');
+const crypto = require('crypto');
+
+function sha256(data) {
+  return crypto.createHash('sha256').update(data).digest('hex');
+}
+
+function hmac(data) {
+  return crypto.createHmac('sha1', 'key').update(data).digest('hex');
+}
+
+// Copies continue from the state of the original, independently of it.
+{
+  const prefix = crypto.createHash('sha256').update('prefix-');
+  const a = prefix.copy().update('a');
+  const b = prefix.copy();
+  assert.strictEqual(b.update('b').digest('hex'), sha256('prefix-b'));
+  assert.strictEqual(a.digest('hex'), sha256('prefix-a'));
+  assert.strictEqual(prefix.digest('hex'), sha256('prefix-'));
+  assert.throws(() => prefix.copy(), /^Error: Digest already called$/);
+
+  // Copies are streams too.
+  const stream = crypto.createHash('md5').update('x').copy();
+  stream.on('data', common.mustCall((digest) => {
+    assert.strictEqual(digest.toString('hex'),
+                       crypto.createHash('md5').update('xy').digest('hex'));
+  }));
+  stream.end('y');
+}
+
+{
+  const prefix = crypto.createHmac('sha1', 'key').update('prefix-');
+  assert.strictEqual(prefix.copy().update('a').digest('hex'),
+                     hmac('prefix-a'));
+  assert.strictEqual(prefix.digest('hex'), hmac('prefix-'));
+  assert.throws(() => prefix.copy(), /^Error: Not initialized$/);
+}
+
+// With reset, digest() leaves the object ready for the next message.
+{
+  const hash = crypto.createHash('sha256');
+  const mac = crypto.createHmac('sha1', 'key');
+  ['', 'a', 'bc', 'a'.repeat(1000)].forEach((message) => {
+    assert.strictEqual(hash.update(message).digest('hex', { reset: true }),
+                       sha256(message));
+    assert.deepStrictEqual(mac.update(message).digest({ reset: true }),
+                           Buffer.from(hmac(message), 'hex'));
+  });
+  assert.strictEqual(hash.update('x').digest('hex'), sha256('x'));
+  assert.throws(() => hash.digest(), /^Error: Digest already called$/);
+  assert.strictEqual(mac.update('x').digest('hex', { reset: false }),
+                     hmac('x'));
+  assert.strictEqual(mac.digest('hex'), '');
+}
+
+// Nothing can be copied while an update is running on the threadpool.
+{
+  const hash = crypto.createHash('sha256');
+  hash.update(Buffer.alloc(1024), common.mustCall((err) => {
+    assert.ifError(err);
+    assert.strictEqual(hash.copy().digest('hex'),
+                       sha256(Buffer.alloc(1024)));
+  }));
+  assert.throws(() => hash.copy(), /^Error: Update in progress$/);
+}
+
+// Copying doesn't change what the constructors accept.
+[{}, [], new Date(), 1].forEach((arg) => {
+  assert.throws(() => crypto.createHash(arg),
+                /^Error: Must give hashtype string as argument$/);
+});
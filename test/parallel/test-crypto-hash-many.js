@@ -0,0 +1,84 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+
+if (!common.hasCrypto) {
+  common.skip('missing crypto');
+  return;
+}
+const crypto = require('crypto');
+
+function digest(message, encoding) {
+  return crypto.createHash('sha256').update(message).digest(encoding);
+}
+
+function hmac(message, encoding) {
+  return crypto.createHmac('sha1', 'key').update(message).digest(encoding);
+}
+
+// Enough messages to be split between several jobs on the threadpool.
+const messages = [];
+for (let i = 0; i < 1000; i++)
+  messages.push(Buffer.from(`message ${i}`.repeat(i % 7)));
+
+const packed = Buffer.concat(messages);
+const offsets = [0];
+messages.forEach((message) => {
+  offsets.push(offsets[offsets.length - 1] + message.length);
+});
+
+const expected = Buffer.concat(messages.map((message) => digest(message)));
+const expectedHex = messages.map((message) => digest(message, 'hex'));
+const expectedHmac = Buffer.concat(messages.map((message) => hmac(message)));
+
+// Arrays of buffers and strings.
+assert.deepStrictEqual(crypto.hashMany('sha256', messages), expected);
+assert.deepStrictEqual(crypto.hashMany('sha256', messages, 'hex'),
+                       expectedHex);
+assert.deepStrictEqual(crypto.hashMany('sha256', ['a', '€']),
+                       Buffer.concat([digest('a'), digest('€')]));
+assert.deepStrictEqual(crypto.hashMany('sha256', []), Buffer.alloc(0));
+assert.deepStrictEqual(crypto.hmacMany('sha1', 'key', messages),
+                       expectedHmac);
+
+// One buffer with offsets.
+assert.deepStrictEqual(crypto.hashMany('sha256', packed, offsets), expected);
+assert.deepStrictEqual(
+    crypto.hashMany('sha256', packed, Uint32Array.from(offsets), 'hex'),
+    expectedHex);
+assert.deepStrictEqual(crypto.hmacMany('sha1', 'key', packed, offsets),
+                       expectedHmac);
+assert.deepStrictEqual(crypto.hashMany('md5', packed, [3]), Buffer.alloc(0));
+
+// Asynchronous.
+crypto.hashMany('sha256', messages, common.mustCall((err, result) => {
+  assert.ifError(err);
+  assert.deepStrictEqual(result, expected);
+}));
+crypto.hashMany('sha256', messages.map(String), 'hex',
+                common.mustCall((err, result) => {
+                  assert.ifError(err);
+                  assert.deepStrictEqual(result, expectedHex);
+                }));
+crypto.hashMany('sha256', packed, offsets, common.mustCall((err, result) => {
+  assert.ifError(err);
+  assert.deepStrictEqual(result, expected);
+}));
+crypto.hmacMany('sha1', 'key', packed, offsets, 'buffer',
+                common.mustCall((err, result) => {
+                  assert.ifError(err);
+                  assert.deepStrictEqual(result, expectedHmac);
+                }));
+
+// Errors.
+assert.throws(() => crypto.hashMany('sha256', packed),
+              /^TypeError: "offsets" argument must be an array$/);
+assert.throws(() => crypto.hashMany('sha256', packed, [0, 8, 4]),
+              /^RangeError: Offsets must be ascending and within the buffer$/);
+assert.throws(() => crypto.hashMany('sha256', packed, [0, packed.length + 1]),
+              /^RangeError: Offsets must be ascending and within the buffer$/);
+assert.throws(() => crypto.hashMany('sha256', messages, 'hex', 'callback'),
+              /^TypeError: "callback" argument must be a function$/);
+assert.throws(() => crypto.hashMany('nope', messages),
+              /Digest method not supported/);
+assert.throws(() => crypto.hashMany('sha256', [1]), TypeError);
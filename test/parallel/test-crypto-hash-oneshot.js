@@ -0,0 +1,88 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+
+if (!common.hasCrypto) {
+  common.skip('missing crypto');
+  return;
+}
+const crypto = require('crypto');
+
+const data = Buffer.alloc(1024 * 1024, 'node');
+const text = 'some data to hash ü';
+
+function expected(algorithm, input, encoding) {
+  return crypto.createHash(algorithm).update(input).digest(encoding);
+}
+
+function expectedHmac(algorithm, key, input, encoding) {
+  return crypto.createHmac(algorithm, key).update(input).digest(encoding);
+}
+
+// Synchronous one-shot hashing.
+['md5', 'sha1', 'sha256', 'sha512'].forEach((algorithm) => {
+  assert.deepStrictEqual(crypto.hash(algorithm, data),
+                         expected(algorithm, data));
+  assert.strictEqual(crypto.hash(algorithm, text, 'hex'),
+                     expected(algorithm, text, 'hex'));
+  assert.strictEqual(crypto.hmac(algorithm, 'key', text, 'base64'),
+                     expectedHmac(algorithm, 'key', text, 'base64'));
+  assert.strictEqual(crypto.hmac(algorithm, '', data, 'hex'),
+                     expectedHmac(algorithm, '', data, 'hex'));
+});
+
+assert.throws(() => crypto.hash('no-such-digest', data),
+              /^Error: Digest method not supported$/);
+assert.throws(() => crypto.hash('sha256', 42),
+              /^TypeError: Data must be a string or a buffer$/);
+assert.throws(() => crypto.hash('sha256', data, 'hex', 'callback'),
+              /^TypeError: "callback" argument must be a function$/);
+
+// Asynchronous one-shot hashing.
+crypto.hash('sha256', data, 'hex', common.mustCall((err, digest) => {
+  assert.ifError(err);
+  assert.strictEqual(digest, expected('sha256', data, 'hex'));
+}));
+crypto.hash('md5', text, common.mustCall((err, digest) => {
+  assert.ifError(err);
+  assert.deepStrictEqual(digest, expected('md5', text));
+}));
+crypto.hmac('sha1', 'key', data, 'hex', common.mustCall((err, digest) => {
+  assert.ifError(err);
+  assert.strictEqual(digest, expectedHmac('sha1', 'key', data, 'hex'));
+}));
+crypto.hmac('sha1', '', text, 'hex', common.mustCall((err, digest) => {
+  assert.ifError(err);
+  assert.strictEqual(digest, expectedHmac('sha1', '', text, 'hex'));
+}));
+
+// Asynchronous updates mix with synchronous ones.
+{
+  const hash = crypto.createHash('sha256');
+  hash.update(text);
+  assert.strictEqual(hash.update(data, common.mustCall((err) => {
+    assert.ifError(err);
+    hash.update(text, 'latin1', common.mustCall((err) => {
+      assert.ifError(err);
+      const ref = crypto.createHash('sha256')
+        .update(text).update(data).update(text, 'latin1');
+      assert.strictEqual(hash.digest('hex'), ref.digest('hex'));
+    }));
+  })), hash);
+
+  // The hash can not be touched until the update is done.
+  assert.throws(() => hash.update(text), /^Error: Update in progress$/);
+  assert.throws(() => hash.update(data, common.fail),
+                /^Error: Update in progress$/);
+  assert.throws(() => hash.digest(), /^Error: Update in progress$/);
+}
+
+{
+  const hmac = crypto.createHmac('sha512', 'key');
+  hmac.update(data, common.mustCall((err) => {
+    assert.ifError(err);
+    assert.strictEqual(hmac.digest('hex'),
+                       expectedHmac('sha512', 'key', data, 'hex'));
+  }));
+  assert.throws(() => hmac.digest(), /^Error: Update in progress$/);
+}
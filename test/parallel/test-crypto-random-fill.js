@@ -0,0 +1,70 @@
+'use strict';
+const common = require('../common');
+
+if (!common.hasCrypto) {
+  common.skip('missing crypto');
+  return;
+}
+const assert = require('assert');
+const crypto = require('crypto');
+
+// randomFillSync() writes into the given range and returns the buffer.
+{
+  const buf = Buffer.alloc(64);
+  assert.strictEqual(crypto.randomFillSync(buf, 16, 32), buf);
+  assert(buf.slice(0, 16).equals(Buffer.alloc(16)));
+  assert(buf.slice(48).equals(Buffer.alloc(16)));
+  assert(!buf.slice(16, 48).equals(Buffer.alloc(32)));
+
+  const u8 = new Uint8Array(4096);
+  crypto.randomFillSync(u8);
+  assert(u8.some((byte) => byte !== 0));
+  assert.strictEqual(crypto.randomFillSync(buf, 64).length, 64);
+}
+
+// randomFill() calls back asynchronously, for pooled and queued requests.
+[16, 64 * 1024].forEach((size) => {
+  let sync = true;
+  const buf = Buffer.alloc(size + 8);
+  crypto.randomFill(buf, 8, common.mustCall((err, result) => {
+    assert.ifError(err);
+    assert.strictEqual(sync, false);
+    assert.strictEqual(result, buf);
+    assert(buf.slice(0, 8).equals(Buffer.alloc(8)));
+    assert(!buf.slice(8).equals(Buffer.alloc(size)));
+  }));
+  crypto.randomBytes(size, common.mustCall((err, result) => {
+    assert.ifError(err);
+    assert.strictEqual(sync, false);
+    assert.strictEqual(result.length, size);
+  }));
+  sync = false;
+});
+
+// Bytes that come out of the pool are never handed out twice.
+setTimeout(common.mustCall(() => {
+  const seen = new Set();
+  for (let i = 0; i < 10000; i++) {
+    const id = crypto.randomBytes(16).toString('hex');
+    assert(!seen.has(id));
+    seen.add(id);
+  }
+}), 100);
+
+// Argument validation.
+[undefined, null, 'buf', [], new Uint16Array(4)].forEach((buf) => {
+  assert.throws(() => crypto.randomFillSync(buf),
+                /^TypeError: "buf" argument must be a Buffer or Uint8Array$/);
+});
+[-1, 1.5, 17, '1'].forEach((offset) => {
+  assert.throws(() => crypto.randomFillSync(Buffer.alloc(16), offset),
+                /^RangeError: "offset" is out of bounds$/);
+});
+[-1, 1.5, 9, '1'].forEach((size) => {
+  assert.throws(() => crypto.randomFillSync(Buffer.alloc(16), 8, size),
+                /^RangeError: "size" is out of bounds$/);
+});
+assert.throws(() => crypto.randomFill(Buffer.alloc(16)),
+              /^TypeError: "callback" argument must be a function$/);
+assert.throws(() => crypto.randomFill(Buffer.alloc(16), 0, 16, 'callback'),
+              /^TypeError: "callback" argument must be a function$/);
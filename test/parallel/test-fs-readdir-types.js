@@ -0,0 +1,89 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+
+const binding = process.binding('fs');
+const constants = fs.constants;
+
+common.refreshTmpDir();
+const dir = common.tmpDir;
+fs.writeFileSync(path.join(dir, 'file'), '');
+fs.mkdirSync(path.join(dir, 'dir'));
+
+const expected = { file: 'isFile', dir: 'isDirectory' };
+if (!common.isWindows) {
+  fs.symlinkSync('file', path.join(dir, 'link'));
+  expected.link = 'isSymbolicLink';
+}
+const names = Object.keys(expected).sort();
+
+function assertDirents(dirents) {
+  assert.deepStrictEqual(dirents.map((dirent) => dirent.name).sort(), names);
+  dirents.forEach(function(dirent) {
+    assert(dirent instanceof fs.Dirent);
+    ['isFile', 'isDirectory', 'isSymbolicLink', 'isFIFO', 'isSocket',
+     'isCharacterDevice', 'isBlockDevice'].forEach(function(method) {
+       assert.strictEqual(dirent[method](),
+                          method === expected[dirent.name],
+                          `${dirent.name}.${method}()`);
+     });
+  });
+}
+
+// Without the option the result is unchanged.
+assert.deepStrictEqual(fs.readdirSync(dir).sort(), names);
+
+assertDirents(fs.readdirSync(dir, { withFileTypes: true }));
+fs.readdir(dir, { withFileTypes: true }, common.mustCall(function(err, res) {
+  assert.ifError(err);
+  assertDirents(res);
+}));
+
+// Buffer names.
+const buffers = fs.readdirSync(dir, {
+  encoding: 'buffer',
+  withFileTypes: true
+});
+buffers.forEach((dirent) => assert(Buffer.isBuffer(dirent.name)));
+assert.deepStrictEqual(buffers.map((d) => d.name.toString()).sort(), names);
+
+fs.readdir(path.join(dir, 'missing'), { withFileTypes: true },
+           common.mustCall(function(err) {
+             assert.strictEqual(err.code, 'ENOENT');
+           }));
+
+// Entries that the file system reports without a type fall back to lstat().
+const readdir = binding.readdir;
+function withoutTypes(result) {
+  result[1] = result[1].map(() => constants.UV_DIRENT_UNKNOWN);
+  return result;
+}
+binding.readdir = function(path, encoding, withFileTypes, req) {
+  if (req) {
+    const oncomplete = req.oncomplete;
+    req.oncomplete = function(err, result) {
+      oncomplete.call(this, err, result && withoutTypes(result));
+    };
+  }
+  const result = readdir.apply(this, arguments);
+  return req ? result : withoutTypes(result);
+};
+
+assertDirents(fs.readdirSync(dir, { withFileTypes: true }));
+assertDirents(fs.readdirSync(Buffer.from(dir),
+                             { encoding: 'buffer', withFileTypes: true })
+  .map((dirent) => new fs.Dirent(dirent.name.toString(), typeOf(dirent))));
+fs.readdir(dir, { withFileTypes: true }, common.mustCall(function(err, res) {
+  assert.ifError(err);
+  assertDirents(res);
+}));
+
+function typeOf(dirent) {
+  if (dirent.isFile()) return constants.UV_DIRENT_FILE;
+  if (dirent.isDirectory()) return constants.UV_DIRENT_DIR;
+  if (dirent.isSymbolicLink()) return constants.UV_DIRENT_LINK;
+  return constants.UV_DIRENT_UNKNOWN;
+}
@@ -0,0 +1,91 @@
+'use strict';
+// fs.readFile() and fs.writeFile() do all of their work in one native
+// request, without going through the individual open/read/write/close
+// bindings.
+
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+
+common.refreshTmpDir();
+const file = path.join(common.tmpDir, 'one-request.txt');
+
+const binding = process.binding('fs');
+['open', 'close', 'fstat', 'read', 'writeBuffer'].forEach(function(name) {
+  binding[name] = common.fail;
+});
+
+const text = 'ünïcödé\n'.repeat(10000);
+
+fs.writeFile(file, text, common.mustCall(function(err) {
+  assert.ifError(err);
+
+  let pending = 3;
+  function append() {
+    if (--pending > 0)
+      return;
+    fs.writeFile(file, 'more', { flag: 'a' }, common.mustCall(function(err) {
+      assert.ifError(err);
+      fs.readFile(file, 'utf8', common.mustCall(function(err, data) {
+        assert.ifError(err);
+        assert.strictEqual(data, text + 'more');
+      }));
+    }));
+  }
+
+  fs.readFile(file, 'utf8', common.mustCall(function(err, data) {
+    assert.ifError(err);
+    assert.strictEqual(data, text);
+    append();
+  }));
+
+  fs.readFile(file, common.mustCall(function(err, data) {
+    assert.ifError(err);
+    assert.deepStrictEqual(data, Buffer.from(text));
+    append();
+  }));
+
+  fs.readFile(file, 'latin1', common.mustCall(function(err, data) {
+    assert.ifError(err);
+    assert.strictEqual(data, Buffer.from(text).toString('latin1'));
+    append();
+  }));
+}));
+
+fs.readFile(path.join(common.tmpDir, 'missing'), common.mustCall(function(err) {
+  assert.strictEqual(err.code, 'ENOENT');
+  assert.strictEqual(err.syscall, 'open');
+  assert.strictEqual(err.path, path.join(common.tmpDir, 'missing'));
+}));
+
+fs.readFile(common.tmpDir, common.mustCall(function(err) {
+  assert.strictEqual(err.code, 'EISDIR');
+  if (!common.isWindows)
+    assert.strictEqual(err.syscall, 'read');
+}));
+
+// An empty path is a path like any other, not a file descriptor.
+fs.readFile('', common.mustCall(function(err) {
+  assert.strictEqual(err.code, 'ENOENT');
+  assert.strictEqual(err.syscall, 'open');
+}));
+
+fs.writeFile('', 'data', common.mustCall(function(err) {
+  assert.strictEqual(err.code, 'ENOENT');
+  assert.strictEqual(err.syscall, 'open');
+}));
+
+// Big files are split over several threadpool jobs, with the same result.
+const big = Buffer.alloc(9 * 1024 * 1024 + 3);
+for (let i = 0; i < big.length; i += 4099)
+  big[i] = i % 251;
+const bigFile = path.join(common.tmpDir, 'big.bin');
+fs.writeFile(bigFile, big, common.mustCall(function(err) {
+  assert.ifError(err);
+  assert.strictEqual(fs.statSync(bigFile).size, big.length);
+  fs.readFile(bigFile, common.mustCall(function(err, data) {
+    assert.ifError(err);
+    assert(data.equals(big));
+  }));
+}));
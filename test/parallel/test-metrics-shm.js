@@ -0,0 +1,154 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const net = require('net');
+const path = require('path');
+const spawnSync = require('child_process').spawnSync;
+
+if (common.isWindows) {
+  common.skip('--metrics-shm is not supported on Windows');
+  return;
+}
+
+const kHeaderSize = 64;
+const kNetBytesSent = 0;
+const kNetBytesRecv = 1;
+const kLoopIterations = 5;
+const kGcCount = 8;
+
+function readCounter(buf, index) {
+  const offset = kHeaderSize + index * 8;
+  return buf.readUInt32LE(offset) + buf.readUInt32LE(offset + 4) * 0x100000000;
+}
+
+function runChild(mode) {
+  const child = spawnSync(process.execPath, [
+    '--expose-gc',
+    `--metrics-shm=${path.join(common.tmpDir, 'metrics-%p')}`,
+    __filename,
+    mode
+  ], { encoding: 'utf8' });
+  assert.strictEqual(child.stderr, '');
+  assert.strictEqual(child.status, 0);
+  // The file is removed when the process exits.
+  assert(!fs.existsSync(path.join(common.tmpDir, `metrics-${child.pid}`)));
+}
+
+if (process.argv[2] === 'tls-child') {
+  const tls = require('tls');
+  const file = path.join(common.tmpDir, `metrics-${process.pid}`);
+  const payload = Buffer.alloc(64 * 1024, 'x');
+  let closed = 0;
+
+  // TLS writes go out through the TCP stream underneath, they are counted
+  // there and only there.  All of the traffic stays within this process, so
+  // what was sent must add up to what was received.
+  function onclose() {
+    if (++closed < 2)
+      return;
+    server.close();
+    const buf = fs.readFileSync(file);
+    assert(readCounter(buf, kNetBytesSent) > payload.length);
+    assert.strictEqual(readCounter(buf, kNetBytesSent),
+                       readCounter(buf, kNetBytesRecv));
+  }
+
+  const server = tls.createServer({
+    key: fs.readFileSync(path.join(common.fixturesDir, 'agent.key')),
+    cert: fs.readFileSync(path.join(common.fixturesDir, 'agent.crt'))
+  }, common.mustCall((socket) => {
+    socket.end(payload);
+    socket.on('close', common.mustCall(onclose));
+  }));
+  server.listen(0, common.mustCall(() => {
+    const client = tls.connect({
+      port: server.address().port,
+      rejectUnauthorized: false
+    });
+    let received = 0;
+    client.on('data', (chunk) => received += chunk.length);
+    client.on('end', common.mustCall(() => {
+      assert.strictEqual(received, payload.length);
+      client.end();
+    }));
+    client.on('close', common.mustCall(onclose));
+  }));
+  return;
+}
+
+if (process.argv[2] === 'child') {
+  const file = path.join(common.tmpDir, `metrics-${process.pid}`);
+  const payload = Buffer.alloc(1024, 'x');
+
+  const server = net.createServer((socket) => socket.pipe(socket));
+  server.listen(0, common.mustCall(() => {
+    const client = net.connect(server.address().port);
+    let received = 0;
+    client.on('data', (chunk) => {
+      received += chunk.length;
+      if (received === payload.length)
+        client.end();
+    });
+    client.on('close', common.mustCall(() => {
+      server.close();
+      global.gc();
+
+      const buf = fs.readFileSync(file);
+      assert.strictEqual(buf.toString('latin1', 0, 8), 'NODEMTRC');
+      assert.strictEqual(buf.readUInt32LE(8), 1);
+      assert.strictEqual(buf.readUInt32LE(12), kHeaderSize);
+      const count = buf.readUInt32LE(16);
+      assert.strictEqual(buf.length, kHeaderSize + count * 8);
+      assert.strictEqual(buf.readUInt32LE(24), process.pid);
+
+      // Both ends of the connection live in this process.
+      assert(readCounter(buf, kNetBytesSent) >= 2 * payload.length);
+      assert(readCounter(buf, kNetBytesRecv) >= 2 * payload.length);
+      assert(readCounter(buf, kLoopIterations) > 0);
+      assert(readCounter(buf, kGcCount) > 0);
+    }));
+    client.write(payload);
+  }));
+  return;
+}
+
+common.refreshTmpDir();
+
+runChild('child');
+if (common.hasCrypto)
+  runChild('tls-child');
+
+// A path that cannot be created is reported as a bad option.
+const bad = spawnSync(process.execPath, [
+  `--metrics-shm=${path.join(common.tmpDir, 'missing', 'metrics')}`,
+  '-e', '0'
+], { encoding: 'utf8' });
+assert.strictEqual(bad.status, 9);
+assert(/cannot create metrics file/.test(bad.stderr));
+
+// A symlink planted at the path is neither followed nor removed.
+const target = path.join(common.tmpDir, 'target');
+const link = path.join(common.tmpDir, 'link');
+fs.writeFileSync(target, 'untouched');
+fs.symlinkSync(target, link);
+const linked = spawnSync(process.execPath, [
+  `--metrics-shm=${link}`,
+  '-e', '0'
+], { encoding: 'utf8' });
+assert.strictEqual(linked.status, 9);
+assert(/cannot create metrics file/.test(linked.stderr));
+assert.strictEqual(fs.readFileSync(target, 'utf8'), 'untouched');
+assert(fs.lstatSync(link).isSymbolicLink());
+
+// A stale file of our own, e.g. from a process that was killed, is replaced.
+const stale = path.join(common.tmpDir, 'stale');
+fs.writeFileSync(stale, 'stale');
+const replaced = spawnSync(process.execPath, [
+  `--metrics-shm=${stale}`,
+  '-e', `console.log(require('fs').readFileSync(${JSON.stringify(stale)})
+                       .toString('latin1', 0, 8))`
+], { encoding: 'utf8' });
+assert.strictEqual(replaced.stderr, '');
+assert.strictEqual(replaced.stdout, 'NODEMTRC\n');
+assert(!fs.existsSync(stale));
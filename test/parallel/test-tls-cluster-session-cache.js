@@ -0,0 +1,112 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+
+if (!common.hasCrypto) {
+  common.skip('missing crypto');
+  return;
+}
+if (common.isWindows) {
+  common.skip('the shared TLS session cache is not supported on Windows');
+  return;
+}
+const tls = require('tls');
+
+const cluster = require('cluster');
+const fs = require('fs');
+const join = require('path').join;
+const SSL_OP_NO_TICKET = require('crypto').constants.SSL_OP_NO_TICKET;
+
+// Sessions that one worker established can be resumed by another worker,
+// without tickets and without any 'newSession'/'resumeSession' listeners.
+// They are not resumed by a server that asks for client certificates, nor
+// by one that serves a different certificate and key.
+
+if (cluster.isMaster) {
+  cluster.setupMaster({ tlsSessionCache: 64 });
+
+  const ports = [];
+  const workers = [cluster.fork(), cluster.fork()];
+
+  // The cache file is unlinked as soon as it has been created.
+  const dir = fs.existsSync('/dev/shm') ? '/dev/shm' : require('os').tmpdir();
+  const prefix = `node-tls-sessions-${process.pid}-`;
+  assert(!fs.readdirSync(dir).some((name) => name.startsWith(prefix)));
+
+  function connect(port, session, cb) {
+    const c = tls.connect(port, {
+      session: session,
+      rejectUnauthorized: false
+    }, common.mustCall(() => {
+      const reused = c.isSessionReused();
+      const next = c.getSession();
+      c.end();
+      cb(reused, next);
+    }));
+  }
+
+  workers.forEach((worker) => {
+    worker.on('message', common.mustCall((message) => {
+      assert.strictEqual(message.env, undefined);
+      ports.push(message);
+      if (ports.length !== workers.length)
+        return;
+
+      connect(ports[0].plain, null, (reused, session) => {
+        assert.strictEqual(reused, false);
+        connect(ports[1].plain, session, (reused) => {
+          assert.strictEqual(reused, true);
+          connect(ports[1].requestCert, session, (reused) => {
+            assert.strictEqual(reused, false);
+            connect(ports[1].otherCert, session, (reused) => {
+              assert.strictEqual(reused, false);
+              connect(ports[0].plain, session, (reused) => {
+                assert.strictEqual(reused, true);
+                workers.forEach((worker) => worker.disconnect());
+              });
+            });
+          });
+        });
+      });
+    }));
+    worker.on('exit', common.mustCall((code) => {
+      assert.strictEqual(code, 0);
+    }));
+  });
+  return;
+}
+
+const options = {
+  key: fs.readFileSync(join(common.fixturesDir, 'agent.key')),
+  cert: fs.readFileSync(join(common.fixturesDir, 'agent.crt')),
+  secureOptions: SSL_OP_NO_TICKET
+};
+const plain = tls.createServer(options, (c) => c.end());
+const requestCert = tls.createServer(Object.assign({
+  requestCert: true,
+  rejectUnauthorized: false
+}, options), (c) => c.end());
+const otherCert = tls.createServer(Object.assign({}, options, {
+  key: fs.readFileSync(join(common.fixturesDir, 'keys/agent2-key.pem')),
+  cert: fs.readFileSync(join(common.fixturesDir, 'keys/agent2-cert.pem'))
+}), (c) => c.end());
+
+plain.listen({ port: 0, exclusive: true }, common.mustCall(() => {
+  requestCert.listen({ port: 0, exclusive: true }, common.mustCall(() => {
+    otherCert.listen({ port: 0, exclusive: true }, common.mustCall(() => {
+      process.send({
+        plain: plain.address().port,
+        requestCert: requestCert.address().port,
+        otherCert: otherCert.address().port,
+        env: process.env.NODE_TLS_SESSION_CACHE
+      });
+    }));
+  }));
+}));
+
+// Exclusive listeners are not tracked by cluster, close them ourselves.
+process.on('disconnect', () => {
+  plain.close();
+  requestCert.close();
+  otherCert.close();
+});
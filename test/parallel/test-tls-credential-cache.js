@@ -0,0 +1,119 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+
+if (!common.hasCrypto) {
+  common.skip('missing crypto');
+  return;
+}
+const tls = require('tls');
+
+const fs = require('fs');
+const join = require('path').join;
+
+// Parsed keys, certificates and CA stores are shared between contexts that
+// are created from the same PEM data.  Sharing must not let one context see
+// the changes of another.
+
+function loadPEM(name) {
+  return fs.readFileSync(join(common.fixturesDir, 'keys', `${name}.pem`));
+}
+
+const passKey = fs.readFileSync(join(common.fixturesDir, 'pass-key.pem'));
+const passCert = fs.readFileSync(join(common.fixturesDir, 'pass-cert.pem'));
+
+// A cached key is only found again with the pass phrase that decrypted it.
+tls.createSecureContext({ key: passKey, cert: passCert,
+                          passphrase: 'passphrase' });
+assert.throws(() => {
+  tls.createSecureContext({ key: passKey, cert: passCert,
+                            passphrase: 'wrong' });
+}, /bad decrypt/);
+assert.throws(() => {
+  tls.createSecureContext({ key: passKey, cert: passCert });
+}, /bad password read/);
+
+// agent4 is signed by ca2 and revoked by ca2-crl.  The server with the CRL
+// is set up in between the two without one, which share their CA store.
+// The stores of the last two servers only differ in their last CA.
+const serverOptions = {
+  key: loadPEM('agent2-key'),
+  cert: loadPEM('agent2-cert'),
+  ca: [loadPEM('ca2-cert')],
+  requestCert: true
+};
+const servers = [
+  { options: serverOptions, authorized: true },
+  { options: Object.assign({ crl: loadPEM('ca2-crl') }, serverOptions),
+    authorized: false },
+  { options: serverOptions, authorized: true },
+  { options: Object.assign({}, serverOptions,
+                           { ca: [loadPEM('ca1-cert'), loadPEM('ca2-cert')] }),
+    authorized: true },
+  { options: Object.assign({}, serverOptions, { ca: [loadPEM('ca1-cert')] }),
+    authorized: false }
+].map((test) => {
+  return tls.createServer(test.options, common.mustCall((socket) => {
+    assert.strictEqual(socket.authorized, test.authorized);
+    socket.end();
+  }));
+});
+
+function connect(i) {
+  if (i === servers.length)
+    return;
+  servers[i].listen(0, common.mustCall(() => {
+    tls.connect(servers[i].address().port, {
+      key: loadPEM('agent4-key'),
+      cert: loadPEM('agent4-cert'),
+      rejectUnauthorized: false
+    }, common.mustCall(function() {
+      this.end();
+      servers[i].close();
+      connect(i + 1);
+    }));
+  }));
+}
+connect(0);
+
+// SNICacheSize.
+assert.throws(() => tls.createServer({ SNICacheSize: -1 }),
+              /^TypeError: SNICacheSize must be a positive number$/);
+
+const sniContexts = {
+  a: tls.createSecureContext({ key: loadPEM('agent1-key'),
+                               cert: loadPEM('agent1-cert') }),
+  b: tls.createSecureContext({ key: loadPEM('agent3-key'),
+                               cert: loadPEM('agent3-cert') })
+};
+let sniCalls = 0;
+const sniServer = tls.createServer({
+  key: loadPEM('agent2-key'),
+  cert: loadPEM('agent2-cert'),
+  SNICacheSize: 1,
+  SNICallback: (servername, cb) => {
+    sniCalls++;
+    cb(null, sniContexts[servername]);
+  }
+}, (socket) => socket.end());
+
+sniServer.listen(0, common.mustCall(() => {
+  // With room for one name: a is cached, b evicts a.
+  const names = ['a', 'a', 'b', 'b', 'a'];
+  const expectedCalls = [1, 1, 2, 2, 3];
+  const expectedCN = ['agent1', 'agent1', 'agent3', 'agent3', 'agent1'];
+
+  (function next(i) {
+    if (i === names.length)
+      return sniServer.close();
+    const c = tls.connect(sniServer.address().port, {
+      servername: names[i],
+      rejectUnauthorized: false
+    }, common.mustCall(() => {
+      assert.strictEqual(c.getPeerCertificate().subject.CN, expectedCN[i]);
+      assert.strictEqual(sniCalls, expectedCalls[i]);
+      c.end();
+      next(i + 1);
+    }));
+  })(0);
+}));
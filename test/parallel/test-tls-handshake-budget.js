@@ -0,0 +1,39 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+
+if (!common.hasCrypto) {
+  common.skip('missing crypto');
+  return;
+}
+const tls = require('tls');
+const fs = require('fs');
+const binding = process.binding('tls_wrap');
+
+// The handshake budget starts over in every event loop iteration. Handshakes
+// that come in one at a time add up to well over the budget but none of them
+// may be deferred.
+const kConnections = 20;
+
+const server = tls.createServer({
+  key: fs.readFileSync(common.fixturesDir + '/keys/agent1-key.pem'),
+  cert: fs.readFileSync(common.fixturesDir + '/keys/agent1-cert.pem')
+}, common.mustCall((socket) => {
+  socket.end('hello');
+}, kConnections));
+
+function connect(remaining) {
+  if (remaining === 0) {
+    assert.strictEqual(binding.getDeferredHandshakeCount(), 0);
+    server.close();
+    return;
+  }
+  const client = tls.connect({
+    port: server.address().port,
+    rejectUnauthorized: false
+  });
+  client.resume();
+  client.on('end', common.mustCall(() => connect(remaining - 1)));
+}
+
+server.listen(0, common.mustCall(() => connect(kConnections)));
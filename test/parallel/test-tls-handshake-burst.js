@@ -0,0 +1,39 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+
+if (!common.hasCrypto) {
+  common.skip('missing crypto');
+  return;
+}
+const tls = require('tls');
+const fs = require('fs');
+
+// A burst of handshakes exceeds the per-iteration handshake budget, so most
+// of them are finished from the handshake queue. All of them must complete.
+const kConnections = 50;
+
+const server = tls.createServer({
+  key: fs.readFileSync(common.fixturesDir + '/keys/agent1-key.pem'),
+  cert: fs.readFileSync(common.fixturesDir + '/keys/agent1-cert.pem')
+}, common.mustCall((socket) => {
+  socket.end('hello');
+}, kConnections));
+
+server.listen(0, common.mustCall(() => {
+  let done = 0;
+  for (let i = 0; i < kConnections; i++) {
+    const client = tls.connect({
+      port: server.address().port,
+      rejectUnauthorized: false
+    });
+    let data = '';
+    client.setEncoding('utf8');
+    client.on('data', (chunk) => data += chunk);
+    client.on('end', common.mustCall(() => {
+      assert.strictEqual(data, 'hello');
+      if (++done === kConnections)
+        server.close();
+    }));
+  }
+}));
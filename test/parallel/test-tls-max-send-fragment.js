@@ -9,14 +9,18 @@ if (!common.hasCrypto) {
 var tls = require('tls');
 
 var fs = require('fs');
+var createRecordProxy = require(common.fixturesDir + '/tls-record-proxy');
 
 var buf = Buffer.allocUnsafe(10000);
 var received = 0;
 var maxChunk = 768;
+// Explicit nonce and tag of AES128-GCM-SHA256.
+var recordOverhead = 24;
 
 var server = tls.createServer({
   key: fs.readFileSync(common.fixturesDir + '/keys/agent1-key.pem'),
-  cert: fs.readFileSync(common.fixturesDir + '/keys/agent1-cert.pem')
+  cert: fs.readFileSync(common.fixturesDir + '/keys/agent1-cert.pem'),
+  ciphers: 'AES128-GCM-SHA256'
 }, function(c) {
   // Lower and upper limits
   assert(!c.setMaxSendFragment(511));
@@ -27,19 +31,31 @@ var server = tls.createServer({
 
   c.end(buf);
 }).listen(0, common.mustCall(function() {
-  var c = tls.connect(this.address().port, {
-    rejectUnauthorized: false
-  }, common.mustCall(function() {
-    c.on('data', function(chunk) {
-      assert(chunk.length <= maxChunk);
-      received += chunk.length;
-    });
+  // The client may get several records in one 'data' event, so look at the
+  // size of the application data records on the wire instead.
+  var records = [];
+  var proxy = createRecordProxy(server.address().port, function(type, length) {
+    if (type === 23)
+      records.push(length - recordOverhead);
+  }).listen(0, common.mustCall(function() {
+    var c = tls.connect(proxy.address().port, {
+      rejectUnauthorized: false
+    }, common.mustCall(function() {
+      c.on('data', function(chunk) {
+        received += chunk.length;
+      });
 
-    // Ensure that we receive 'end' event anyway
-    c.on('end', common.mustCall(function() {
-      c.destroy();
-      server.close();
-      assert.strictEqual(received, buf.length);
+      // Ensure that we receive 'end' event anyway
+      c.on('end', common.mustCall(function() {
+        c.destroy();
+        server.close();
+        proxy.close();
+        assert.strictEqual(received, buf.length);
+        assert(records.length >= Math.ceil(buf.length / maxChunk));
+        records.forEach(function(size) {
+          assert(size <= maxChunk);
+        });
+      }));
     }));
   }));
 }));
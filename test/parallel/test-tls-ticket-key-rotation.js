@@ -0,0 +1,81 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+
+if (!common.hasCrypto) {
+  common.skip('missing crypto');
+  return;
+}
+const tls = require('tls');
+
+const crypto = require('crypto');
+const fs = require('fs');
+const join = require('path').join;
+
+const keys = crypto.randomBytes(48);
+const options = {
+  key: fs.readFileSync(join(common.fixturesDir, 'agent.key')),
+  cert: fs.readFileSync(join(common.fixturesDir, 'agent.crt')),
+  ticketKeys: keys
+};
+
+function createServer(extra) {
+  return tls.createServer(Object.assign({}, options, extra), (c) => c.end());
+}
+
+assert.throws(() => createServer({ ticketKeyRotation: -1 }),
+              /^TypeError: ticketKeyRotation must be a positive integer$/);
+assert.throws(() => createServer({ ticketKeyRotation: 1.5 }),
+              /^TypeError: ticketKeyRotation must be a positive integer$/);
+assert.throws(() => createServer({ ticketKeyRotation: 365 * 24 * 3600 + 1 }),
+              /^RangeError: ticketKeyRotation must be at most 31536000/);
+assert.throws(() => createServer({ ticketKeyRotation: 60,
+                                   ticketKeyPrevious: 16 }),
+              /^RangeError: ticketKeyPrevious must be an integer/);
+
+// Two servers that share ticket keys and the rotation policy accept each
+// other's tickets.  A server that uses the keys as they are does not.
+const servers = [
+  createServer({ ticketKeyRotation: 1, ticketKeyPrevious: 1 }),
+  createServer({ ticketKeyRotation: 1, ticketKeyPrevious: 1 }),
+  createServer()
+];
+
+// The keys that were passed in remain what the server reports.
+assert(servers[0].getTicketKeys().equals(keys));
+
+function connect(server, session, cb) {
+  const c = tls.connect(server.address().port, {
+    session: session,
+    rejectUnauthorized: false
+  }, common.mustCall(() => {
+    const reused = c.isSessionReused();
+    c.end();
+    cb(reused, c.getSession());
+  }));
+}
+
+let listening = 0;
+servers.forEach((server) => server.listen(0, common.mustCall(() => {
+  if (++listening === servers.length)
+    test();
+})));
+
+function test() {
+  connect(servers[0], null, (reused, session) => {
+    assert.strictEqual(reused, false);
+    connect(servers[1], session, (reused) => {
+      assert.strictEqual(reused, true);
+      connect(servers[2], session, (reused) => {
+        assert.strictEqual(reused, false);
+        // Two rotations later the key that encrypted the ticket is gone.
+        setTimeout(() => {
+          connect(servers[0], session, (reused) => {
+            assert.strictEqual(reused, false);
+            servers.forEach((server) => server.close());
+          });
+        }, 2100);
+      });
+    });
+  });
+}
@@ -0,0 +1,49 @@
+'use strict';
+const common = require('../common');
+
+if (!common.hasCrypto) {
+  common.skip('missing crypto');
+  return;
+}
+
+// The BIOs of a TLS connection should hand their buffers back once they are
+// drained, so that idle connections don't hold on to any buffer memory.
+
+const assert = require('assert');
+const tls = require('tls');
+const fs = require('fs');
+
+const options = {
+  key: fs.readFileSync(common.fixturesDir + '/keys/agent1-key.pem'),
+  cert: fs.readFileSync(common.fixturesDir + '/keys/agent1-cert.pem')
+};
+
+const server = tls.createServer(options, common.mustCall(function(socket) {
+  socket.pipe(socket);
+}));
+
+server.listen(0, common.mustCall(function() {
+  const client = tls.connect({
+    port: this.address().port,
+    rejectUnauthorized: false
+  }, common.mustCall(function() {
+    const payload = Buffer.alloc(64 * 1024, 'x');
+    let received = 0;
+
+    client.write(payload);
+    // The encrypted records are kept until the socket write completes.
+    assert(client._handle.getMemoryUsage() > 0);
+
+    client.on('data', function(chunk) {
+      received += chunk.length;
+      if (received < payload.length)
+        return;
+      assert.strictEqual(received, payload.length);
+      setImmediate(common.mustCall(function() {
+        assert.strictEqual(client._handle.getMemoryUsage(), 0);
+        client.end();
+        server.close();
+      }));
+    });
+  }));
+}));
@@ -0,0 +1,59 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+
+if (!common.hasCrypto) {
+  common.skip('missing crypto');
+  return;
+}
+const tls = require('tls');
+const fs = require('fs');
+const createRecordProxy = require(common.fixturesDir + '/tls-record-proxy');
+
+// Small buffers that are written together must end up in one TLS record,
+// and a fresh connection uses records that fit in a TCP segment.
+const kSmallRecordSize = 1300;
+// Explicit nonce and tag of AES128-GCM-SHA256.
+const kRecordOverhead = 24;
+
+const small = [];
+for (let i = 0; i < 100; i++)
+  small.push(Buffer.alloc(10, i));
+const large = Buffer.alloc(64 * 1024);
+for (let i = 0; i < large.length; i++)
+  large[i] = i % 253;
+const expected = Buffer.concat(small.concat(large));
+
+const server = tls.createServer({
+  key: fs.readFileSync(common.fixturesDir + '/keys/agent1-key.pem'),
+  cert: fs.readFileSync(common.fixturesDir + '/keys/agent1-cert.pem'),
+  ciphers: 'AES128-GCM-SHA256'
+}, common.mustCall(function(c) {
+  c.cork();
+  small.forEach((buf) => c.write(buf));
+  c.uncork();
+  c.end(large);
+})).listen(0, common.mustCall(function() {
+  // Sizes of the application data records the server sends.
+  const records = [];
+  const proxy = createRecordProxy(server.address().port, (type, length) => {
+    if (type === 23)
+      records.push(length - kRecordOverhead);
+  }).listen(0, common.mustCall(() => {
+    const c = tls.connect(proxy.address().port, {
+      rejectUnauthorized: false
+    }, common.mustCall(function() {
+      const chunks = [];
+      c.on('data', (chunk) => chunks.push(chunk));
+
+      c.on('end', common.mustCall(function() {
+        server.close();
+        proxy.close();
+        assert.deepStrictEqual(Buffer.concat(chunks), expected);
+        assert.strictEqual(records[0], 100 * 10);
+        records.forEach((size) => assert(size <= kSmallRecordSize));
+        assert.strictEqual(records.reduce((a, b) => a + b), expected.length);
+      }));
+    }));
+  }));
+}));
@@ -0,0 +1,100 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const zlib = require('zlib');
+
+if (!zlib.brotliCompress) {
+  common.skip('node compiled without brotli');
+  return;
+}
+
+const constants = zlib.constants;
+const input = fs.readFileSync(__filename);
+
+// One-shot helpers, with and without parameters.
+const compressed = zlib.brotliCompressSync(input);
+assert(compressed.length < input.length);
+assert.deepStrictEqual(zlib.brotliDecompressSync(compressed), input);
+
+const fast = zlib.brotliCompressSync(input, {
+  quality: constants.BROTLI_MIN_QUALITY,
+  lgwin: constants.BROTLI_MIN_WINDOW_BITS,
+  mode: constants.BROTLI_MODE_TEXT
+});
+assert(fast.length > compressed.length);
+assert.deepStrictEqual(zlib.brotliDecompressSync(fast), input);
+
+zlib.brotliCompress(input, common.mustCall(function(err, result) {
+  assert.ifError(err);
+  assert.deepStrictEqual(result, compressed);
+  zlib.brotliDecompress(result, common.mustCall(function(err, result) {
+    assert.ifError(err);
+    assert.deepStrictEqual(result, input);
+  }));
+}));
+
+assert.throws(() => zlib.brotliCompressSync(input, { quality: 12 }),
+              /^Error: Invalid quality: 12$/);
+assert.throws(() => zlib.createBrotliCompress({ lgwin: 25 }),
+              /^Error: Invalid lgwin: 25$/);
+assert.throws(() => zlib.createBrotliCompress({ flush: constants.Z_FINISH }),
+              /^Error: Invalid flush flag: 4$/);
+
+// Streams: flush() with the default BROTLI_OPERATION_FLUSH makes everything
+// written so far decodable.
+const compress = zlib.createBrotliCompress();
+const decompress = zlib.createBrotliDecompress();
+const first = input.slice(0, 1000);
+const chunks = [];
+let flushed = false;
+compress.pipe(decompress);
+decompress.on('data', function(chunk) {
+  chunks.push(chunk);
+  if (!flushed && Buffer.concat(chunks).length === first.length) {
+    flushed = true;
+    assert.deepStrictEqual(Buffer.concat(chunks), first);
+    compress.end(input.slice(first.length));
+  }
+});
+decompress.on('end', common.mustCall(function() {
+  assert(flushed);
+  assert.deepStrictEqual(Buffer.concat(chunks), input);
+}));
+compress.write(first);
+compress.flush(common.mustCall(function() {}));
+
+// Truncated and corrupt input.
+const truncated = compressed.slice(0, compressed.length - 16);
+assert.throws(() => zlib.brotliDecompressSync(truncated),
+              /^Error: unexpected end of file$/);
+zlib.brotliDecompress(truncated, common.mustCall(function(err, result) {
+  assert(err instanceof Error);
+  assert.strictEqual(err.code, 'Z_BUF_ERROR');
+  assert.strictEqual(result, undefined);
+}));
+
+zlib.createBrotliDecompress()
+  .on('error', common.mustCall(function(err) {
+    assert.strictEqual(err.message, 'Decompression failed');
+    assert(/^ERR_BROTLI_/.test(err.code), err.code);
+  }))
+  .end(Buffer.from('this is not brotli data, not at all'));
+
+// Data after the end of the stream is an error, as it is for gzip.
+const junk = Buffer.concat([compressed, Buffer.from('garbage')]);
+assert.throws(() => zlib.brotliDecompressSync(junk),
+              /^Error: Junk found after end of compressed data$/);
+zlib.brotliDecompress(junk, common.mustCall(function(err, result) {
+  assert(err instanceof Error);
+  assert.strictEqual(err.code, 'Z_DATA_ERROR');
+  assert.strictEqual(result, undefined);
+}));
+
+const late = zlib.createBrotliDecompress();
+late.on('error', common.mustCall(function(err) {
+  assert.strictEqual(err.code, 'Z_DATA_ERROR');
+}));
+late.resume();
+late.write(compressed);
+late.end(Buffer.from('garbage'));
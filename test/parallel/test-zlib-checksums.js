@@ -0,0 +1,58 @@
+'use strict';
+// The CRC-32 in the gzip trailer and the Adler-32 in the zlib trailer must
+// match plain JS implementations, whatever code path zlib picks for the
+// input size.
+
+require('../common');
+const assert = require('assert');
+const zlib = require('zlib');
+
+const crcTable = new Int32Array(256);
+for (let n = 0; n < 256; n++) {
+  let c = n;
+  for (let k = 0; k < 8; k++)
+    c = c & 1 ? 0xedb88320 ^ (c >>> 1) : c >>> 1;
+  crcTable[n] = c;
+}
+
+function crc32(buf) {
+  let crc = -1;
+  for (let i = 0; i < buf.length; i++)
+    crc = crcTable[(crc ^ buf[i]) & 0xff] ^ (crc >>> 8);
+  return (crc ^ -1) >>> 0;
+}
+
+function adler32(buf) {
+  let a = 1;
+  let b = 0;
+  for (let i = 0; i < buf.length; i++) {
+    a = (a + buf[i]) % 65521;
+    b = (b + a) % 65521;
+  }
+  return ((b << 16) | a) >>> 0;
+}
+
+const data = Buffer.alloc(70000);
+for (let i = 0; i < data.length; i++)
+  data[i] = (i * 2654435761) >>> 24;
+// Long runs of 0xff push the Adler-32 sums closest to overflowing.
+data.fill(0xff, 20000, 40000);
+
+const lengths = [0, 1, 15, 16, 17, 63, 64, 65, 127, 128, 129, 1000, 5551, 5552,
+                 5553, 11104, 20000, 39999, 40000, 40001, 65536, 70000];
+
+lengths.forEach((len) => {
+  [0, 1, 7, 20000].forEach((offset) => {
+    const input = data.slice(offset, offset + len);
+
+    const gzipped = zlib.gzipSync(input, { level: 1 });
+    assert.strictEqual(gzipped.readUInt32LE(gzipped.length - 8),
+                       crc32(input));
+    assert.deepStrictEqual(zlib.gunzipSync(gzipped), input);
+
+    const deflated = zlib.deflateSync(input, { level: 1 });
+    assert.strictEqual(deflated.readUInt32BE(deflated.length - 4),
+                       adler32(input));
+    assert.deepStrictEqual(zlib.inflateSync(deflated), input);
+  });
+});
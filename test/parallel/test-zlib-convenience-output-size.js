@@ -0,0 +1,55 @@
+'use strict';
+// The convenience methods produce their output in one buffer, which has to
+// grow for inputs that inflate to much more than their own size.
+
+const common = require('../common');
+const assert = require('assert');
+const zlib = require('zlib');
+
+const zeroes = Buffer.alloc(4 * 1024 * 1024);
+const random = Buffer.alloc(64 * 1024);
+for (let i = 0; i < random.length; i++)
+  random[i] = (i * 7919) % 251;
+
+[
+  ['gzip', 'gunzip'],
+  ['gzip', 'unzip'],
+  ['deflate', 'inflate'],
+  ['deflate', 'unzip'],
+  ['deflateRaw', 'inflateRaw'],
+].forEach(function(method) {
+  const compress = zlib[method[0]];
+  const decompress = zlib[method[1]];
+  const compressSync = zlib[method[0] + 'Sync'];
+  const decompressSync = zlib[method[1] + 'Sync'];
+
+  [Buffer.alloc(0), zeroes, random].forEach(function(input) {
+    const compressed = compressSync(input);
+    assert(compressed.length < input.length + 64);
+    assert.deepStrictEqual(decompressSync(compressed), input);
+
+    compress(input, common.mustCall(function(err, result) {
+      assert.ifError(err);
+      assert.deepStrictEqual(result, compressed);
+      decompress(result, common.mustCall(function(err, result) {
+        assert.ifError(err);
+        assert.deepStrictEqual(result, input);
+      }));
+    }));
+  });
+});
+
+// Truncated input is an error unless another finishFlush is asked for.
+const gzipped = zlib.gzipSync(random);
+const truncated = gzipped.slice(0, gzipped.length - 16);
+assert.throws(() => zlib.gunzipSync(truncated), /unexpected end of file/);
+const partial = zlib.gunzipSync(truncated,
+                                { finishFlush: zlib.constants.Z_SYNC_FLUSH });
+assert(partial.length > 0);
+assert.deepStrictEqual(partial, random.slice(0, partial.length));
+
+zlib.gunzip(truncated, common.mustCall(function(err, result) {
+  assert(err instanceof Error);
+  assert.strictEqual(err.code, 'Z_BUF_ERROR');
+  assert.strictEqual(result, undefined);
+}));
@@ -0,0 +1,45 @@
+'use strict';
+const common = require('../common');
+
+// zlib streams are recycled after close. A stream must not carry anything
+// over into the next one that is handed the same context.
+
+const assert = require('assert');
+const zlib = require('zlib');
+
+const input = Buffer.from('hello world, hello zlib. '.repeat(1000));
+const dictionary = Buffer.from('hello world');
+const expected = zlib.deflateSync(input);
+
+for (let i = 0; i < 10; i++) {
+  assert.deepStrictEqual(zlib.deflateSync(input), expected);
+  assert.deepStrictEqual(zlib.inflateSync(expected), input);
+}
+
+// A dictionary doesn't stick.
+const withDictionary = zlib.deflateSync(input, { dictionary });
+assert.notDeepStrictEqual(withDictionary, expected);
+assert.deepStrictEqual(zlib.inflateSync(withDictionary, { dictionary }),
+                       input);
+assert.deepStrictEqual(zlib.deflateSync(input), expected);
+assert.deepStrictEqual(zlib.inflateSync(expected), input);
+
+// Neither does a failed inflate.
+assert.throws(() => zlib.inflateSync(Buffer.from('not deflate data')),
+              /incorrect header check/);
+assert.deepStrictEqual(zlib.inflateSync(expected), input);
+
+// unzip keeps detecting the format.
+assert.deepStrictEqual(zlib.unzipSync(zlib.gzipSync(input)), input);
+assert.deepStrictEqual(zlib.unzipSync(expected), input);
+assert.deepStrictEqual(zlib.unzipSync(zlib.gzipSync(input)), input);
+
+// Nor do parameters changed with params().
+const deflater = zlib.createDeflate();
+deflater.params(0, zlib.constants.Z_DEFAULT_STRATEGY, common.mustCall(() => {
+  deflater.end(input);
+  deflater.resume();
+  deflater.on('close', common.mustCall(() => {
+    assert.deepStrictEqual(zlib.deflateSync(input), expected);
+  }));
+}));